@@ -237,7 +237,8 @@ PYBIND11_MODULE(vespa_ann_benchmark, m) {
         .value("InnerProduct", DistanceMetric::InnerProduct);
 
     py::class_<HnswIndexParams>(m, "HnswIndexParams")
-        .def(py::init<uint32_t, uint32_t, DistanceMetric, bool>());
+        .def(py::init<uint32_t, uint32_t, DistanceMetric, bool>())
+        .def(py::init<uint32_t, uint32_t, DistanceMetric, bool, bool>());
 
     py::class_<HnswIndex>(m, "HnswIndex")
         .def(py::init<uint32_t, const HnswIndexParams&, bool>())
@@ -3,6 +3,7 @@
 #include "dense_dot_product_function.h"
 #include <vespa/eval/eval/operation.h>
 #include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <cblas.h>
 
 namespace vespalib::eval {
@@ -12,6 +13,8 @@ using namespace operation;
 
 namespace {
 
+static const auto &hw = hwaccelrated::IAccelrated::getAccelerator();
+
 template <typename LCT, typename RCT>
 void my_dot_product_op(InterpretedFunction::State &state, uint64_t) {
     auto lhs_cells = state.peek(1).cells().typify<LCT>();
@@ -39,6 +42,20 @@ void my_cblas_float_dot_product_op(InterpretedFunction::State &state, uint64_t)
     state.pop_pop_push(state.stash.create<DoubleValue>(result));
 }
 
+void my_hw_bfloat16_dot_product_op(InterpretedFunction::State &state, uint64_t) {
+    auto lhs_cells = state.peek(1).cells().typify<BFloat16>();
+    auto rhs_cells = state.peek(0).cells().typify<BFloat16>();
+    double result = hw.dotProduct(lhs_cells.cbegin(), rhs_cells.cbegin(), lhs_cells.size());
+    state.pop_pop_push(state.stash.create<DoubleValue>(result));
+}
+
+void my_hw_int8_dot_product_op(InterpretedFunction::State &state, uint64_t) {
+    auto lhs_cells = state.peek(1).cells().typify<Int8Float>();
+    auto rhs_cells = state.peek(0).cells().typify<Int8Float>();
+    double result = hw.dotProduct((const int8_t *)lhs_cells.cbegin(), (const int8_t *)rhs_cells.cbegin(), lhs_cells.size());
+    state.pop_pop_push(state.stash.create<DoubleValue>(result));
+}
+
 struct MyDotProductOp {
     template <typename LCT, typename RCT>
     static auto invoke() { return my_dot_product_op<LCT,RCT>; }
@@ -52,6 +69,12 @@ InterpretedFunction::op_function my_select(CellType lct, CellType rct) {
         if (lct == CellType::FLOAT) {
             return my_cblas_float_dot_product_op;
         }
+        if (lct == CellType::BFLOAT16) {
+            return my_hw_bfloat16_dot_product_op;
+        }
+        if (lct == CellType::INT8) {
+            return my_hw_int8_dot_product_op;
+        }
     }
     using MyTypify = TypifyCellType;
     return typify_invoke<2,MyTypify,MyDotProductOp>(lct, rct);
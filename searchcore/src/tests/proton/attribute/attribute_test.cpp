@@ -57,6 +57,7 @@
 #include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/vespalib/util/sequencedtaskexecutorobserver.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("attribute_test");
@@ -789,6 +790,43 @@ TEST_F(AttributeWriterTest, spreads_write_over_3_write_contexts)
     putAttributes(*this, {4, 5, 6});
 }
 
+TEST_F(AttributeWriterTest, puts_are_applied_in_batches)
+{
+    EmptyDocBuilder edb([](auto& header) { header.addField("a1", DataType::T_INT); });
+    auto a1 = addAttribute("a1");
+    _aw = std::make_unique<AttributeWriter>(_mgr, 3);
+    std::vector<std::unique_ptr<Document>> docs;
+    for (uint32_t lid = 1; lid <= 5; ++lid) {
+        docs.emplace_back(edb.make_document(vespalib::make_string("id:ns:searchdocument::%u", lid)));
+        docs.back()->setValue("a1", IntFieldValue(10 * lid));
+    }
+    _aw->put(1, *docs[0], 1, emptyCallback);
+    _aw->put(2, *docs[1], 2, emptyCallback);
+    EXPECT_EQ(1u, a1->getNumDocs());
+    EXPECT_EQ((std::vector<uint32_t>{}), _attributeFieldWriter->getExecuteHistory());
+    _aw->put(3, *docs[2], 3, emptyCallback);
+    EXPECT_EQ(4u, a1->getNumDocs());
+    EXPECT_EQ((std::vector<uint32_t>{0}), _attributeFieldWriter->getExecuteHistory());
+    // Pending puts and the commit are handled by the same task
+    _aw->put(4, *docs[3], 4, emptyCallback);
+    commit(4);
+    EXPECT_EQ((std::vector<uint32_t>{0, 0}), _attributeFieldWriter->getExecuteHistory());
+    EXPECT_EQ(4u, a1->getStatus().getLastSyncToken());
+    // Pending puts are applied before a remove
+    _aw->put(5, *docs[4], 5, emptyCallback);
+    remove(6, 5);
+    EXPECT_EQ((std::vector<uint32_t>{0, 0, 0, 0, 0}), _attributeFieldWriter->getExecuteHistory());
+    EXPECT_EQ(6u, a1->getStatus().getLastSyncToken());
+    attribute::IntegerContent ibuf;
+    for (uint32_t lid = 1; lid <= 4; ++lid) {
+        ibuf.fill(*a1, lid);
+        EXPECT_EQ(1u, ibuf.size());
+        EXPECT_EQ(10 * lid, ibuf[0]);
+    }
+    ibuf.fill(*a1, 5);
+    EXPECT_TRUE(search::attribute::isUndefined<int32_t>(ibuf[0]));
+}
+
 struct MockPrepareResult : public PrepareResult {
     uint32_t docid;
     const Value& tensor;
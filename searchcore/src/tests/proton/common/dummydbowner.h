@@ -22,6 +22,7 @@ struct DummyDBOwner : IDocumentDBOwner {
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override {
         return _registry;
     }
+    std::shared_ptr<search::docstore::ChunkCache> getChunkCache() const override { return {}; }
 };
 
 } // namespace proton
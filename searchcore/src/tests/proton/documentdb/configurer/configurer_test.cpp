@@ -178,7 +178,7 @@ Fixture::Fixture()
     std::filesystem::create_directory(std::filesystem::path(BASE_DIR));
     initViewSet(_views);
     _configurer = std::make_unique<Configurer>(_views._summaryMgr, _views.searchView, _views.feedView, _queryLimiter,
-                                               _constantValueRepo, _clock.clock(), "test", 0);
+                                               _constantValueRepo, _clock.clock(), "test", 0, {});
 }
 Fixture::~Fixture() = default;
 
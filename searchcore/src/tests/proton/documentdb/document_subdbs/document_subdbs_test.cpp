@@ -90,6 +90,8 @@ struct MySubDBOwner : public IDocumentSubDBOwner
     document::BucketSpace getBucketSpace() const override { return makeBucketSpace(); }
     vespalib::string getName() const override { return "owner"; }
     uint32_t getDistributionKey() const override { return -1; }
+    std::shared_ptr<search::docstore::ChunkCache> getChunkCache() const override { return {}; }
+    std::shared_ptr<proton::matching::FilterCache> getFilterCache() const override { return {}; }
 };
 
 struct MySyncProxy : public SyncProxy
@@ -1102,6 +1102,9 @@ void requireThatUpdateOnlyUpdatesAttributeAndNotDocumentStore(Fixture &f,
 
     EXPECT_EQUAL(1u, f.msa._store._lastSyncToken); // document store not updated
     assertAttributeUpdate(2u, DocumentId("id:ns:searchdocument::1"), 1, f.maw);
+    auto stats = f.pc.getParams()._updateCounters->get_stats();
+    EXPECT_EQUAL(1u, stats.in_memory);
+    EXPECT_EQUAL(0u, stats.document_store);
 }
 
 template <typename Fixture>
@@ -1112,6 +1115,9 @@ void requireThatUpdateUpdatesAttributeAndDocumentStore(Fixture &f,
 
     EXPECT_EQUAL(2u, f.msa._store._lastSyncToken); // document store updated
     assertAttributeUpdate(2u, DocumentId("id:ns:searchdocument::1"), 1, f.maw);
+    auto stats = f.pc.getParams()._updateCounters->get_stats();
+    EXPECT_EQUAL(0u, stats.in_memory);
+    EXPECT_EQUAL(1u, stats.document_store);
 }
 
 TEST_F("require that update() to fast-access attribute only updates attribute and not document store",
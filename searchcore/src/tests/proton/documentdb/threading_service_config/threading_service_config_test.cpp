@@ -45,6 +45,16 @@ TEST_F("require that negative task limit makes it soft", Fixture(3000, -700))
     EXPECT_FALSE(tcfg.is_task_limit_hard());
 }
 
+TEST("require that attribute put batch size is at least 1")
+{
+    ProtonConfigBuilder builder;
+    EXPECT_EQUAL(1u, ThreadingServiceConfig::make(builder).attribute_put_batch_size());
+    builder.feeding.attributePutBatchSize = 0;
+    EXPECT_EQUAL(1u, ThreadingServiceConfig::make(builder).attribute_put_batch_size());
+    builder.feeding.attributePutBatchSize = 64;
+    EXPECT_EQUAL(64u, ThreadingServiceConfig::make(builder).attribute_put_batch_size());
+}
+
 namespace {
 
 void assertConfig(uint32_t exp_master_task_limit, uint32_t exp_default_task_limit, const ThreadingServiceConfig& config) {
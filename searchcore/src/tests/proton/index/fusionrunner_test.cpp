@@ -99,7 +99,7 @@ Test::Test()
       _fusion_spec(),
       _fileHeaderContext(),
       _service(1),
-      _ops(_fileHeaderContext,TuneFileIndexManager(), 0, _service.write())
+      _ops(_fileHeaderContext,TuneFileIndexManager(), 0, 1, 1, _service.write())
 { }
 Test::~Test() = default;
 
@@ -287,4 +287,81 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work stealing scheduler starts by claiming chunks of its own part") {
+    WorkStealingDocidRangeScheduler scheduler(2, 4, 41);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 40u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 5)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(21, 25)));
+    EXPECT_EQUAL(scheduler.total_size(0), 4u);
+    EXPECT_EQUAL(scheduler.total_size(1), 4u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 32u);
+    EXPECT_EQUAL(scheduler.steal_count(0), 0u);
+    EXPECT_EQUAL(scheduler.stolen_size(0), 0u);
+}
+
+TEST("require that the work stealing scheduler steals the back half of the largest remaining part") {
+    WorkStealingDocidRangeScheduler scheduler(3, 100, 31);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 11)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 21)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(26, 31)));
+    EXPECT_EQUAL(scheduler.steal_count(0), 1u);
+    EXPECT_EQUAL(scheduler.stolen_size(0), 5u);
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(21, 26)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 15u);
+    EXPECT_EQUAL(scheduler.total_size(1), 10u);
+    EXPECT_EQUAL(scheduler.total_size(2), 5u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work stealing scheduler protects against documents underflow") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 0);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 0u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST_MT_FFF("require that the work stealing scheduler assigns each docid exactly once",
+            8, WorkStealingDocidRangeScheduler(num_threads, 1, 100001), std::vector<std::atomic<uint32_t>>(100001),
+            TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f2[docid].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        size_t total = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            total += f1.total_size(i);
+        }
+        EXPECT_EQUAL(total, 100000u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        EXPECT_EQUAL(f2[0].load(), 0u);
+        for (uint32_t docid = 1; docid < f2.size(); ++docid) {
+            ASSERT_EQUAL(f2[docid].load(), 1u);
+        }
+    }
+}
+
+TEST_MT_FF("require that the work stealing scheduler handles fewer documents than threads",
+           4, WorkStealingDocidRangeScheduler(num_threads, 1, 3), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        EXPECT_TRUE(docid_range.size() == 1);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
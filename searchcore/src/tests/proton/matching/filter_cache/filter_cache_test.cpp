@@ -0,0 +1,121 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/filter_cache.h>
+#include <vespa/searchcore/proton/matching/filter_cache_blueprint.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using proton::matching::FilterCache;
+using proton::matching::FilterCacheBlueprint;
+using search::BitVector;
+using search::fef::MatchData;
+using search::queryeval::Blueprint;
+using search::queryeval::ExecuteInfo;
+using search::queryeval::SimpleBlueprint;
+using search::queryeval::SimpleResult;
+
+constexpr uint32_t docid_limit = 100000;
+
+SimpleResult make_result() {
+    SimpleResult result;
+    for (uint32_t docid = 3; docid < docid_limit; docid += 7) {
+        result.addHit(docid);
+    }
+    return result;
+}
+
+SimpleResult search_blueprint(Blueprint &blueprint) {
+    auto md = MatchData::makeTestInstance(0, 0);
+    blueprint.fetchPostings(ExecuteInfo::create(true, 1.0));
+    auto search = blueprint.createSearch(*md, true);
+    SimpleResult result;
+    result.search(*search, docid_limit);
+    return result;
+}
+
+std::unique_ptr<Blueprint> make_miss(FilterCache &cache, const vespalib::string &key) {
+    auto blueprint = std::make_unique<FilterCacheBlueprint>(cache, key, std::make_unique<SimpleBlueprint>(make_result()));
+    blueprint->setDocIdLimit(docid_limit);
+    return blueprint;
+}
+
+TEST(FilterCacheTest, cache_miss_evaluates_filter_and_inserts_result)
+{
+    FilterCache cache(1000000);
+    EXPECT_FALSE(cache.lookup("my_key"));
+    auto blueprint = make_miss(cache, "my_key");
+    EXPECT_EQ(make_result().getHitCount(), blueprint->getState().estimate().estHits);
+    EXPECT_EQ(make_result(), search_blueprint(*blueprint));
+    auto bits = cache.lookup("my_key");
+    ASSERT_TRUE(bits);
+    EXPECT_EQ(make_result().getHitCount(), bits->countTrueBits());
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.elements);
+}
+
+TEST(FilterCacheTest, cache_hit_searches_cached_result)
+{
+    FilterCache cache(1000000);
+    search_blueprint(*make_miss(cache, "my_key"));
+    auto hits = cache.lookup("my_key");
+    ASSERT_TRUE(hits);
+    FilterCacheBlueprint blueprint(cache, "my_key", std::move(hits));
+    blueprint.setDocIdLimit(docid_limit);
+    EXPECT_TRUE(blueprint.is_cache_hit());
+    EXPECT_EQ(make_result().getHitCount(), blueprint.getState().estimate().estHits);
+    EXPECT_FALSE(blueprint.getState().estimate().empty);
+    EXPECT_EQ(make_result(), search_blueprint(blueprint));
+}
+
+TEST(FilterCacheTest, least_recently_used_results_are_evicted_when_memory_budget_is_exceeded)
+{
+    FilterCache cache(2 * BitVector::getFileBytes(docid_limit) + 1000);
+    search_blueprint(*make_miss(cache, "a"));
+    search_blueprint(*make_miss(cache, "b"));
+    EXPECT_TRUE(cache.lookup("a"));
+    search_blueprint(*make_miss(cache, "c"));
+    EXPECT_TRUE(cache.lookup("a"));
+    EXPECT_FALSE(cache.lookup("b"));
+    EXPECT_TRUE(cache.lookup("c"));
+}
+
+TEST(FilterCacheTest, keys_are_admitted_when_seen_more_than_once)
+{
+    FilterCache cache(1000000);
+    EXPECT_FALSE(cache.admit("a"));
+    EXPECT_FALSE(cache.admit("b"));
+    EXPECT_TRUE(cache.admit("a"));
+    EXPECT_TRUE(cache.admit("a"));
+    EXPECT_TRUE(cache.admit("b"));
+    EXPECT_FALSE(cache.admit("c"));
+}
+
+TEST(FilterCacheTest, least_recently_seen_keys_are_forgotten_when_too_many_keys_are_seen)
+{
+    FilterCache cache(1000000, 2);
+    EXPECT_FALSE(cache.admit("a"));
+    EXPECT_FALSE(cache.admit("b"));
+    EXPECT_TRUE(cache.admit("a"));
+    EXPECT_FALSE(cache.admit("c"));
+    EXPECT_TRUE(cache.admit("a"));
+    EXPECT_FALSE(cache.admit("b"));
+    EXPECT_FALSE(cache.admit("c"));
+}
+
+TEST(FilterCacheTest, capacity_can_be_changed)
+{
+    FilterCache cache(0);
+    EXPECT_EQ(0u, cache.get_capacity_bytes());
+    cache.set_capacity_bytes(1000000);
+    EXPECT_EQ(1000000u, cache.get_capacity_bytes());
+    search_blueprint(*make_miss(cache, "my_key"));
+    EXPECT_TRUE(cache.lookup("my_key"));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
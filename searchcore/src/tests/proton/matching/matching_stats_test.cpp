@@ -261,6 +261,25 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(1000ns, all1.getPartition(1).doomOvertime());
 }
 
+TEST("requireThatStolenWorkIsTrackedPerPartition") {
+    MatchingStats stats;
+    MatchingStats::Partition part;
+    EXPECT_EQUAL(0u, part.rangesStolen());
+    EXPECT_EQUAL(0u, part.docsStolen());
+    part.rangesStolen(2).docsStolen(100);
+    stats.merge_partition(part, 0);
+    stats.merge_partition(MatchingStats::Partition().rangesStolen(1).docsStolen(10), 1);
+    EXPECT_EQUAL(2u, stats.getPartition(0).rangesStolen());
+    EXPECT_EQUAL(100u, stats.getPartition(0).docsStolen());
+    EXPECT_EQUAL(1u, stats.getPartition(1).rangesStolen());
+
+    MatchingStats total;
+    total.add(stats).add(stats);
+    EXPECT_EQUAL(4u, total.getPartition(0).rangesStolen());
+    EXPECT_EQUAL(200u, total.getPartition(0).docsStolen());
+    EXPECT_EQUAL(20u, total.getPartition(1).docsStolen());
+}
+
 TEST("requireThatSoftDoomIsSetAndAdded") {
     MatchingStats stats;
     MatchingStats stats2;
@@ -326,6 +326,24 @@ struct MyWorld {
         searchContext.idx(0).getFake().addResult("my.f1", my_f1_0_term, my_f1_0_result);
     }
 
+    void setup_bm25_pruning() {
+        set_property(indexproperties::rank::FirstPhase::NAME, "bm25(f1)");
+        for (uint32_t i = 0; i < 2; ++i) {
+            searchContext.idx(i).set_field_length_info(search::index::FieldLengthInfo(10.0, NUM_DOCS));
+        }
+        // 'rare' scores above the max score of 'common', so pruning kicks in when enough 'rare' hits are seen
+        FakeResult rare;
+        for (uint32_t docid = 2; docid <= 40; docid += 2) {
+            rare.doc(docid).num_occs(3).field_length(10);
+        }
+        FakeResult common;
+        for (uint32_t docid = 100; docid < 900; docid += 2) {
+            common.doc(docid).num_occs(1 + docid % 4).field_length(1 + docid % 20);
+        }
+        searchContext.idx(0).getFake().addResult("f1", "rare", rare);
+        searchContext.idx(0).getFake().addResult("f1", "common", common);
+    }
+
     void basicResults() {
         searchContext.idx(0).getFake().addResult("f1", "foo", FakeResult().doc(10).doc(20).doc(30));
         searchContext.idx(0).getFake().addResult("f1", "spread", FakeResult()
@@ -351,6 +369,16 @@ struct MyWorld {
         return createRequest(make_simple_stack_dump(field, term));
     }
 
+    static SearchRequest::SP create_or_request(const vespalib::string &field, const std::vector<vespalib::string> &terms)
+    {
+        QueryBuilder<ProtonNodeTypes> builder;
+        builder.addOr(terms.size());
+        for (size_t i = 0; i < terms.size(); ++i) {
+            builder.addStringTerm(terms[i], field, i + 1, search::query::Weight(1));
+        }
+        return createRequest(StackDumpCreator::create(*builder.build()));
+    }
+
     static SearchRequest::SP createSameElementRequest(const vespalib::string &a1_term, const vespalib::string &f1_term)
     {
         return createRequest(make_same_element_stack_dump(a1_term, f1_term));
@@ -376,7 +404,7 @@ struct MyWorld {
     void verify_diversity_filter(const SearchRequest & req, bool expectDiverse) {
         Matcher::SP matcher = createMatcher();
         search::fef::Properties overrides;
-        auto mtf = matcher->create_match_tools_factory(req, searchContext, attributeContext, metaStore, overrides, ttb(), true);
+        auto mtf = matcher->create_match_tools_factory(req, searchContext, attributeContext, metaStore, overrides, ttb(), true, 0);
         auto diversity = mtf->createDiversifier(HeapSize::lookup(config));
         EXPECT_EQUAL(expectDiverse, static_cast<bool>(diversity));
     }
@@ -386,7 +414,7 @@ struct MyWorld {
         SearchRequest::SP request = createSimpleRequest("f1", "spread");
         search::fef::Properties overrides;
         MatchToolsFactory::UP match_tools_factory = matcher->create_match_tools_factory(
-            *request, searchContext, attributeContext, metaStore, overrides, ttb(), true);
+            *request, searchContext, attributeContext, metaStore, overrides, ttb(), true, 0);
         MatchTools::UP match_tools = match_tools_factory->createMatchTools();
         match_tools->setup_first_phase(nullptr);
         return match_tools->match_data().get_termwise_limit();
@@ -591,6 +619,25 @@ TEST("require that ranking is performed (multi-threaded)") {
     }
 }
 
+TEST("require that bm25 pruning keeps all hits needed by the hit collector") {
+    for (size_t threads : {1, 4}) {
+        MyWorld world;
+        world.basicSetup(10, 100);
+        world.setup_bm25_pruning();
+        SearchRequest::SP request = MyWorld::create_or_request("f1", {"rare", "common"});
+        request->maxhits = 50;
+        SearchReply::UP expect = world.performSearch(*request, threads);
+        world.set_property(indexproperties::matching::Bm25Pruning::NAME, "true");
+        SearchReply::UP actual = world.performSearch(*request, threads);
+        ASSERT_EQUAL(50u, expect->hits.size());
+        ASSERT_EQUAL(expect->hits.size(), actual->hits.size());
+        for (size_t i = 0; i < expect->hits.size(); ++i) {
+            EXPECT_EQUAL(expect->hits[i].gid, actual->hits[i].gid);
+            EXPECT_EQUAL(expect->hits[i].metric, actual->hits[i].metric);
+        }
+    }
+}
+
 TEST("require that re-ranking is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -0,0 +1,167 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/seek_statistics.h>
+#include <vespa/searchlib/fef/fieldinfo.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/searchlib/queryeval/field_spec.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/searchlib/queryeval/simplesearch.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using proton::matching::SeekStatistics;
+using search::fef::FieldInfo;
+using search::fef::FieldType;
+using search::fef::MatchData;
+using search::fef::TermFieldMatchDataArray;
+using search::fef::test::IndexEnvironment;
+using search::queryeval::AndBlueprint;
+using search::queryeval::Blueprint;
+using search::queryeval::FieldSpec;
+using search::queryeval::IntermediateBlueprint;
+using search::queryeval::SearchIterator;
+using search::queryeval::SimpleLeafBlueprint;
+using search::queryeval::SimpleResult;
+using search::queryeval::SimpleSearch;
+using CollectionType = FieldInfo::CollectionType;
+
+constexpr uint32_t docid_limit = 10000;
+
+struct MyTerm : SimpleLeafBlueprint {
+    SimpleResult result;
+    MyTerm(const FieldSpec &field, SimpleResult result_in, uint32_t est_hits)
+        : SimpleLeafBlueprint(field),
+          result(std::move(result_in))
+    {
+        setEstimate(HitEstimate(est_hits, (est_hits == 0)));
+    }
+    std::unique_ptr<SearchIterator> createLeafSearch(const TermFieldMatchDataArray &, bool) const override {
+        return std::make_unique<SimpleSearch>(result);
+    }
+};
+
+SimpleResult make_result(uint32_t step) {
+    SimpleResult result;
+    for (uint32_t docid = step; docid < docid_limit; docid += step) {
+        result.addHit(docid);
+    }
+    return result;
+}
+
+struct SeekStatisticsTest : ::testing::Test {
+    IndexEnvironment index_env;
+    SeekStatistics stats;
+    SeekStatisticsTest()
+        : index_env(),
+          stats()
+    {
+        index_env.getFields().push_back(FieldInfo(FieldType::INDEX, CollectionType::SINGLE, "f1", 0));
+        index_env.getFields().push_back(FieldInfo(FieldType::INDEX, CollectionType::SINGLE, "f2", 1));
+        index_env.getFields().push_back(FieldInfo(FieldType::INDEX, CollectionType::SINGLE, "f3", 2));
+    }
+    ~SeekStatisticsTest() override;
+    static std::unique_ptr<Blueprint> make_term(uint32_t field_id, uint32_t step, uint32_t est_hits) {
+        vespalib::string name = vespalib::make_string("f%u", field_id + 1);
+        return std::make_unique<MyTerm>(FieldSpec(name, field_id, field_id), make_result(step), est_hits);
+    }
+    static std::unique_ptr<AndBlueprint> make_and(uint32_t est_hits) {
+        auto root = std::make_unique<AndBlueprint>();
+        root->addChild(make_term(0, 10, est_hits));
+        root->addChild(make_term(1, 10, est_hits));
+        root->addChild(make_term(2, 10, est_hits));
+        root->setDocIdLimit(docid_limit);
+        return root;
+    }
+    vespalib::string key(const IntermediateBlueprint &root, size_t idx) const {
+        return SeekStatistics::make_key(root.getChild(idx), index_env);
+    }
+};
+
+SeekStatisticsTest::~SeekStatisticsTest() = default;
+
+TEST_F(SeekStatisticsTest, every_sample_interval_query_is_sampled)
+{
+    EXPECT_TRUE(stats.should_sample());
+    for (uint32_t i = 1; i < SeekStatistics::SAMPLE_INTERVAL; ++i) {
+        EXPECT_FALSE(stats.should_sample());
+    }
+    EXPECT_TRUE(stats.should_sample());
+}
+
+TEST_F(SeekStatisticsTest, samples_are_combined_with_exponential_moving_average)
+{
+    EXPECT_FALSE(stats.lookup("my_key"));
+    stats.add("my_key", 100.0);
+    stats.add("my_key", 200.0);
+    auto entry = stats.lookup("my_key");
+    ASSERT_TRUE(entry);
+    EXPECT_DOUBLE_EQ(110.0, entry->ns_per_seek);
+    EXPECT_EQ(2u, entry->samples);
+    EXPECT_EQ(1u, stats.size());
+}
+
+TEST_F(SeekStatisticsTest, keys_include_blueprint_type_and_field_names)
+{
+    auto root = make_and(1000);
+    EXPECT_NE(key(*root, 0), key(*root, 1));
+    EXPECT_NE(vespalib::string::npos, key(*root, 0).find("(f1)"));
+    EXPECT_NE(vespalib::string::npos, key(*root, 1).find("(f2)"));
+}
+
+TEST_F(SeekStatisticsTest, apply_sets_relative_cost_and_changes_and_order)
+{
+    auto root = make_and(1000);
+    stats.add(key(*root, 0), 300.0);
+    stats.add(key(*root, 1), 100.0);
+    EXPECT_EQ(2u, stats.apply(*root, index_env));
+    EXPECT_DOUBLE_EQ(1.5, root->getChild(0).getState().cost());
+    EXPECT_DOUBLE_EQ(0.5, root->getChild(1).getState().cost());
+    EXPECT_DOUBLE_EQ(1.0, root->getChild(2).getState().cost());
+    auto optimized_up = Blueprint::optimize(std::move(root));
+    auto &optimized = dynamic_cast<IntermediateBlueprint &>(*optimized_up);
+    ASSERT_EQ(3u, optimized.childCnt());
+    EXPECT_EQ(1u, optimized.getChild(0).getState().field(0).getFieldId());
+    EXPECT_EQ(2u, optimized.getChild(1).getState().field(0).getFieldId());
+    EXPECT_EQ(0u, optimized.getChild(2).getState().field(0).getFieldId());
+}
+
+TEST_F(SeekStatisticsTest, sample_measures_seek_cost)
+{
+    auto root = std::make_unique<AndBlueprint>();
+    root->addChild(make_term(0, 10, 1000));
+    root->addChild(make_term(1, 1, 1000));
+    root->addChild(make_term(2, 5000, 1));
+    root->setDocIdLimit(docid_limit);
+    auto md = MatchData::makeTestInstance(3, 3);
+    EXPECT_EQ(3u, stats.sample(*root, *md, index_env));
+    EXPECT_EQ(3u, stats.size());
+    for (size_t i = 0; i < 3; ++i) {
+        auto entry = stats.lookup(key(*root, i));
+        ASSERT_TRUE(entry);
+        EXPECT_GE(entry->ns_per_seek, 0.0);
+        EXPECT_EQ(1u, entry->samples);
+    }
+}
+
+TEST_F(SeekStatisticsTest, sample_is_limited_to_leaves_with_fewest_samples)
+{
+    auto root = std::make_unique<AndBlueprint>();
+    root->addChild(make_term(0, 10, 1000));
+    root->addChild(make_term(0, 20, 500));
+    for (uint32_t i = 0; i < SeekStatistics::MAX_SAMPLED_LEAVES; ++i) {
+        root->addChild(make_term(1 + (i % 2), 10, 1000));
+    }
+    root->setDocIdLimit(docid_limit);
+    auto md = MatchData::makeTestInstance(3, 3);
+    stats.add(key(*root, 0), 100.0);
+    stats.add(key(*root, 0), 100.0);
+    EXPECT_EQ(SeekStatistics::MAX_SAMPLED_LEAVES, stats.sample(*root, *md, index_env));
+    // leaves searching f1 already have samples and are not probed
+    EXPECT_EQ(2u, stats.lookup(key(*root, 0))->samples);
+    EXPECT_EQ(SeekStatistics::MAX_SAMPLED_LEAVES,
+              stats.lookup(key(*root, 2))->samples + stats.lookup(key(*root, 3))->samples);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
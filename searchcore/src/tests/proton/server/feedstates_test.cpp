@@ -16,6 +16,8 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/foreground_thread_executor.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/buffer.h>
 
@@ -66,6 +68,7 @@ struct MyIncSerialNum : IIncSerialNum {
 
 struct Fixture
 {
+    vespalib::ThreadStackExecutor deserialize_executor;
     MyFeedView feed_view1;
     MyFeedView feed_view2;
     IFeedView *feed_view_ptr;
@@ -77,12 +80,13 @@ struct Fixture
     MyIncSerialNum _inc_serial_num;
     ReplayTransactionLogState state;
 
-    Fixture();
+    explicit Fixture(uint32_t replay_concurrency = 1);
     ~Fixture();
 };
 
-Fixture::Fixture()
-    : feed_view1(),
+Fixture::Fixture(uint32_t replay_concurrency)
+    : deserialize_executor(4, 128_Ki),
+      feed_view1(),
       feed_view2(),
       feed_view_ptr(&feed_view1),
       replay_config(),
@@ -91,7 +95,8 @@ Fixture::Fixture()
       _bucketDBHandler(_bucketDB),
       _replay_throttling_policy({}),
       _inc_serial_num(9u),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num)
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num,
+            deserialize_executor, replay_concurrency)
 {
 }
 Fixture::~Fixture() = default;
@@ -104,18 +109,20 @@ struct RemoveOperationContext
     nbostream str;
     std::unique_ptr<Packet> packet;
 
-    explicit RemoveOperationContext(search::SerialNum serial);
+    explicit RemoveOperationContext(search::SerialNum serial, uint32_t num_entries = 1);
     ~RemoveOperationContext();
 };
 
-RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
+RemoveOperationContext::RemoveOperationContext(search::SerialNum serial, uint32_t num_entries)
     : doc_id("id:ns:doctypename::bar"),
       op(BucketFactory::getBucketId(doc_id), Timestamp(10), doc_id),
       str(), packet(std::make_unique<Packet>(0xf000))
 {
     op.serialize(str);
     ConstBufferRef buf(str.data(), str.wp());
-    packet->add(Packet::Entry(serial, FeedOperation::REMOVE, buf));
+    for (uint32_t i = 0; i < num_entries; ++i) {
+        packet->add(Packet::Entry(serial + i, FeedOperation::REMOVE, buf));
+    }
 }
 RemoveOperationContext::~RemoveOperationContext() = default;
 TEST_F("require that active FeedView can change during replay", Fixture)
@@ -153,6 +160,19 @@ TEST_F("require that replay progress is tracked", Fixture)
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
 
+TEST_F("require that operations are replayed in order when deserialized concurrently", Fixture(4))
+{
+    RemoveOperationContext opCtx(10, 101);
+    TlsReplayProgress progress("test", 10, 110);
+    auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, &progress);
+    vespalib::ThreadStackExecutor executor(1, 128_Ki);
+    f.state.receive(wrap, executor);
+    wrap->gate.await();
+    EXPECT_EQUAL(101, f.feed_view1.remove_handled);
+    EXPECT_EQUAL(110u, f._inc_serial_num._serial_num);
+    EXPECT_EQUAL(110u, progress.getCurrent());
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
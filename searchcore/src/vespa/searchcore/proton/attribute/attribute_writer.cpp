@@ -20,6 +20,7 @@
 #include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <future>
+#include <optional>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.attribute.attribute_writer");
@@ -157,8 +158,8 @@ ensureLidSpace(SerialNum serialNum, DocumentIdT lid, AttributeVector &attr)
 }
 
 void
-applyPutToAttribute(SerialNum serialNum, const FieldValue::UP &fieldValue, DocumentIdT lid,
-                    AttributeVector &attr, AttributeWriter::OnWriteDoneType)
+applyPutValueToAttribute(SerialNum serialNum, const FieldValue::UP &fieldValue, DocumentIdT lid,
+                         AttributeVector &attr)
 {
     ensureLidSpace(serialNum, lid, attr);
     if (fieldValue.get()) {
@@ -166,6 +167,13 @@ applyPutToAttribute(SerialNum serialNum, const FieldValue::UP &fieldValue, Docum
     } else {
         attr.clearDoc(lid);
     }
+}
+
+void
+applyPutToAttribute(SerialNum serialNum, const FieldValue::UP &fieldValue, DocumentIdT lid,
+                    AttributeVector &attr, AttributeWriter::OnWriteDoneType)
+{
+    applyPutValueToAttribute(serialNum, fieldValue, lid, attr);
     attr.commitIfChangeVectorTooLarge();
 }
 
@@ -590,6 +598,95 @@ CommitTask::run()
 
 }
 
+/*
+ * Applies a window of puts to the attributes in a write context using a single
+ * executor task. The change vectors are checked once per batch instead of once
+ * per put, and a pending commit is folded into the same task.
+ */
+class BatchPutTask : public vespalib::Executor::Task
+{
+    struct Entry {
+        SerialNum       serial_num;
+        const Document* doc;
+        uint32_t        lid;
+        bool            all_attributes;
+        Entry(SerialNum serial_num_in, const Document& doc_in, uint32_t lid_in, bool all_attributes_in) noexcept
+            : serial_num(serial_num_in),
+              doc(&doc_in),
+              lid(lid_in),
+              all_attributes(all_attributes_in)
+        {
+        }
+    };
+    const AttributeWriter::WriteContext& _wc;
+    std::vector<Entry> _entries;
+    std::vector<std::shared_ptr<vespalib::IDestructorCallback>> _on_write_done;
+    std::optional<CommitParam> _commit_param;
+public:
+    BatchPutTask(const AttributeWriter::WriteContext& wc);
+    ~BatchPutTask() override;
+    void add(SerialNum serial_num, const Document& doc, uint32_t lid, bool all_attributes,
+             AttributeWriter::OnWriteDoneType on_write_done);
+    void set_commit(const CommitParam& param, AttributeWriter::OnWriteDoneType on_write_done);
+    void run() override;
+};
+
+BatchPutTask::BatchPutTask(const AttributeWriter::WriteContext& wc)
+    : _wc(wc),
+      _entries(),
+      _on_write_done(),
+      _commit_param()
+{
+}
+
+BatchPutTask::~BatchPutTask() = default;
+
+void
+BatchPutTask::add(SerialNum serial_num, const Document& doc, uint32_t lid, bool all_attributes,
+                  AttributeWriter::OnWriteDoneType on_write_done)
+{
+    _entries.emplace_back(serial_num, doc, lid, all_attributes);
+    if (on_write_done) {
+        _on_write_done.emplace_back(on_write_done);
+    }
+}
+
+void
+BatchPutTask::set_commit(const CommitParam& param, AttributeWriter::OnWriteDoneType on_write_done)
+{
+    _commit_param.emplace(param);
+    if (on_write_done) {
+        _on_write_done.emplace_back(on_write_done);
+    }
+}
+
+void
+BatchPutTask::run()
+{
+    const auto &fields = _wc.getFields();
+    for (const auto& entry : _entries) {
+        _wc.consider_build_field_paths(*entry.doc);
+        DocumentFieldExtractor field_extractor(*entry.doc);
+        for (const auto& field : fields) {
+            if (entry.all_attributes || field.isStructFieldAttribute()) {
+                AttributeVector &attr = field.getAttribute();
+                if (attr.getStatus().getLastSyncToken() < entry.serial_num) {
+                    auto fv = field_extractor.getFieldValue(field.getFieldPath());
+                    applyPutValueToAttribute(entry.serial_num, fv, entry.lid, attr);
+                }
+            }
+        }
+    }
+    for (const auto& field : fields) {
+        AttributeVector &attr = field.getAttribute();
+        if (_commit_param.has_value()) {
+            applyCommit(_commit_param.value(), {}, attr);
+        } else {
+            attr.commitIfChangeVectorTooLarge();
+        }
+    }
+}
+
 void
 AttributeWriter::setupWriteContexts()
 {
@@ -626,7 +723,8 @@ void
 AttributeWriter::internalPut(SerialNum serialNum, const Document &doc, DocumentIdT lid,
                              bool allAttributes, OnWriteDoneType onWriteDone)
 {
-    for (const auto &wc : _writeContexts) {
+    for (size_t i = 0; i < _writeContexts.size(); ++i) {
+        const auto &wc = _writeContexts[i];
         if (wc.use_two_phase_put()) {
             assert(wc.getFields().size() == 1);
             wc.consider_build_field_paths(doc);
@@ -636,16 +734,42 @@ AttributeWriter::internalPut(SerialNum serialNum, const Document &doc, DocumentI
             _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(complete_task));
         } else {
             if (allAttributes || wc.hasStructFieldAttribute()) {
-                auto putTask = std::make_unique<PutTask>(wc, serialNum, doc, lid, allAttributes, onWriteDone);
-                _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(putTask));
+                if (!_put_batches.empty()) {
+                    auto &batch = _put_batches[i];
+                    if (!batch) {
+                        batch = std::make_unique<BatchPutTask>(wc);
+                    }
+                    batch->add(serialNum, doc, lid, allAttributes, onWriteDone);
+                } else {
+                    auto putTask = std::make_unique<PutTask>(wc, serialNum, doc, lid, allAttributes, onWriteDone);
+                    _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(putTask));
+                }
             }
         }
     }
+    if (!_put_batches.empty() && ++_pending_puts >= _max_put_batch_size) {
+        flush_put_batches();
+    }
+}
+
+void
+AttributeWriter::flush_put_batches()
+{
+    if (_pending_puts == 0) {
+        return;
+    }
+    for (size_t i = 0; i < _put_batches.size(); ++i) {
+        if (_put_batches[i]) {
+            _attributeFieldWriter.executeTask(_writeContexts[i].getExecutorId(), std::move(_put_batches[i]));
+        }
+    }
+    _pending_puts = 0;
 }
 
 void
 AttributeWriter::internalRemove(SerialNum serialNum, DocumentIdT lid, OnWriteDoneType onWriteDone)
 {
+    flush_put_batches();
     for (const auto &wc : _writeContexts) {
         auto removeTask = std::make_unique<RemoveTask>(wc, serialNum, lid, onWriteDone);
         _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(removeTask));
@@ -653,15 +777,26 @@ AttributeWriter::internalRemove(SerialNum serialNum, DocumentIdT lid, OnWriteDon
 }
 
 AttributeWriter::AttributeWriter(proton::IAttributeManager::SP mgr)
+    : AttributeWriter(std::move(mgr), 1)
+{
+}
+
+AttributeWriter::AttributeWriter(proton::IAttributeManager::SP mgr, uint32_t max_put_batch_size)
     : _mgr(std::move(mgr)),
       _attributeFieldWriter(_mgr->getAttributeFieldWriter()),
       _shared_executor(_mgr->get_shared_executor()),
       _writeContexts(),
       _hasStructFieldAttribute(false),
-      _attrMap()
+      _attrMap(),
+      _max_put_batch_size(std::max(max_put_batch_size, 1u)),
+      _pending_puts(0),
+      _put_batches()
 {
     setupWriteContexts();
     setupAttributeMapping();
+    if (_max_put_batch_size > 1) {
+        _put_batches.resize(_writeContexts.size());
+    }
 }
 
 void AttributeWriter::setupAttributeMapping() {
@@ -680,7 +815,7 @@ AttributeWriter::~AttributeWriter() {
 
 void
 AttributeWriter::drain(OnWriteDoneType onDone) {
-
+    flush_put_batches();
     for (const auto &wc : _writeContexts) {
         _attributeFieldWriter.executeLambda(wc.getExecutorId(), [onDone] () { (void) onDone; });
     }
@@ -724,6 +859,7 @@ AttributeWriter::remove(SerialNum serialNum, DocumentIdT lid, OnWriteDoneType on
 void
 AttributeWriter::remove(const LidVector &lidsToRemove, SerialNum serialNum, OnWriteDoneType onWriteDone)
 {
+    flush_put_batches();
     for (const auto &writeCtx : _writeContexts) {
         auto removeTask = std::make_unique<BatchRemoveTask>(writeCtx, serialNum, lidsToRemove, onWriteDone);
         _attributeFieldWriter.executeTask(writeCtx.getExecutorId(), std::move(removeTask));
@@ -754,6 +890,7 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
                         OnWriteDoneType onWriteDone, IFieldUpdateCallback & onUpdate)
 {
     LOG(debug, "Inspecting update for document %d.", lid);
+    flush_put_batches();
     std::vector<std::unique_ptr<BatchUpdateTask>> args;
     uint32_t numExecutors = _attributeFieldWriter.getNumExecutors();
     args.reserve(numExecutors);
@@ -802,6 +939,7 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
 void
 AttributeWriter::heartBeat(SerialNum serialNum, OnWriteDoneType onDone)
 {
+    flush_put_batches();
     for (auto entry : _attrMap) {
         _attributeFieldWriter.execute(entry.second.executor_id,[serialNum, attr=entry.second.attribute, onDone]() {
             (void) onDone;
@@ -821,10 +959,17 @@ AttributeWriter::forceCommit(const CommitParam & param, OnWriteDoneType onWriteD
             attr->clearSearchCache();
         }
     }
-    for (const auto &wc : _writeContexts) {
-        auto commitTask = std::make_unique<CommitTask>(wc, param, onWriteDone);
-        _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(commitTask));
+    for (size_t i = 0; i < _writeContexts.size(); ++i) {
+        const auto &wc = _writeContexts[i];
+        if (!_put_batches.empty() && _put_batches[i]) {
+            _put_batches[i]->set_commit(param, onWriteDone);
+            _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(_put_batches[i]));
+        } else {
+            auto commitTask = std::make_unique<CommitTask>(wc, param, onWriteDone);
+            _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(commitTask));
+        }
     }
+    _pending_puts = 0;
     _attributeFieldWriter.wakeup();
 }
 
@@ -832,6 +977,7 @@ AttributeWriter::forceCommit(const CommitParam & param, OnWriteDoneType onWriteD
 void
 AttributeWriter::onReplayDone(uint32_t docIdLimit)
 {
+    flush_put_batches();
     vespalib::Gate gate;
     {
         auto on_write_done = std::make_shared<GateCallback>(gate);
@@ -851,6 +997,7 @@ AttributeWriter::onReplayDone(uint32_t docIdLimit)
 void
 AttributeWriter::compactLidSpace(uint32_t wantedLidLimit, SerialNum serialNum)
 {
+    flush_put_batches();
     vespalib::Gate gate;
     {
         auto on_write_done = std::make_shared<GateCallback>(gate);
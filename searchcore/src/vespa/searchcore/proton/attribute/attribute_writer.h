@@ -11,6 +11,8 @@ namespace document { class DocumentType; }
 
 namespace proton {
 
+class BatchPutTask;
+
 /**
  * Concrete attribute writer that handles writes in form of put, update and remove
  * to the attribute vectors managed by the underlying attribute manager.
@@ -85,15 +87,21 @@ private:
     std::vector<WriteContext> _writeContexts;
     bool                      _hasStructFieldAttribute;
     AttrMap                   _attrMap;
+    // Puts are buffered per write context and applied in one task per batch when > 1.
+    uint32_t                  _max_put_batch_size;
+    uint32_t                  _pending_puts;
+    std::vector<std::unique_ptr<BatchPutTask>> _put_batches;
 
     void setupWriteContexts();
     void setupAttributeMapping();
     void internalPut(SerialNum serialNum, const Document &doc, DocumentIdT lid,
                      bool allAttributes, OnWriteDoneType onWriteDone);
+    void flush_put_batches();
     void internalRemove(SerialNum serialNum, DocumentIdT lid, OnWriteDoneType onWriteDone);
 
 public:
     AttributeWriter(proton::IAttributeManager::SP mgr);
+    AttributeWriter(proton::IAttributeManager::SP mgr, uint32_t max_put_batch_size);
     ~AttributeWriter() override;
 
     /* Only for in tests that add attributes after AttributeWriter construction. */
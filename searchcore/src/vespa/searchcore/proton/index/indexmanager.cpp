@@ -29,8 +29,12 @@ namespace proton::index {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         uint32_t fieldInverterShards,
+                                                         uint32_t fusionWordPartitions,
                                                          IThreadingService &threadingService)
     : _cacheSize(cacheSize),
+      _fieldInverterShards(fieldInverterShards),
+      _fusionWordPartitions(fusionWordPartitions),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -44,7 +48,7 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema& schema,
                                                       SerialNum serialNum)
 {
     return std::make_shared<MemoryIndexWrapper>(schema, inspector, _fileHeaderContext, _tuneFileIndexing,
-                                                _threadingService, serialNum);
+                                                _threadingService, _fieldInverterShards, serialNum);
 }
 
 IDiskIndex::SP
@@ -71,6 +75,7 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     Fusion fusion(schema, outputDir, sources, selectorArray,
                   _tuneFileIndexing, fileHeaderContext);
+    fusion.set_word_partitions(_fusionWordPartitions);
     return fusion.merge(_threadingService.shared(), std::move(flush_token));
 }
 
@@ -85,7 +90,8 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const FileHeaderContext &fileHeaderContext) :
-    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize, threadingService),
+    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize,
+                indexConfig.fieldInverterShards, indexConfig.fusionWordPartitions, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, schema, serialNum, tuneFileAttributes),
                 IndexMaintainerContext(threadingService, reconfigurer, fileHeaderContext, warmupExecutor),
                 _operations)
@@ -13,14 +13,22 @@ struct IndexConfig {
     using WarmupConfig = searchcorespi::index::WarmupConfig;
     IndexConfig() : IndexConfig(WarmupConfig(), 2, 0) { }
     IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_)
+        : IndexConfig(warmup_, maxFlushed_, cacheSize_, 1, 1)
+    { }
+    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_, uint32_t fieldInverterShards_,
+                uint32_t fusionWordPartitions_)
         : warmup(warmup_),
           maxFlushed(maxFlushed_),
-          cacheSize(cacheSize_)
+          cacheSize(cacheSize_),
+          fieldInverterShards(fieldInverterShards_),
+          fusionWordPartitions(fusionWordPartitions_)
     { }
 
     const WarmupConfig warmup;
     const size_t       maxFlushed;
     const size_t       cacheSize;
+    const uint32_t     fieldInverterShards;
+    const uint32_t     fusionWordPartitions;
 };
 
 /**
@@ -37,6 +45,8 @@ public:
         using IDiskIndex = searchcorespi::index::IDiskIndex;
         using IMemoryIndex = searchcorespi::index::IMemoryIndex;
         const size_t _cacheSize;
+        const uint32_t _fieldInverterShards;
+        const uint32_t _fusionWordPartitions;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -46,6 +56,8 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             uint32_t fieldInverterShards,
+                             uint32_t fusionWordPartitions,
                              searchcorespi::index::IThreadingService &threadingService);
 
         IMemoryIndex::SP createMemoryIndex(const Schema& schema,
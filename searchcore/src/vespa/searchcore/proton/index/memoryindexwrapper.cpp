@@ -22,9 +22,10 @@ MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema& schema,
                                        const search::common::FileHeaderContext& fileHeaderContext,
                                        const TuneFileIndexing& tuneFileIndexing,
                                        searchcorespi::index::IThreadingService& threadingService,
+                                       uint32_t fieldInverterShards,
                                        search::SerialNum serialNum)
     : _index(schema, inspector, threadingService.indexFieldInverter(),
-             threadingService.indexFieldWriter()),
+             threadingService.indexFieldWriter(), fieldInverterShards),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexing)
@@ -29,6 +29,7 @@ public:
                        const search::common::FileHeaderContext& fileHeaderContext,
                        const search::TuneFileIndexing& tuneFileIndexing,
                        searchcorespi::index::IThreadingService& threadingService,
+                       uint32_t fieldInverterShards,
                        SerialNum serialNum);
 
     /**
@@ -52,7 +53,8 @@ public:
         return search::SearchableStats()
             .memoryUsage(getMemoryUsage())
             .docsInMemory(_index.getNumDocs())
-            .sizeOnDisk(0);
+            .sizeOnDisk(0)
+            .memory_index_latency(_index.get_latency_stats());
     }
 
     SerialNum getSerialNum() const override;
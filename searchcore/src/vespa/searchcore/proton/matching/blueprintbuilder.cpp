@@ -1,15 +1,20 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "blueprintbuilder.h"
+#include "filter_cache.h"
+#include "filter_cache_blueprint.h"
 #include "querynodes.h"
 #include "termdatafromnode.h"
 #include "same_element_builder.h"
 #include <vespa/searchcorespi/index/indexsearchable.h>
+#include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/query/tree/customtypevisitor.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/equiv_blueprint.h>
 #include <vespa/searchlib/queryeval/get_weight_from_node.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <algorithm>
 
 using namespace search::queryeval;
 
@@ -48,6 +53,112 @@ struct Mixer {
     }
 };
 
+/**
+ * Creates a normalized cache key for a query subtree that can be
+ * stored in the filter cache. Only non-ranked terms searching
+ * attributes (and AND/OR nodes of such terms) are cacheable. The key
+ * contains the current generation of each searched attribute. An
+ * empty key is produced for subtrees that are not cacheable.
+ */
+class FilterKeyBuilder :
+        public search::query::CustomTypeVisitor<ProtonNodeTypes>
+{
+private:
+    const IRequestContext & _requestContext;
+    vespalib::string        _key;
+
+    template <typename NodeType>
+    void buildIntermediate(const char *name, NodeType &n) {
+        std::vector<vespalib::string> keys;
+        for (search::query::Node *child : n.getChildren()) {
+            keys.push_back(make_key(_requestContext, *child));
+            if (keys.back().empty()) {
+                return;
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        vespalib::asciistream os;
+        os << name << "(";
+        for (size_t i = 0; i < keys.size(); ++i) {
+            os << ((i > 0) ? "," : "") << keys[i];
+        }
+        os << ")";
+        _key = os.str();
+    }
+
+    template <typename NodeType>
+    void buildTerm(const char *name, NodeType &n) {
+        if (n.isRanked() || (n.numFields() == 0)) {
+            return;
+        }
+        std::vector<vespalib::string> fields;
+        for (size_t i = 0; i < n.numFields(); ++i) {
+            const ProtonTermData::FieldEntry &field = n.field(i);
+            if (!field.attribute_field) {
+                return;
+            }
+            auto attr = dynamic_cast<const search::AttributeVector *>(_requestContext.getAttribute(field.field_name));
+            if (attr == nullptr) {
+                return;
+            }
+            vespalib::asciistream os;
+            os << field.field_name << "@" << attr->getCurrentGeneration();
+            fields.push_back(os.str());
+        }
+        std::sort(fields.begin(), fields.end());
+        vespalib::asciistream term;
+        term << n.getTerm();
+        vespalib::asciistream os;
+        os << name << "(";
+        for (const auto &field : fields) {
+            os << field << ",";
+        }
+        os << term.size() << ":" << term.str() << ")";
+        _key = os.str();
+    }
+
+protected:
+    void visit(ProtonAnd &n)         override { buildIntermediate("and", n); }
+    void visit(ProtonAndNot &)       override {}
+    void visit(ProtonOr &n)          override { buildIntermediate("or", n); }
+    void visit(ProtonWeakAnd &)      override {}
+    void visit(ProtonEquiv &)        override {}
+    void visit(ProtonRank &)         override {}
+    void visit(ProtonNear &)         override {}
+    void visit(ProtonONear &)        override {}
+    void visit(ProtonSameElement &)  override {}
+
+    void visit(ProtonWeightedSetTerm &) override {}
+    void visit(ProtonDotProduct &)      override {}
+    void visit(ProtonWandTerm &)        override {}
+
+    void visit(ProtonPhrase &)          override {}
+    void visit(ProtonNumberTerm &n)     override { buildTerm("number", n); }
+    void visit(ProtonLocationTerm &)    override {}
+    void visit(ProtonPrefixTerm &n)     override { buildTerm("prefix", n); }
+    void visit(ProtonRangeTerm &n)      override { buildTerm("range", n); }
+    void visit(ProtonStringTerm &n)     override { buildTerm("string", n); }
+    void visit(ProtonSubstringTerm &)   override {}
+    void visit(ProtonSuffixTerm &)      override {}
+    void visit(ProtonPredicateQuery &)  override {}
+    void visit(ProtonRegExpTerm &)      override {}
+    void visit(ProtonNearestNeighborTerm &) override {}
+    void visit(ProtonTrue &)            override {}
+    void visit(ProtonFalse &)           override {}
+    void visit(ProtonFuzzyTerm &)       override {}
+
+public:
+    explicit FilterKeyBuilder(const IRequestContext & requestContext)
+        : _requestContext(requestContext),
+          _key()
+    { }
+    static vespalib::string make_key(const IRequestContext & requestContext, search::query::Node &node) {
+        FilterKeyBuilder builder(requestContext);
+        node.accept(builder);
+        return builder._key;
+    }
+};
+
 /**
  * requires that match data space has been reserved
  */
@@ -57,14 +168,67 @@ class BlueprintBuilderVisitor :
 private:
     const IRequestContext & _requestContext;
     ISearchContext &_context;
+    FilterCache    *_filter_cache;
     Blueprint::UP   _result;
 
     void buildChildren(IntermediateBlueprint &parent,
                        const std::vector<search::query::Node *> &children)
     {
         for (size_t i = 0; i < children.size(); ++i) {
-            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context));
+            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context, _filter_cache));
+        }
+    }
+
+    Blueprint::UP buildCachedFilter(std::vector<std::pair<vespalib::string, search::query::Node *>> filters) {
+        std::sort(filters.begin(), filters.end(),
+                  [](const auto &a, const auto &b) { return (a.first < b.first); });
+        vespalib::asciistream os;
+        os << "and(";
+        for (size_t i = 0; i < filters.size(); ++i) {
+            os << ((i > 0) ? "," : "") << filters[i].first;
+        }
+        os << ")@" << _context.getDocIdLimit();
+        vespalib::string key = os.str();
+        auto hits = _filter_cache->lookup(key);
+        if (hits) {
+            return std::make_unique<FilterCacheBlueprint>(*_filter_cache, std::move(key), std::move(hits));
+        }
+        Blueprint::UP filter;
+        if (filters.size() == 1) {
+            filter = BlueprintBuilder::build(_requestContext, *filters[0].second, _context);
+        } else {
+            auto and_filter = std::make_unique<AndBlueprint>();
+            for (const auto &entry : filters) {
+                and_filter->addChild(BlueprintBuilder::build(_requestContext, *entry.second, _context));
+            }
+            filter = std::move(and_filter);
+            filter->setDocIdLimit(_context.getDocIdLimit());
+        }
+        if (!_filter_cache->admit(key)) {
+            return filter;
+        }
+        return std::make_unique<FilterCacheBlueprint>(*_filter_cache, std::move(key), std::move(filter));
+    }
+
+    void buildAnd(ProtonAnd &n) {
+        if (_filter_cache == nullptr) {
+            buildIntermediate(new AndBlueprint(), n);
+            return;
+        }
+        auto blueprint = std::make_unique<AndBlueprint>();
+        std::vector<std::pair<vespalib::string, search::query::Node *>> filters;
+        for (search::query::Node *child : n.getChildren()) {
+            vespalib::string key = FilterKeyBuilder::make_key(_requestContext, *child);
+            if (key.empty()) {
+                blueprint->addChild(BlueprintBuilder::build(_requestContext, *child, _context, _filter_cache));
+            } else {
+                filters.emplace_back(std::move(key), child);
+            }
+        }
+        if (!filters.empty()) {
+            blueprint->addChild(buildCachedFilter(std::move(filters)));
         }
+        _result = std::move(blueprint);
     }
 
     template <typename NodeType>
@@ -80,7 +244,7 @@ private:
         for (size_t i = 0; i < n.getChildren().size(); ++i) {
             search::query::Node &node = *n.getChildren()[i];
             uint32_t weight = getWeightFromNode(node).percent();
-            wand->addTerm(BlueprintBuilder::build(_requestContext, node, _context), weight);
+            wand->addTerm(BlueprintBuilder::build(_requestContext, node, _context, _filter_cache), weight);
         }
         _result = std::move(result);
     }
@@ -134,7 +298,7 @@ private:
     }
 
 protected:
-    void visit(ProtonAnd &n)         override { buildIntermediate(new AndBlueprint(), n); }
+    void visit(ProtonAnd &n)         override { buildAnd(n); }
     void visit(ProtonAndNot &n)      override { buildIntermediate(new AndNotBlueprint(), n); }
     void visit(ProtonOr &n)          override { buildIntermediate(new OrBlueprint(), n); }
     void visit(ProtonWeakAnd &n)     override { buildWeakAnd(n); }
@@ -168,9 +332,10 @@ protected:
     void visit(ProtonFuzzyTerm &n)      override { buildTerm(n); }
 
 public:
-    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context) :
+    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context, FilterCache *filter_cache) :
         _requestContext(requestContext),
         _context(context),
+        _filter_cache(filter_cache),
         _result()
     { }
     Blueprint::UP build() {
@@ -184,9 +349,10 @@ public:
 search::queryeval::Blueprint::UP
 BlueprintBuilder::build(const IRequestContext & requestContext,
                         search::query::Node &node,
-                        ISearchContext &context)
+                        ISearchContext &context,
+                        FilterCache *filter_cache)
 {
-    BlueprintBuilderVisitor visitor(requestContext, context);
+    BlueprintBuilderVisitor visitor(requestContext, context, filter_cache);
     node.accept(visitor);
     Blueprint::UP result = visitor.build();
     result->setDocIdLimit(context.getDocIdLimit());
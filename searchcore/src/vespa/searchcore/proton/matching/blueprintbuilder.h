@@ -8,15 +8,20 @@
 
 namespace proton::matching {
 
+class FilterCache;
+
 struct BlueprintBuilder {
     /**
      * Build a tree of blueprints from the query tree and inject
      * blueprint meta-data back into corresponding query tree nodes.
+     * If a filter cache is given, the cacheable filter children of
+     * AND nodes are searched using the cache.
      */
     static search::queryeval::Blueprint::UP
     build(const search::queryeval::IRequestContext & requestContext,
           search::query::Node &node,
-          ISearchContext &context);
+          ISearchContext &context,
+          FilterCache *filter_cache = nullptr);
 };
 
 }
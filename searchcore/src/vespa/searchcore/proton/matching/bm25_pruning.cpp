@@ -0,0 +1,155 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm25_pruning.h"
+#include <vespa/eval/eval/basic_nodes.h>
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/operator_nodes.h>
+#include <vespa/searchlib/features/bm25_feature.h>
+#include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
+#include <vespa/searchlib/fef/featurenameparser.h>
+#include <vespa/searchlib/fef/fieldinfo.h>
+#include <vespa/searchlib/fef/iindexenvironment.h>
+#include <vespa/searchlib/fef/iqueryenvironment.h>
+#include <vespa/searchlib/fef/itermdata.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/searchlib/queryeval/wand/bm25_pruning_or_search.h>
+#include <vespa/searchlib/queryeval/wand/parallel_weak_and_blueprint.h>
+#include <algorithm>
+
+using search::features::Bm25Blueprint;
+using search::features::Bm25Executor;
+using search::features::rankingexpression::FeatureNameExtractor;
+using search::fef::FeatureNameParser;
+using search::fef::FieldType;
+using search::fef::IIndexEnvironment;
+using search::fef::IQueryEnvironment;
+using search::fef::ITermData;
+using search::fef::ITermFieldData;
+using search::fef::MatchDataDetails;
+using search::fef::Property;
+using search::queryeval::Bm25PruningParams;
+using vespalib::eval::Function;
+using vespalib::eval::nodes::Add;
+using vespalib::eval::nodes::Node;
+using vespalib::eval::nodes::Symbol;
+using vespalib::eval::nodes::as;
+
+namespace proton::matching {
+
+namespace {
+
+vespalib::string
+lookup_ranking_script(const FeatureNameParser &feature, const IIndexEnvironment &index_env)
+{
+    vespalib::string script;
+    Property property = index_env.getProperties().lookup(feature.executorName(), "rankingScript");
+    Property expr_name = index_env.getProperties().lookup(feature.executorName(), "expressionName");
+    if (property.size() > 0) {
+        for (uint32_t i = 0; i < property.size(); ++i) {
+            script.append(property.getAt(i));
+        }
+    } else if (expr_name.size() == 1) {
+        script = index_env.getRankingExpression(expr_name.get());
+    } else if (feature.parameters().size() == 1) {
+        script = feature.parameters()[0];
+    }
+    return script;
+}
+
+bool
+add_bm25_field(const FeatureNameParser &feature, const IIndexEnvironment &index_env,
+               std::vector<vespalib::string> &fields)
+{
+    if (!feature.valid() || (feature.baseName() != "bm25") || (feature.parameters().size() != 1) ||
+        (!feature.output().empty() && (feature.output() != "score")))
+    {
+        return false;
+    }
+    const auto &field_name = feature.parameters()[0];
+    const auto *field = index_env.getFieldByName(field_name);
+    if ((field == nullptr) || (field->type() != FieldType::INDEX) ||
+        (std::find(fields.begin(), fields.end(), field_name) != fields.end()))
+    {
+        return false;
+    }
+    fields.push_back(field_name);
+    return true;
+}
+
+bool
+add_bm25_fields(const Function &function, const Node &node, const IIndexEnvironment &index_env,
+                std::vector<vespalib::string> &fields)
+{
+    if (auto add = as<Add>(node)) {
+        return add_bm25_fields(function, add->lhs(), index_env, fields) &&
+               add_bm25_fields(function, add->rhs(), index_env, fields);
+    }
+    if (auto symbol = as<Symbol>(node)) {
+        return add_bm25_field(FeatureNameParser(function.param_name(symbol->id())), index_env, fields);
+    }
+    return false;
+}
+
+}
+
+std::vector<vespalib::string>
+extract_bm25_fields(const vespalib::string &first_phase_rank, const IIndexEnvironment &index_env)
+{
+    std::vector<vespalib::string> fields;
+    FeatureNameParser feature(first_phase_rank);
+    if (feature.valid() && (feature.baseName() == "rankingExpression")) {
+        vespalib::string script = lookup_ranking_script(feature, index_env);
+        auto function = Function::parse(script, FeatureNameExtractor());
+        if (function->has_error() || !add_bm25_fields(*function, function->root(), index_env, fields)) {
+            fields.clear();
+        }
+    } else if (!add_bm25_field(feature, index_env, fields)) {
+        fields.clear();
+    }
+    return fields;
+}
+
+std::shared_ptr<const Bm25PruningParams>
+make_bm25_pruning_params(const vespalib::string &first_phase_rank, const IQueryEnvironment &query_env,
+                         uint32_t scores_to_track)
+{
+    const IIndexEnvironment &index_env = query_env.getIndexEnvironment();
+    auto fields = extract_bm25_fields(first_phase_rank, index_env);
+    if (fields.empty() || (scores_to_track == 0)) {
+        return {};
+    }
+    auto params = std::make_shared<Bm25PruningParams>(scores_to_track,
+                                                      search::queryeval::DEFAULT_PARALLEL_WAND_SCORES_ADJUST_FREQUENCY);
+    for (const auto &field_name : fields) {
+        const auto *field = index_env.getFieldByName(field_name);
+        double k1_param = 0.0;
+        double b_param = 0.0;
+        if (!Bm25Blueprint::lookup_params(index_env.getProperties(), field_name, k1_param, b_param) ||
+            (k1_param < 0.0) || (b_param < 0.0) || (b_param > 1.0))
+        {
+            // the max score of a term is only valid for the normal range of k1 and b
+            return {};
+        }
+        double avg_field_length = query_env.get_average_field_length(field_name);
+        for (uint32_t i = 0; i < query_env.getNumTerms(); ++i) {
+            const ITermData *term = query_env.getTerm(i);
+            const ITermFieldData *term_field = term->lookupField(field->id());
+            if (term_field == nullptr) {
+                continue;
+            }
+            double idf = Bm25Executor::get_inverse_document_frequency(*term_field, query_env, *term);
+            if (idf < 0.0) {
+                // negative term scores would make the max score of a term too low
+                return {};
+            }
+            params->add_term_field(term_field->getHandle(MatchDataDetails::Interleaved), idf,
+                                   k1_param, b_param, avg_field_length);
+        }
+    }
+    if (params->get_term_fields().empty()) {
+        return {};
+    }
+    return params;
+}
+
+}
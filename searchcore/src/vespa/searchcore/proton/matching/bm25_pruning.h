@@ -0,0 +1,34 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <vector>
+
+namespace search::fef {
+    class IIndexEnvironment;
+    class IQueryEnvironment;
+}
+namespace search::queryeval { class Bm25PruningParams; }
+
+namespace proton::matching {
+
+/**
+ * Extracts the index fields used when the given first phase rank
+ * feature is a sum of bm25 features. An empty list is returned if
+ * the first phase ranking is anything else.
+ **/
+std::vector<vespalib::string>
+extract_bm25_fields(const vespalib::string &first_phase_rank, const search::fef::IIndexEnvironment &index_env);
+
+/**
+ * Creates the parameters needed to prune documents that cannot get a
+ * first phase score among the best 'scores_to_track' hits. Returns
+ * nullptr if the first phase ranking is not a sum of bm25 features.
+ **/
+std::shared_ptr<const search::queryeval::Bm25PruningParams>
+make_bm25_pruning_params(const vespalib::string &first_phase_rank, const search::fef::IQueryEnvironment &query_env,
+                         uint32_t scores_to_track);
+
+}
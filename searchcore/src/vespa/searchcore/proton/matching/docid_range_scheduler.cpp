@@ -164,4 +164,99 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::claim(size_t thread_id)
+{
+    Worker &self = _workers[thread_id];
+    uint64_t old_value = self.todo.load(std::memory_order_acquire);
+    for (;;) {
+        DocidRange todo = unpack(old_value);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        // claim smaller chunks as the remaining work shrinks to keep the tail stealable
+        uint32_t chunk = std::min(todo.size(), std::max(size_t(_min_task), todo.size() / 8));
+        DocidRange mine(todo.begin, todo.begin + chunk);
+        if (self.todo.compare_exchange_weak(old_value, pack(DocidRange(mine.end, todo.end)),
+                                            std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            self.assigned += mine.size();
+            return mine;
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        size_t victim = _workers.size();
+        uint64_t old_value = 0;
+        size_t best_size = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            if (i != thread_id) {
+                uint64_t value = _workers[i].todo.load(std::memory_order_acquire);
+                size_t size = unpack(value).size();
+                if (size > best_size) {
+                    victim = i;
+                    old_value = value;
+                    best_size = size;
+                }
+            }
+        }
+        if (victim == _workers.size()) {
+            return false;
+        }
+        DocidRange todo = unpack(old_value);
+        uint32_t mid = todo.begin + (todo.size() / 2);
+        if (_workers[victim].todo.compare_exchange_strong(old_value, pack(DocidRange(todo.begin, mid)),
+                                                          std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            Worker &self = _workers[thread_id];
+            self.todo.store(pack(DocidRange(mid, todo.end)), std::memory_order_release);
+            ++self.steals;
+            self.stolen += (todo.end - mid);
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _min_task(std::max(1u, min_task)),
+      _workers(num_threads)
+{
+    DocidRangeSplitter splitter(DocidRange(1, docid_limit), num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(splitter.get(i)), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    for (;;) {
+        DocidRange range = claim(thread_id);
+        if (!range.empty()) {
+            return range;
+        }
+        if (!steal(thread_id)) {
+            return DocidRange();
+        }
+    }
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const auto &worker: _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -102,6 +102,10 @@ public:
  * will return the remaining work to be done by the thread calling
  * it. The returned range is guaranteed to be a prefix of the range
  * passed as input to the 'share_range' function.
+ *
+ * The 'steal_count' and 'stolen_size' functions report how many
+ * ranges (and how many docids in total) the given worker has taken
+ * from other workers. Schedulers that do not steal work report 0.
  **/
 struct DocidRangeScheduler {
     typedef std::unique_ptr<DocidRangeScheduler> UP;
@@ -111,6 +115,8 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    virtual size_t steal_count(size_t) const { return 0; }
+    virtual size_t stolen_size(size_t) const { return 0; }
     virtual ~DocidRangeScheduler() {}
 };
 
@@ -200,4 +206,43 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A lock-free work-stealing scheduler. Each thread starts out owning
+ * an equal part of the docid space and claims chunks from the front
+ * of its own part. A thread running out of work steals the back half
+ * of the largest remaining part owned by another thread. The
+ * unclaimed part of each thread is packed into a single atomic word,
+ * so claiming and stealing are both a single compare-and-swap.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        size_t                assigned;
+        size_t                steals;
+        size_t                stolen;
+        Worker() noexcept : todo(0), assigned(0), steals(0), stolen(0) {}
+    };
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+
+    static uint64_t pack(DocidRange range) { return ((uint64_t(range.begin) << 32) | range.end); }
+    static DocidRange unpack(uint64_t value) { return DocidRange(uint32_t(value >> 32), uint32_t(value)); }
+
+    VESPA_DLL_LOCAL DocidRange claim(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler() override;
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t thread_id) const override { return _workers[thread_id].steals; }
+    size_t stolen_size(size_t thread_id) const override { return _workers[thread_id].stolen; }
+};
+
 }
@@ -0,0 +1,78 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace proton::matching {
+
+size_t
+FilterCache::BitVectorSize::operator()(const BitVectorSP &bits) const noexcept
+{
+    return bits ? (sizeof(search::BitVector) + bits->getFileBytes()) : 0;
+}
+
+FilterCache::FilterCache(size_t max_bytes, size_t max_seen_keys)
+    : _store(),
+      _cache(std::make_unique<Cache>(_store, max_bytes)),
+      _seen_lock(),
+      _max_seen_keys(max_seen_keys),
+      _seen_lru(),
+      _seen()
+{
+}
+
+FilterCache::~FilterCache() = default;
+
+void
+FilterCache::set_capacity_bytes(size_t max_bytes)
+{
+    _cache->setCapacityBytes(max_bytes);
+}
+
+size_t
+FilterCache::get_capacity_bytes() const
+{
+    return _cache->capacityBytes();
+}
+
+bool
+FilterCache::admit(const vespalib::string &key)
+{
+    size_t hash = vespalib::hashValue(key.data(), key.size());
+    std::lock_guard<std::mutex> guard(_seen_lock);
+    auto itr = _seen.find(hash);
+    if (itr != _seen.end()) {
+        _seen_lru.splice(_seen_lru.begin(), _seen_lru, itr->second);
+        return true;
+    }
+    if (_seen.size() >= _max_seen_keys && !_seen_lru.empty()) {
+        _seen.erase(_seen_lru.back());
+        _seen_lru.pop_back();
+    }
+    _seen_lru.push_front(hash);
+    _seen[hash] = _seen_lru.begin();
+    return false;
+}
+
+FilterCache::BitVectorSP
+FilterCache::lookup(const vespalib::string &key)
+{
+    return _cache->read(key);
+}
+
+void
+FilterCache::insert(const vespalib::string &key, BitVectorSP bits)
+{
+    _cache->write(key, std::move(bits));
+}
+
+vespalib::CacheStats
+FilterCache::get_stats() const
+{
+    return _cache->get_stats();
+}
+
+}
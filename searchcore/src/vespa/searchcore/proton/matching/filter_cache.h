@@ -0,0 +1,82 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace search { class BitVector; }
+
+namespace proton::matching {
+
+/**
+ * Cache of filter results shared between queries. Each entry is the
+ * result of a non-ranked query subtree searching only attributes,
+ * stored as a bitvector. The key is a normalized description of the
+ * subtree that includes the current generation of the searched
+ * attributes and the docid limit, so entries for a changed attribute
+ * are never used again and are eventually evicted in LRU order when
+ * the memory budget is exceeded.
+ *
+ * One instance is shared by all rank profiles of a document db. A
+ * result is only cached the second time its key is seen, to avoid
+ * evicting useful entries for filters that are used once. Seen keys
+ * are tracked as hashes in a bounded LRU list, so frequently used
+ * keys stay admitted while keys seen once are dropped first.
+ **/
+class FilterCache
+{
+public:
+    using BitVectorSP = std::shared_ptr<const search::BitVector>;
+
+private:
+    struct BitVectorSize {
+        size_t operator()(const BitVectorSP &bits) const noexcept;
+    };
+    using Store = vespalib::NullStore<vespalib::string, BitVectorSP>;
+    using CacheParams = vespalib::CacheParam<vespalib::LruParam<vespalib::string, BitVectorSP>,
+                                             Store,
+                                             vespalib::size<vespalib::string>,
+                                             BitVectorSize>;
+    using Cache = vespalib::cache<CacheParams>;
+
+    using SeenList = std::list<size_t>;
+
+    Store                                           _store;
+    std::unique_ptr<Cache>                          _cache;
+    std::mutex                                      _seen_lock;
+    size_t                                          _max_seen_keys;
+    SeenList                                        _seen_lru;
+    vespalib::hash_map<size_t, SeenList::iterator>  _seen;
+
+public:
+    using SP = std::shared_ptr<FilterCache>;
+    static constexpr size_t MAX_SEEN_KEYS = 100000;
+    explicit FilterCache(size_t max_bytes, size_t max_seen_keys = MAX_SEEN_KEYS);
+    ~FilterCache();
+
+    void set_capacity_bytes(size_t max_bytes);
+    size_t get_capacity_bytes() const;
+
+    /**
+     * Records that the given key was wanted by a query and returns
+     * true if it was seen before, meaning that its result should be
+     * inserted into the cache.
+     **/
+    bool admit(const vespalib::string &key);
+
+    /**
+     * Returns the cached result for the given key, or an empty
+     * pointer if there is none.
+     **/
+    BitVectorSP lookup(const vespalib::string &key);
+    void insert(const vespalib::string &key, BitVectorSP bits);
+    vespalib::CacheStats get_stats() const;
+};
+
+}
@@ -0,0 +1,130 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_cache_blueprint.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/vespalib/objects/visit.hpp>
+#include <algorithm>
+#include <cassert>
+
+using search::BitVector;
+using search::BitVectorIterator;
+using search::fef::MatchData;
+using search::queryeval::Blueprint;
+using search::queryeval::IntermediateBlueprint;
+using search::queryeval::ExecuteInfo;
+using search::queryeval::FieldSpecBaseList;
+using search::queryeval::SearchIterator;
+
+namespace proton::matching {
+
+namespace {
+
+/**
+ * Returns one more than the highest term field handle used anywhere
+ * in the given blueprint tree, which is the number of term fields
+ * needed in the match data used to evaluate it.
+ **/
+uint32_t
+term_field_limit(const Blueprint &blueprint)
+{
+    uint32_t limit = 0;
+    const auto &state = blueprint.getState();
+    for (size_t i = 0; i < state.numFields(); ++i) {
+        uint32_t handle = state.field(i).getHandle();
+        if (handle != search::fef::IllegalHandle) {
+            limit = std::max(limit, handle + 1);
+        }
+    }
+    if (blueprint.isIntermediate()) {
+        const auto &parent = static_cast<const IntermediateBlueprint &>(blueprint);
+        for (size_t i = 0; i < parent.childCnt(); ++i) {
+            limit = std::max(limit, term_field_limit(parent.getChild(i)));
+        }
+    }
+    return limit;
+}
+
+}
+
+FilterCacheBlueprint::FilterCacheBlueprint(FilterCache &cache, vespalib::string key, BitVectorSP hits)
+    : SimpleLeafBlueprint(FieldSpecBaseList()),
+      _cache(cache),
+      _key(std::move(key)),
+      _filter(),
+      _hits(std::move(hits)),
+      _cache_hit(true),
+      _lock(),
+      _match_data()
+{
+    uint32_t num_hits = _hits->countTrueBits();
+    setEstimate(HitEstimate(num_hits, (num_hits == 0)));
+}
+
+FilterCacheBlueprint::FilterCacheBlueprint(FilterCache &cache, vespalib::string key, Blueprint::UP filter)
+    : SimpleLeafBlueprint(FieldSpecBaseList()),
+      _cache(cache),
+      _key(std::move(key)),
+      _filter(Blueprint::optimize(std::move(filter))),
+      _hits(),
+      _cache_hit(false),
+      _lock(),
+      _match_data()
+{
+    setEstimate(_filter->getState().estimate());
+}
+
+FilterCacheBlueprint::~FilterCacheBlueprint() = default;
+
+void
+FilterCacheBlueprint::fetchPostings(const ExecuteInfo &)
+{
+    if (_hits) {
+        return;
+    }
+    uint32_t docid_limit = get_docid_limit();
+    _filter->fetchPostings(ExecuteInfo::create(true, 1.0));
+    // Filter searches may be supersets of the real result, so the
+    // cached result is evaluated with a full search to stay exact.
+    MatchData md(MatchData::params().numTermFields(term_field_limit(*_filter)));
+    auto search = _filter->createSearch(md, true);
+    auto hits = BitVector::create(docid_limit);
+    search->initRange(1, docid_limit);
+    search->or_hits_into(*hits, 1);
+    _hits = std::move(hits);
+    _filter.reset();
+    _cache.insert(_key, _hits);
+}
+
+SearchIterator::UP
+FilterCacheBlueprint::createLeafSearch(const search::fef::TermFieldMatchDataArray &tfmda, bool strict) const
+{
+    assert(tfmda.size() == 0);
+    (void) tfmda;
+    return createFilterSearch(strict, FilterConstraint::UPPER_BOUND);
+}
+
+SearchIterator::UP
+FilterCacheBlueprint::createFilterSearch(bool strict, FilterConstraint) const
+{
+    assert(_hits);
+    auto tfmd = std::make_unique<TermFieldMatchData>();
+    auto search = BitVectorIterator::create(_hits.get(), get_docid_limit(), *tfmd, strict);
+    std::lock_guard<std::mutex> guard(_lock);
+    _match_data.push_back(std::move(tfmd));
+    return search;
+}
+
+void
+FilterCacheBlueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    LeafBlueprint::visitMembers(visitor);
+    visit(visitor, "key", _key);
+    visit(visitor, "cache_hit", _cache_hit);
+}
+
+}
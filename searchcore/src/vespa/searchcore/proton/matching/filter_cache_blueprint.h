@@ -0,0 +1,47 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "filter_cache.h"
+#include <vespa/searchlib/queryeval/blueprint.h>
+#include <mutex>
+#include <vector>
+
+namespace search::fef { class TermFieldMatchData; }
+
+namespace proton::matching {
+
+/**
+ * Leaf blueprint for a filter subtree whose result is stored in a
+ * FilterCache. On a cache hit the cached bitvector is searched
+ * directly. On a cache miss the wrapped filter blueprint is evaluated
+ * exactly into a bitvector when postings are fetched, and the result
+ * is inserted into the cache before it is searched.
+ **/
+class FilterCacheBlueprint : public search::queryeval::SimpleLeafBlueprint
+{
+private:
+    using BitVectorSP = FilterCache::BitVectorSP;
+    using TermFieldMatchData = search::fef::TermFieldMatchData;
+
+    FilterCache                                    &_cache;
+    vespalib::string                                _key;
+    Blueprint::UP                                   _filter;
+    BitVectorSP                                     _hits;
+    bool                                            _cache_hit;
+    mutable std::mutex                              _lock;
+    mutable std::vector<std::unique_ptr<TermFieldMatchData>> _match_data;
+
+    SearchIteratorUP createLeafSearch(const search::fef::TermFieldMatchDataArray &tfmda, bool strict) const override;
+public:
+    FilterCacheBlueprint(FilterCache &cache, vespalib::string key, BitVectorSP hits);
+    FilterCacheBlueprint(FilterCache &cache, vespalib::string key, Blueprint::UP filter);
+    ~FilterCacheBlueprint() override;
+    const vespalib::string &key() const { return _key; }
+    bool is_cache_hit() const { return _cache_hit; }
+    void fetchPostings(const search::queryeval::ExecuteInfo &execInfo) override;
+    SearchIteratorUP createFilterSearch(bool strict, FilterConstraint constraint) const override;
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+};
+
+}
@@ -59,10 +59,17 @@ struct TimedMatchLoopCommunicator final : IMatchLoopCommunicator {
     }
 };
 
+constexpr uint32_t WORK_STEALING_MIN_TASK = 256;
+
+// The adaptive scheduler coordinates through a single mutex, which
+// becomes a bottleneck with many match threads per query.
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t workStealingMinThreads, uint32_t numDocs)
 {
     if (numSearchPartitions == 0) {
+        if ((workStealingMinThreads > 0) && (numThreads >= workStealingMinThreads)) {
+            return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, WORK_STEALING_MIN_TASK, numDocs);
+        }
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
@@ -94,13 +101,15 @@ MatchMaster::match(search::engine::Trace & trace,
                    const MatchToolsFactory &mtf,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   uint32_t workStealingMinThreads)
 {
     vespalib::Timer query_latency_time;
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.heapSize));
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions,
+                                                        workStealingMinThreads, params.numDocs);
 
     std::vector<MatchThread::UP> threadState;
     for (size_t i = 0; i < threadBundle.size(); ++i) {
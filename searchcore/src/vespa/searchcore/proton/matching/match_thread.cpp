@@ -58,21 +58,55 @@ LazyValue get_score_feature(const RankProgram &rankProgram) {
 
 //-----------------------------------------------------------------------------
 
-MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads)
+MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads,
+                              bool batch_rank)
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _rank_program(tools.rank_program()),
+      _batch_rank(batch_rank && _rank_program.prepare_batch(RANK_BATCH_SIZE)),
+      _batch_docids(),
+      _batch_scores(),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
       _doom(tools.getDoom()),
       dropped()
 {
+    if (_batch_rank) {
+        _batch_docids.reserve(RANK_BATCH_SIZE);
+        _batch_scores.resize(RANK_BATCH_SIZE);
+    }
 }
 
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    if (_batch_rank) {
+        _batch_docids.push_back(docId);
+        if (_batch_docids.size() == RANK_BATCH_SIZE) {
+            flushRankBatch<use_rank_drop_limit>();
+        }
+        return;
+    }
+    addScore<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::flushRankBatch() {
+    if (_batch_docids.empty()) {
+        return;
+    }
+    _rank_program.execute_batch(_batch_docids, _batch_scores);
+    for (size_t i = 0; i < _batch_docids.size(); ++i) {
+        addScore<use_rank_drop_limit>(_batch_docids[i], _batch_scores[i]);
+    }
+    _batch_docids.clear();
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::addScore(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -165,6 +199,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushRankBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -176,7 +213,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     bool softDoomed = false;
     uint32_t docsCovered = 0;
     vespalib::duration overtime(vespalib::duration::zero());
-    Context context(matchParams.rankDropLimit, tools, hits, num_threads);
+    Context context(matchParams.rankDropLimit, tools, hits, num_threads, do_rank && tools.use_batch_rank());
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty();
          docid_range = scheduler.next_range(thread_id))
@@ -201,6 +238,8 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     thread_stats.docsCovered(docsCovered);
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
+    thread_stats.rangesStolen(scheduler.steal_count(thread_id));
+    thread_stats.docsStolen(scheduler.stolen_size(thread_id));
     if (softDoomed) {
         thread_stats.doomOvertime(overtime);
     }
@@ -288,6 +327,11 @@ MatchThread::findMatches(MatchTools &tools)
     HitCollector hits(matchParams.numDocs, matchParams.arraySize);
     trace->addEvent(4, "Start match and first phase rank");
     match_loop_helper(tools, hits);
+    if (trace->shouldTrace(7)) {
+        // iterator counters (e.g. documents pruned by bm25 pruning) are only known after matching
+        vespalib::slime::ObjectInserter inserter(trace->createCursor("iterator"), "matched");
+        tools.search().asSlime(inserter);
+    }
     if (tools.has_second_phase_rank()) {
         trace->addEvent(4, "Start second phase rerank");
         auto sorted_hit_seq = matchToolsFactory.should_diversify()
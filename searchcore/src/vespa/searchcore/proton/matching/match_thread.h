@@ -73,10 +73,14 @@ private:
 
     class Context {
     public:
+        // max number of documents ranked together when the first phase program can be run in batches
+        static constexpr size_t RANK_BATCH_SIZE = 64;
         Context(double rankDropLimit, MatchTools &tools, HitCollector &hits,
-                uint32_t num_threads) __attribute__((noinline));
+                uint32_t num_threads, bool batch_rank) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <RankDropLimitE use_rank_drop_limit>
+        void flushRankBatch();
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -84,8 +88,14 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <RankDropLimitE use_rank_drop_limit>
+        void addScore(uint32_t docId, double score);
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
+        RankProgram    &_rank_program;
+        bool            _batch_rank;
+        std::vector<uint32_t>          _batch_docids;
+        std::vector<search::feature_t> _batch_scores;
         double          _rankDropLimit;
         HitCollector   &_hits;
         const Doom     &_doom;
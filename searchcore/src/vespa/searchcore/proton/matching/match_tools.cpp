@@ -1,8 +1,10 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "match_tools.h"
+#include "bm25_pruning.h"
 #include "querynodes.h"
 #include "rangequerylocator.h"
+#include "seek_statistics.h"
 #include <vespa/searchcorespi/index/indexsearchable.h>
 #include <vespa/searchlib/attribute/attribute_blueprint_params.h>
 #include <vespa/searchlib/attribute/attribute_operation.h>
@@ -14,6 +16,7 @@
 #include <vespa/vespalib/data/slime/inject.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 #include <vespa/vespalib/util/issue.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 
 using search::queryeval::IDiversifier;
@@ -125,6 +128,11 @@ MatchTools::has_second_phase_rank() const {
     return !_rankSetup.getSecondPhaseRank().empty();
 }
 
+bool
+MatchTools::use_batch_rank() const {
+    return BatchRank::lookup(_queryEnv.getProperties(), _rankSetup.get_batch_rank());
+}
+
 void
 MatchTools::setup_first_phase(ExecutionProfiler *profiler)
 {
@@ -173,7 +181,10 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const Properties           & rankProperties,
                   const Properties           & featureOverrides,
                   vespalib::ThreadBundle     & thread_bundle,
-                  bool                         is_search)
+                  bool                         is_search,
+                  uint32_t                     bm25_pruning_hits,
+                  FilterCache                * filter_cache,
+                  SeekStatistics             * seek_statistics)
     : _queryLimiter(queryLimiter),
       _global_filter_params(extract_global_filter_params(rankSetup, rankProperties, metaStore.getNumActiveLids(), searchContext.getDocIdLimit())),
       _query(),
@@ -192,10 +203,18 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
     trace.addEvent(5, "Deserialize and build query tree");
     _valid = _query.buildTree(queryStack, location, viewResolver, indexEnv, true);
     if (_valid) {
+        if (filter_cache != nullptr) {
+            trace.addEvent(5, "Use filter cache");
+            _query.set_filter_cache(filter_cache);
+        }
         _query.extractTerms(_queryEnv.terms());
         _query.extractLocations(_queryEnv.locations());
         trace.addEvent(5, "Build query execution plan");
         _query.reserveHandles(_requestContext, searchContext, _mdl);
+        if (seek_statistics != nullptr) {
+            size_t num_terms = _query.apply_seek_statistics(*seek_statistics, indexEnv);
+            trace.addEvent(5, vespalib::make_string("Apply seek statistics to %zu query terms", num_terms));
+        }
         trace.addEvent(5, "Optimize query execution plan");
         _query.optimize();
         trace.addEvent(4, "Perform dictionary lookups and posting lists initialization");
@@ -206,7 +225,19 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                                         _global_filter_params.global_filter_upper_limit,
                                         thread_bundle, trace);
         }
+        if (is_search && (bm25_pruning_hits > 0) && Bm25Pruning::lookup(rankProperties, rankSetup.get_bm25_pruning())) {
+            trace.addEvent(5, "Setup bm25 pruning");
+            auto params = make_bm25_pruning_params(rankSetup.getFirstPhaseRank(), _queryEnv, bm25_pruning_hits);
+            if (!params || !_query.handle_bm25_pruning(std::move(params))) {
+                trace.addEvent(5, "Skip bm25 pruning (not possible for query)");
+            }
+        }
         _query.freeze();
+        if ((seek_statistics != nullptr) && seek_statistics->should_sample()) {
+            auto md = _mdl.createMatchData();
+            size_t num_terms = _query.sample_seek_statistics(*seek_statistics, *md, indexEnv);
+            trace.addEvent(5, vespalib::make_string("Sample seek statistics for %zu query terms", num_terms));
+        }
         trace.addEvent(5, "Prepare shared state for multi-threaded rank executors");
         _rankSetup.prepareSharedState(_queryEnv, _queryEnv.getObjectStore());
         _diversityParams = extractDiversityParams(_rankSetup, rankProperties);
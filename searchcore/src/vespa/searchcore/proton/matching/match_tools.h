@@ -71,6 +71,7 @@ public:
     QueryLimiter & getQueryLimiter() { return _queryLimiter; }
     MaybeMatchPhaseLimiter &match_limiter() { return _match_limiter; }
     bool has_second_phase_rank() const;
+    bool use_batch_rank() const;
     const MatchData &match_data() const { return *_match_data; }
     RankProgram &rank_program() { return *_rank_program; }
     SearchIterator &search() { return *_search; }
@@ -145,7 +146,10 @@ public:
                       const Properties &rankProperties,
                       const Properties &featureOverrides,
                       vespalib::ThreadBundle &thread_bundle,
-                      bool is_search);
+                      bool is_search,
+                      uint32_t bm25_pruning_hits,
+                      FilterCache *filter_cache,
+                      SeekStatistics *seek_statistics);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
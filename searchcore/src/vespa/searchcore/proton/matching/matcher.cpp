@@ -1,11 +1,13 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "matcher.h"
+#include "filter_cache.h"
 #include "isearchcontext.h"
 #include "match_master.h"
 #include "match_context.h"
 #include "match_tools.h"
 #include "match_params.h"
+#include "seek_statistics.h"
 #include "sessionmanager.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
@@ -102,7 +104,8 @@ handleGroupingSession(SessionManager &sessionMgr, GroupingContext & groupingCont
 }  // namespace proton::matching::<unnamed>
 
 Matcher::Matcher(const search::index::Schema &schema, Properties props, const vespalib::Clock &clock,
-                 QueryLimiter &queryLimiter, const IRankingAssetsRepo &rankingAssetsRepo, uint32_t distributionKey)
+                 QueryLimiter &queryLimiter, const IRankingAssetsRepo &rankingAssetsRepo, uint32_t distributionKey,
+                 std::shared_ptr<FilterCache> filter_cache)
   : _indexEnv(distributionKey, schema, std::move(props), rankingAssetsRepo),
     _blueprintFactory(),
     _rankSetup(),
@@ -112,7 +115,9 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const ve
     _startTime(my_clock::now()),
     _clock(clock),
     _queryLimiter(queryLimiter),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _filter_cache(),
+    _seek_statistics(std::make_unique<SeekStatistics>())
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -122,10 +127,19 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const ve
         throw vespalib::IllegalArgumentException(fmt("failed to compile rank setup :\n%s",
                                                      _rankSetup->getJoinedWarnings().c_str()), VESPA_STRLOC);
     }
+    if (_rankSetup->get_filter_cache_max_bytes() > 0) {
+        _filter_cache = std::move(filter_cache);
+    }
 }
 
 Matcher::~Matcher() = default;
 
+uint64_t
+Matcher::get_filter_cache_max_bytes() const
+{
+    return _rankSetup->get_filter_cache_max_bytes();
+}
+
 MatchingStats
 Matcher::getStats()
 {
@@ -142,7 +156,7 @@ std::unique_ptr<MatchToolsFactory>
 Matcher::create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                     IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
                                     const Properties &feature_overrides, vespalib::ThreadBundle &thread_bundle,
-                                    bool is_search) const
+                                    bool is_search, uint32_t bm25_pruning_hits) const
 {
     const Properties & rankProperties = request.propertiesMap.rankProperties();
     bool softTimeoutEnabled = Enabled::lookup(rankProperties, _rankSetup->getSoftTimeoutEnabled());
@@ -159,10 +173,16 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
                    _stats.softDoomFactor(), factor, hasFactorOverride, vespalib::count_ns(safeLeft));
     }
     vespalib::Doom doom(_clock, safeDoom, request.getTimeOfDoom(), hasFactorOverride);
+    bool use_filter_cache = is_search && _filter_cache &&
+                            (FilterCacheMaxBytes::lookup(rankProperties, _rankSetup->get_filter_cache_max_bytes()) > 0);
+    bool use_seek_statistics = is_search &&
+                               CostBasedOrdering::lookup(rankProperties, _rankSetup->get_cost_based_ordering());
     return std::make_unique<MatchToolsFactory>(_queryLimiter, doom, searchContext, attrContext,
                                                request.trace(), request.getStackRef(), request.location,
                                                _viewResolver, metaStore, _indexEnv, *_rankSetup,
-                                               rankProperties, feature_overrides, thread_bundle, is_search);
+                                               rankProperties, feature_overrides, thread_bundle, is_search,
+                                               bm25_pruning_hits, use_filter_cache ? _filter_cache.get() : nullptr,
+                                               use_seek_statistics ? _seek_statistics.get() : nullptr);
 }
 
 size_t
@@ -222,14 +242,6 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             feature_overrides = owned_objects.feature_overrides.get();
         }
 
-        MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext, metaStore,
-                                                               *feature_overrides, threadBundle, true);
-        isDoomExplicit = mtf->getRequestContext().getDoom().isExplicitSoftDoom();
-        traceQuery(6, request.trace(), mtf->query());
-        if (!mtf->valid()) {
-            return reply;
-        }
-
         const Properties & rankProperties = request.propertiesMap.rankProperties();
         uint32_t heapSize = HeapSize::lookup(rankProperties, _rankSetup->getHeapSize());
 
@@ -237,6 +249,20 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                            _rankSetup->getRankScoreDropLimit(), request.offset, request.maxhits,
                            !_rankSetup->getSecondPhaseRank().empty(), !willNotNeedRanking(request, groupingContext));
 
+        // pruned hits would be missing when sorting, grouping or matching docsums later in the session.
+        // All hits kept by the hit collector need their first phase score, not only the heap used for
+        // second phase ranking.
+        bool allow_bm25_pruning = request.sortSpec.empty() && request.groupSpec.empty() && !shouldCacheSearchSession;
+        uint32_t bm25_pruning_hits = allow_bm25_pruning ? params.arraySize : 0;
+        MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext, metaStore,
+                                                               *feature_overrides, threadBundle, true,
+                                                               bm25_pruning_hits);
+        isDoomExplicit = mtf->getRequestContext().getDoom().isExplicitSoftDoom();
+        traceQuery(6, request.trace(), mtf->query());
+        if (!mtf->valid()) {
+            return reply;
+        }
+
         ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId,
                            request.sortSpec, params.offset, params.hits);
 
@@ -244,8 +270,9 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
         uint32_t numParts = NumSearchPartitions::lookup(rankProperties, _rankSetup->getNumSearchPartitions());
+        uint32_t workStealingMinThreads = WorkStealingMinThreads::lookup(rankProperties, _rankSetup->getWorkStealingMinThreads());
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numParts);
+                                                          _distributionKey, numParts, workStealingMinThreads);
         my_stats = MatchMaster::getStats(std::move(master));
 
         bool wasLimited = mtf->match_limiter().was_limited();
@@ -374,7 +401,7 @@ Matcher::create_docsum_matcher(const DocsumRequest &req, ISearchContext &search_
     StupidMetaStore meta;
     MatchToolsFactory::UP mtf = create_match_tools_factory(req, search_ctx, attr_ctx, meta,
                                                            req.propertiesMap.featureOverrides(),
-                                                           vespalib::ThreadBundle::trivial(), false);
+                                                           vespalib::ThreadBundle::trivial(), false, 0);
     if (!mtf->valid()) {
         LOG(warning, "could not initialize docsum matching: %s",
             (expectedSessionCached) ? "session has expired" : "invalid query");
@@ -41,6 +41,8 @@ namespace proton::matching {
 class ISearchContext;
 class SessionManager;
 class MatchToolsFactory;
+class FilterCache;
+class SeekStatistics;
 
 /**
  * The Matcher is responsible for performing searches.
@@ -65,6 +67,8 @@ private:
     const vespalib::Clock        &_clock;
     QueryLimiter                 &_queryLimiter;
     uint32_t                      _distributionKey;
+    std::shared_ptr<FilterCache>  _filter_cache;
+    std::unique_ptr<SeekStatistics> _seek_statistics;
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const Properties & rankProperties) const;
@@ -83,13 +87,21 @@ public:
      * @param schema index schema
      * @param props ranking configuration
      * @param clock used for timeout handling
+     * @param filter_cache filter cache shared by all matchers of a
+     *                     document db, used if enabled by the rank profile
      **/
     Matcher(const search::index::Schema &schema, Properties props,
             const vespalib::Clock &clock, QueryLimiter &queryLimiter,
-            const IRankingAssetsRepo &rankingAssetsRepo, uint32_t distributionKey);
+            const IRankingAssetsRepo &rankingAssetsRepo, uint32_t distributionKey,
+            std::shared_ptr<FilterCache> filter_cache = {});
 
     const search::fef::IIndexEnvironment &get_index_env() const { return _indexEnv; }
 
+    /**
+     * @return the filter cache memory budget wanted by this rank profile, 0 if disabled
+     **/
+    uint64_t get_filter_cache_max_bytes() const;
+
     /**
      * Observe and reset stats for this object.
      *
@@ -99,13 +111,15 @@ public:
 
     /**
      * Create the low-level tools needed to perform matching. This
-     * function is exposed for testing purposes.
+     * function is exposed for testing purposes. bm25 pruning must
+     * keep the best 'bm25_pruning_hits' first phase scores; 0
+     * disables it.
      **/
     std::unique_ptr<MatchToolsFactory>
     create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
                                const Properties &feature_overrides, vespalib::ThreadBundle &thread_bundle,
-                               bool is_search) const;
+                               bool is_search, uint32_t bm25_pruning_hits) const;
 
     /**
      * Perform a search against this matcher.
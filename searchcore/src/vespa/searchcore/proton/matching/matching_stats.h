@@ -63,6 +63,8 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _rangesStolen;
+        size_t _docsStolen;
         Avg    _doomOvertime;
         Avg    _active_time;
         Avg    _wait_time;
@@ -74,6 +76,8 @@ public:
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _rangesStolen(0),
+              _docsStolen(0),
               _doomOvertime(),
               _active_time(),
               _wait_time() { }
@@ -88,6 +92,10 @@ public:
         size_t docsReRanked() const { return _docsReRanked; }
         Partition &softDoomed(bool v) { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const { return _softDoomed; }
+        Partition &rangesStolen(size_t value) { _rangesStolen = value; return *this; }
+        size_t rangesStolen() const { return _rangesStolen; }
+        Partition &docsStolen(size_t value) { _docsStolen = value; return *this; }
+        size_t docsStolen() const { return _docsStolen; }
         Partition & doomOvertime(vespalib::duration overtime) { _doomOvertime.set(vespalib::to_s(overtime)); return *this; }
         vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
@@ -108,6 +116,8 @@ public:
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _rangesStolen += rhs._rangesStolen;
+            _docsStolen += rhs._docsStolen;
             _doomOvertime.add(rhs._doomOvertime);
 
             _active_time.add(rhs._active_time);
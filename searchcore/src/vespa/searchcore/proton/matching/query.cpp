@@ -5,6 +5,7 @@
 #include "matchdatareservevisitor.h"
 #include "resolveviewvisitor.h"
 #include "sameelementmodifier.h"
+#include "seek_statistics.h"
 #include "termdataextractor.h"
 #include "unpacking_iterators_optimizer.h"
 #include <vespa/document/datatype/positiondatatype.h>
@@ -13,6 +14,7 @@
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/wand/bm25_pruning_or_search.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 
@@ -36,9 +38,11 @@ using search::query::Weight;
 using search::queryeval::AndBlueprint;
 using search::queryeval::AndNotBlueprint;
 using search::queryeval::Blueprint;
+using search::queryeval::Bm25PruningParams;
 using search::queryeval::GlobalFilter;
 using search::queryeval::IRequestContext;
 using search::queryeval::IntermediateBlueprint;
+using search::queryeval::OrBlueprint;
 using search::queryeval::RankBlueprint;
 using search::queryeval::SearchIterator;
 using vespalib::Issue;
@@ -218,7 +222,7 @@ Query::reserveHandles(const IRequestContext & requestContext, ISearchContext &co
     MatchDataReserveVisitor reserve_visitor(mdl);
     _query_tree->accept(reserve_visitor);
 
-    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context);
+    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context, _filter_cache);
     LOG(debug, "original blueprint:\n%s\n", _blueprint->asString().c_str());
     if (_whiteListBlueprint) {
         auto andBlueprint = std::make_unique<AndBlueprint>();
@@ -252,6 +256,18 @@ Query::fetchPostings()
     _blueprint->fetchPostings(search::queryeval::ExecuteInfo::create(true, 1.0));
 }
 
+size_t
+Query::apply_seek_statistics(const SeekStatistics &stats, const IIndexEnvironment &idxEnv)
+{
+    return stats.apply(*_blueprint, idxEnv);
+}
+
+size_t
+Query::sample_seek_statistics(SeekStatistics &stats, MatchData &md, const IIndexEnvironment &idxEnv) const
+{
+    return stats.sample(*_blueprint, md, idxEnv);
+}
+
 void
 Query::handle_global_filter(uint32_t docid_limit, double global_filter_lower_limit, double global_filter_upper_limit,
                             vespalib::ThreadBundle &thread_bundle, search::engine::Trace& trace)
@@ -307,6 +323,36 @@ Query::handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
     return true;
 }
 
+bool
+Query::handle_bm25_pruning(std::shared_ptr<const Bm25PruningParams> params)
+{
+    bool used = handle_bm25_pruning(*_blueprint, params);
+    LOG(debug, "bm25 pruning %s", used ? "enabled" : "not possible for query");
+    return used;
+}
+
+bool
+Query::handle_bm25_pruning(Blueprint &blueprint, const std::shared_ptr<const Bm25PruningParams> &params)
+{
+    if (auto * or_bp = dynamic_cast<OrBlueprint *>(&blueprint)) {
+        return or_bp->set_bm25_pruning(params);
+    }
+    auto * intermediate = dynamic_cast<IntermediateBlueprint *>(&blueprint);
+    if (intermediate == nullptr) {
+        return false;
+    }
+    if (blueprint.isAndNot() || blueprint.isRank()) {
+        return handle_bm25_pruning(intermediate->getChild(0), params);
+    }
+    bool used = false;
+    if (blueprint.isAnd() || blueprint.isSourceBlender()) {
+        for (size_t i = 0; i < intermediate->childCnt(); ++i) {
+            used = handle_bm25_pruning(intermediate->getChild(i), params) || used;
+        }
+    }
+    return used;
+}
+
 void
 Query::freeze()
 {
@@ -12,11 +12,14 @@
 
 namespace vespalib { struct ThreadBundle; }
 namespace search::engine { class Trace; }
+namespace search::queryeval { class Bm25PruningParams; }
 
 namespace proton::matching {
 
 class ViewResolver;
 class ISearchContext;
+class FilterCache;
+class SeekStatistics;
 
 class Query
 {
@@ -26,6 +29,7 @@ private:
     search::query::Node::UP _query_tree;
     Blueprint::UP           _blueprint;
     Blueprint::UP           _whiteListBlueprint;
+    FilterCache            *_filter_cache = nullptr;
     std::vector<search::common::GeoLocationSpec> _locations;
 
 public:
@@ -46,6 +50,12 @@ public:
      **/
     void setWhiteListBlueprint(Blueprint::UP whiteListBlueprint);
 
+    /**
+     * Use the given cache for cacheable filter subtrees when building
+     * the blueprint tree. Must be set before reserveHandles is called.
+     **/
+    void set_filter_cache(FilterCache *filter_cache) { _filter_cache = filter_cache; }
+
     /**
      * Build query tree from a stack dump.
      *
@@ -100,6 +110,23 @@ public:
     void optimize();
     void fetchPostings();
 
+    /**
+     * Give query terms below AND nodes a relative cost based on
+     * statistics from earlier queries. Must be called before optimize.
+     *
+     * @return the number of query terms given a cost
+     **/
+    size_t apply_seek_statistics(const SeekStatistics &stats, const search::fef::IIndexEnvironment &idxEnv);
+
+    /**
+     * Sample the seek cost of query terms below AND nodes. Must be
+     * called after fetchPostings.
+     *
+     * @return the number of query terms sampled
+     **/
+    size_t sample_seek_statistics(SeekStatistics &stats, search::fef::MatchData &md,
+                                  const search::fef::IIndexEnvironment &idxEnv) const;
+
     void handle_global_filter(uint32_t docid_limit, double global_filter_lower_limit, double global_filter_upper_limit,
                               vespalib::ThreadBundle &thread_bundle, search::engine::Trace& trace);
 
@@ -120,6 +147,16 @@ public:
                                      double global_filter_lower_limit, double global_filter_upper_limit,
                                      vespalib::ThreadBundle &thread_bundle, search::engine::Trace* trace);
 
+    /**
+     * Let the OR operators searching all the scored terms prune
+     * documents that cannot get a bm25 score among the best hits.
+     *
+     * @return true if any part of the blueprint tree uses the params
+     **/
+    bool handle_bm25_pruning(std::shared_ptr<const search::queryeval::Bm25PruningParams> params);
+    static bool handle_bm25_pruning(Blueprint &blueprint,
+                                    const std::shared_ptr<const search::queryeval::Bm25PruningParams> &params);
+
     void freeze();
 
     /**
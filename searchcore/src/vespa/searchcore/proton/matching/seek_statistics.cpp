@@ -0,0 +1,184 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "seek_statistics.h"
+#include <vespa/searchlib/fef/iindexenvironment.h>
+#include <vespa/searchlib/fef/fieldinfo.h>
+#include <vespa/searchlib/queryeval/blueprint.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+using search::queryeval::Blueprint;
+using search::queryeval::IntermediateBlueprint;
+using search::queryeval::LeafBlueprint;
+
+namespace proton::matching {
+
+namespace {
+
+template <typename BlueprintType, typename Func>
+void for_each_and_leaf(BlueprintType &blueprint, Func &&func) {
+    constexpr bool is_const = std::is_const_v<BlueprintType>;
+    using Intermediate = std::conditional_t<is_const, const IntermediateBlueprint, IntermediateBlueprint>;
+    using Leaf = std::conditional_t<is_const, const LeafBlueprint, LeafBlueprint>;
+    auto *intermediate = dynamic_cast<Intermediate *>(&blueprint);
+    if (intermediate == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < intermediate->childCnt(); ++i) {
+        auto &child = intermediate->getChild(i);
+        auto *leaf = dynamic_cast<Leaf *>(&child);
+        if (leaf == nullptr) {
+            for_each_and_leaf(child, func);
+        } else if (blueprint.isAnd()) {
+            func(*leaf);
+        }
+    }
+}
+
+bool is_eligible(const LeafBlueprint &leaf) {
+    const auto &state = leaf.getState();
+    return (state.isTermLike() &&
+            !state.estimate().empty &&
+            (state.estimate().estHits > 0) &&
+            (state.cost_tier() == Blueprint::State::COST_TIER_NORMAL) &&
+            !state.want_global_filter() &&
+            (leaf.get_docid_limit() > 1));
+}
+
+}
+
+SeekStatistics::SeekStatistics()
+    : _lock(),
+      _entries(),
+      _queries(0)
+{
+}
+
+SeekStatistics::~SeekStatistics() = default;
+
+void
+SeekStatistics::add(const vespalib::string &key, double ns_per_seek)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(key);
+    if (itr == _entries.end()) {
+        _entries.insert(std::make_pair(key, Entry(ns_per_seek)));
+        return;
+    }
+    Entry &entry = itr->second;
+    entry.ns_per_seek += WEIGHT * (ns_per_seek - entry.ns_per_seek);
+    ++entry.samples;
+}
+
+std::optional<SeekStatistics::Entry>
+SeekStatistics::lookup(const vespalib::string &key) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(key);
+    if (itr == _entries.end()) {
+        return std::nullopt;
+    }
+    return itr->second;
+}
+
+size_t
+SeekStatistics::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _entries.size();
+}
+
+bool
+SeekStatistics::should_sample()
+{
+    return ((_queries.fetch_add(1, std::memory_order_relaxed) % SAMPLE_INTERVAL) == 0);
+}
+
+vespalib::string
+SeekStatistics::make_key(const Blueprint &leaf, const search::fef::IIndexEnvironment &index_env)
+{
+    const auto &state = leaf.getState();
+    vespalib::asciistream os;
+    os << leaf.getClassName() << "(";
+    for (size_t i = 0; i < state.numFields(); ++i) {
+        uint32_t field_id = state.field(i).getFieldId();
+        const search::fef::FieldInfo *field = index_env.getField(field_id);
+        os << ((i > 0) ? "," : "");
+        if (field != nullptr) {
+            os << field->name();
+        } else {
+            os << field_id;
+        }
+    }
+    os << ")";
+    return os.str();
+}
+
+size_t
+SeekStatistics::apply(Blueprint &root, const search::fef::IIndexEnvironment &index_env) const
+{
+    std::vector<std::pair<LeafBlueprint *, Entry>> found;
+    for_each_and_leaf(root, [&](LeafBlueprint &leaf) {
+        if (is_eligible(leaf)) {
+            auto entry = lookup(make_key(leaf, index_env));
+            if (entry) {
+                found.emplace_back(&leaf, *entry);
+            }
+        }
+    });
+    if (found.empty()) {
+        return 0;
+    }
+    double sum_ns = 0.0;
+    for (const auto &item : found) {
+        sum_ns += item.second.ns_per_seek;
+    }
+    double avg_ns = sum_ns / found.size();
+    for (const auto &item : found) {
+        double seek_cost = (avg_ns > 0.0) ? (item.second.ns_per_seek / avg_ns) : 1.0;
+        item.first->set_cost(seek_cost);
+    }
+    return found.size();
+}
+
+size_t
+SeekStatistics::sample(const Blueprint &root, search::fef::MatchData &md,
+                       const search::fef::IIndexEnvironment &index_env)
+{
+    using clock = std::chrono::steady_clock;
+    std::vector<std::pair<uint64_t, const LeafBlueprint *>> candidates;
+    for_each_and_leaf(root, [&](const LeafBlueprint &leaf) {
+        if (is_eligible(leaf)) {
+            auto entry = lookup(make_key(leaf, index_env));
+            candidates.emplace_back(entry ? entry->samples : 0, &leaf);
+        }
+    });
+    if (candidates.size() > MAX_SAMPLED_LEAVES) {
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        candidates.resize(MAX_SAMPLED_LEAVES);
+    }
+    for (const auto &candidate : candidates) {
+        const LeafBlueprint &leaf = *candidate.second;
+        uint32_t docid_limit = leaf.get_docid_limit();
+        uint32_t step = std::max(1u, (docid_limit - 1) / NUM_PROBES);
+        auto search = leaf.createSearch(md, false);
+        search->initRange(1, docid_limit);
+        uint32_t seeks = 0;
+        auto start = clock::now();
+        for (uint32_t docid = 1; (docid < docid_limit) && (seeks < NUM_PROBES); docid += step) {
+            ++seeks;
+            search->seek(docid);
+        }
+        std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        add(make_key(leaf, index_env), elapsed.count() / seeks);
+    }
+    return candidates.size();
+}
+
+}
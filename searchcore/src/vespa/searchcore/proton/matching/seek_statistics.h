@@ -0,0 +1,86 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <mutex>
+#include <optional>
+
+namespace search::fef {
+class IIndexEnvironment;
+class MatchData;
+}
+namespace search::queryeval { class Blueprint; }
+
+namespace proton::matching {
+
+/**
+ * Statistics shared between queries about the cost of matching the
+ * leaf blueprints below AND nodes. Entries are keyed on blueprint
+ * type and searched fields, and track the time used per non-strict
+ * seek. Only the seek cost is pooled, as properties like the hit
+ * ratio are specific to each term. A bounded number of leaves of
+ * sampled queries are probed after postings are fetched. The
+ * collected statistics are used to give leaves of later queries a
+ * relative cost that is used to order AND children.
+ **/
+class SeekStatistics
+{
+public:
+    using Blueprint = search::queryeval::Blueprint;
+
+    struct Entry {
+        double   ns_per_seek;
+        uint64_t samples;
+        Entry(double ns_per_seek_in)
+            : ns_per_seek(ns_per_seek_in),
+              samples(1)
+        {}
+    };
+
+    static constexpr uint32_t SAMPLE_INTERVAL = 100;
+    static constexpr uint32_t NUM_PROBES = 64;
+    static constexpr uint32_t MAX_SAMPLED_LEAVES = 4;
+    static constexpr double   WEIGHT = 0.1;
+
+private:
+    mutable std::mutex                        _lock;
+    vespalib::hash_map<vespalib::string, Entry> _entries;
+    std::atomic<uint64_t>                     _queries;
+
+public:
+    SeekStatistics();
+    ~SeekStatistics();
+
+    void add(const vespalib::string &key, double ns_per_seek);
+    std::optional<Entry> lookup(const vespalib::string &key) const;
+    size_t size() const;
+
+    /**
+     * Returns true for every SAMPLE_INTERVAL'th query, starting with
+     * the first one.
+     **/
+    bool should_sample();
+
+    static vespalib::string make_key(const Blueprint &leaf, const search::fef::IIndexEnvironment &index_env);
+
+    /**
+     * Set the relative cost of AND children leaves that have
+     * statistics. Returns the number of leaves that were given a
+     * cost. Must be called before the blueprint is optimized.
+     **/
+    size_t apply(Blueprint &root, const search::fef::IIndexEnvironment &index_env) const;
+
+    /**
+     * Probe at most MAX_SAMPLED_LEAVES AND children leaves with
+     * NUM_PROBES non-strict seeks each to measure seek cost. Leaves
+     * with the fewest samples are probed first. Returns the number
+     * of leaves sampled. Must be called after postings are fetched.
+     **/
+    size_t sample(const Blueprint &root, search::fef::MatchData &md,
+                  const search::fef::IIndexEnvironment &index_env);
+};
+
+}
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "content_proton_metrics.h"
+#include <vespa/vespalib/stllike/cache_stats.h>
 
 namespace proton {
 
@@ -18,11 +19,34 @@ ContentProtonMetrics::ProtonExecutorMetrics::ProtonExecutorMetrics(metrics::Metr
 
 ContentProtonMetrics::ProtonExecutorMetrics::~ProtonExecutorMetrics() = default;
 
+ContentProtonMetrics::DocumentStoreChunkCacheMetrics::DocumentStoreChunkCacheMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("document_store_chunk_cache", {}, "Metrics for the cache of decompressed document store chunks shared among all document databases", parent),
+      memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
+      elements("elements", {}, "Number of elements in the cache", this),
+      hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
+      lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this)
+{
+}
+
+ContentProtonMetrics::DocumentStoreChunkCacheMetrics::~DocumentStoreChunkCacheMetrics() = default;
+
+void
+ContentProtonMetrics::DocumentStoreChunkCacheMetrics::update(const vespalib::CacheStats &current, const vespalib::CacheStats &last)
+{
+    memoryUsage.set(current.memory_used);
+    elements.set(current.elements);
+    if (current.lookups() >= last.lookups() && current.hits >= last.hits) {
+        hitRate.addTotalValueWithCount(current.hits - last.hits, current.lookups() - last.lookups());
+        lookups.inc(current.lookups() - last.lookups());
+    }
+}
+
 ContentProtonMetrics::ContentProtonMetrics()
     : metrics::MetricSet("content.proton", {}, "Search engine metrics", nullptr),
       transactionLog(this),
       resourceUsage(this),
-      executor(this)
+      executor(this),
+      documentStoreChunkCache(this)
 {
 }
 
@@ -5,6 +5,10 @@
 #include "executor_metrics.h"
 #include "resource_usage_metrics.h"
 #include "trans_log_server_metrics.h"
+#include <vespa/metrics/valuemetric.h>
+#include <vespa/metrics/countmetric.h>
+
+namespace vespalib { class CacheStats; }
 
 namespace proton {
 
@@ -32,9 +36,21 @@ struct ContentProtonMetrics : metrics::MetricSet
         ~ProtonExecutorMetrics();
     };
 
+    struct DocumentStoreChunkCacheMetrics : metrics::MetricSet {
+        metrics::LongValueMetric memoryUsage;
+        metrics::LongValueMetric elements;
+        metrics::LongAverageMetric hitRate;
+        metrics::LongCountMetric lookups;
+
+        DocumentStoreChunkCacheMetrics(metrics::MetricSet *parent);
+        ~DocumentStoreChunkCacheMetrics() override;
+        void update(const vespalib::CacheStats &current, const vespalib::CacheStats &last);
+    };
+
     TransLogServerMetrics transactionLog;
     ResourceUsageMetrics resourceUsage;
     ProtonExecutorMetrics executor;
+    DocumentStoreChunkCacheMetrics documentStoreChunkCache;
 
     ContentProtonMetrics();
     ~ContentProtonMetrics();
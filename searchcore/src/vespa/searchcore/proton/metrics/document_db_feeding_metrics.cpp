@@ -6,7 +6,11 @@ namespace proton {
 
 DocumentDBFeedingMetrics::DocumentDBFeedingMetrics(metrics::MetricSet* parent)
     : MetricSet("feeding", {}, "feeding metrics in a document database", parent),
-      commit(this)
+      commit(this),
+      in_memory_updates("in_memory_updates", {}, "Number of partial updates applied to attributes only, "
+                        "without a read-modify-write of the document in the document store", this),
+      document_store_updates("document_store_updates", {}, "Number of partial updates applied with a "
+                             "read-modify-write of the document in the document store", this)
 {
 }
 
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "document_db_commit_metrics.h"
+#include <vespa/metrics/countmetric.h>
 
 namespace proton {
 
@@ -11,6 +12,8 @@ namespace proton {
 struct DocumentDBFeedingMetrics : metrics::MetricSet
 {
     DocumentDBCommitMetrics commit;
+    metrics::LongCountMetric in_memory_updates;
+    metrics::LongCountMetric document_store_updates;
 
     DocumentDBFeedingMetrics(metrics::MetricSet* parent);
     ~DocumentDBFeedingMetrics() override;
@@ -104,12 +104,24 @@ DocumentDBTaggedMetrics::IndexMetrics::IndexMetrics(MetricSet *parent)
     : MetricSet("index", {}, "Index metrics (memory and disk) for this document db", parent),
       diskUsage("disk_usage", {}, "Disk space usage in bytes", this),
       memoryUsage(this),
-      docsInMemory("docs_in_memory", {}, "Number of documents in memory index", this)
+      docsInMemory("docs_in_memory", {}, "Number of documents in memory index", this),
+      memoryIndex(this)
 {
 }
 
 DocumentDBTaggedMetrics::IndexMetrics::~IndexMetrics() = default;
 
+DocumentDBTaggedMetrics::IndexMetrics::MemoryIndexMetrics::MemoryIndexMetrics(MetricSet *parent)
+    : MetricSet("memory_index", {}, "Feed latency metrics for the memory index", parent),
+      invertLatency("invert_latency", {}, "Average latency (sec) of a task inverting the fields of a document", this),
+      invertLatencyP99("invert_latency_p99", {}, "Upper bound of 99 percentile latency (sec) of invert tasks since last update", this),
+      pushLatency("push_latency", {}, "Average latency (sec) of a task pushing inverted fields for a batch of documents", this),
+      pushLatencyP99("push_latency_p99", {}, "Upper bound of 99 percentile latency (sec) of push tasks since last update", this)
+{
+}
+
+DocumentDBTaggedMetrics::IndexMetrics::MemoryIndexMetrics::~MemoryIndexMetrics() = default;
+
 void
 DocumentDBTaggedMetrics::MatchingMetrics::update(const MatchingStats &stats)
 {
@@ -231,6 +243,17 @@ DocumentDBTaggedMetrics::SessionCacheMetrics::SessionCacheMetrics(metrics::Metri
 
 DocumentDBTaggedMetrics::SessionCacheMetrics::~SessionCacheMetrics() = default;
 
+DocumentDBTaggedMetrics::FilterCacheMetrics::FilterCacheMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("filter_cache", {}, "Metrics for the query filter result cache shared by all rank profiles", parent),
+      memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
+      elements("elements", {}, "Number of elements in the cache", this),
+      hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
+      lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this)
+{
+}
+
+DocumentDBTaggedMetrics::FilterCacheMetrics::~FilterCacheMetrics() = default;
+
 DocumentDBTaggedMetrics::DocumentsMetrics::DocumentsMetrics(metrics::MetricSet *parent)
     : metrics::MetricSet("documents", {}, "Metrics for various document counts in this document db", parent),
       active("active", {}, "The number of active / searchable documents in this document db", this),
@@ -260,6 +283,7 @@ DocumentDBTaggedMetrics::DocumentDBTaggedMetrics(const vespalib::string &docType
       threadingService("threading_service", this),
       matching(this),
       sessionCache(this),
+      filterCache(this),
       documents(this),
       bucketMove(this),
       feeding(this),
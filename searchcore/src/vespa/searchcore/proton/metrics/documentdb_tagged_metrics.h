@@ -103,9 +103,20 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
 
     struct IndexMetrics : metrics::MetricSet
     {
+        struct MemoryIndexMetrics : metrics::MetricSet {
+            metrics::DoubleAverageMetric invertLatency;
+            metrics::DoubleValueMetric invertLatencyP99;
+            metrics::DoubleAverageMetric pushLatency;
+            metrics::DoubleValueMetric pushLatencyP99;
+
+            MemoryIndexMetrics(metrics::MetricSet *parent);
+            ~MemoryIndexMetrics() override;
+        };
+
         metrics::LongValueMetric diskUsage;
         MemoryUsageMetrics memoryUsage;
         metrics::LongValueMetric docsInMemory;
+        MemoryIndexMetrics memoryIndex;
 
         IndexMetrics(metrics::MetricSet *parent);
         ~IndexMetrics() override;
@@ -173,6 +184,14 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         ~SessionCacheMetrics() override;
     };
 
+    struct FilterCacheMetrics : metrics::MetricSet {
+        metrics::LongValueMetric memoryUsage;
+        metrics::LongValueMetric elements;
+        metrics::LongAverageMetric hitRate;
+        metrics::LongCountMetric lookups;
+        FilterCacheMetrics(metrics::MetricSet *parent);
+        ~FilterCacheMetrics() override;
+    };
     struct DocumentsMetrics : metrics::MetricSet {
         metrics::LongValueMetric active;
         metrics::LongValueMetric ready;
@@ -199,6 +218,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
     ExecutorThreadingServiceMetrics threadingService;
     MatchingMetrics matching;
     SessionCacheMetrics sessionCache;
+    FilterCacheMetrics filterCache;
     DocumentsMetrics documents;
     BucketMoveMetrics bucketMove;
     DocumentDBFeedingMetrics feeding;
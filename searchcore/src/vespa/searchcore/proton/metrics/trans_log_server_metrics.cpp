@@ -13,7 +13,12 @@ TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
             "Transaction log metrics for a document type", parent),
       entries("entries", {}, "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", {}, "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this),
+      syncs("syncs", {}, "The number of fsyncs of the transaction log", this),
+      syncBatchChunks("sync_batch_chunks", {}, "The number of commits made durable by one fsync", this),
+      syncBatchBytes("sync_batch_bytes", {}, "The number of bytes made durable by one fsync", this),
+      syncLatency("sync_latency", {}, "The recent average latency (in seconds) of one fsync", this),
+      lastSyncStats()
 {
 }
 
@@ -25,6 +30,15 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    const auto &syncStats = stats.syncStats;
+    uint64_t newSyncs = syncStats.syncs - lastSyncStats.syncs;
+    if (newSyncs > 0) {
+        syncs.inc(newSyncs);
+        syncBatchChunks.addValue(double(syncStats.chunks - lastSyncStats.chunks) / newSyncs);
+        syncBatchBytes.addValue(double(syncStats.bytes - lastSyncStats.bytes) / newSyncs);
+        syncLatency.set(vespalib::to_s(syncStats.latency));
+    }
+    lastSyncStats = syncStats;
 }
 
 void
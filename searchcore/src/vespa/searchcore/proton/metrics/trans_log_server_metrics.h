@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/metrics/countmetric.h>
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/searchlib/transactionlog/domainconfig.h>
@@ -19,6 +20,11 @@ public:
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        metrics::LongCountMetric syncs;
+        metrics::DoubleValueMetric syncBatchChunks;
+        metrics::DoubleValueMetric syncBatchBytes;
+        metrics::DoubleValueMetric syncLatency;
+        search::transactionlog::SyncStats lastSyncStats;
 
         typedef std::unique_ptr<DomainMetrics> UP;
         DomainMetrics(metrics::MetricSet *parent, const vespalib::string &documentType);
@@ -87,9 +87,11 @@ BootstrapConfigManager::update(const ConfigSnapshot & snapshot)
         tune._attr._write.setFromConfig<ProtonConfig::Attribute::Write>(conf.attribute.write.io);
         tune._index._search._read.setWantMemoryMap();
         tune._index._search._read.setFromMmapConfig<ProtonConfig::Search::Mmap>(conf.search.mmap);
+        tune._index._search._read.setWantAsyncRead(conf.search.asyncio);
         tune._summary._write.setFromConfig<ProtonConfig::Summary::Write>(conf.summary.write.io);
         tune._summary._seqRead.setFromConfig<ProtonConfig::Summary::Read>(conf.summary.read.io);
         tune._summary._randRead.setFromConfig<ProtonConfig::Summary::Read, ProtonConfig::Summary::Read::Mmap>(conf.summary.read.io, conf.summary.read.mmap);
+        tune._summary._randRead.setWantAsyncRead(conf.summary.read.asyncio);
 
         newProtonConfig = ProtonConfigSP(protonConfig.release());
         newTuneFileDocumentDB = tuneFileDocumentDB;
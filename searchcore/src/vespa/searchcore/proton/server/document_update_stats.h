@@ -0,0 +1,56 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace proton {
+
+/*
+ * Stats for partial updates handled by a feed view. Updates that only touch
+ * attributes which are updateable in memory are applied without reading,
+ * modifying and writing the document in the document store.
+ */
+struct DocumentUpdateStats
+{
+    uint64_t in_memory;
+    uint64_t document_store;
+
+    DocumentUpdateStats() noexcept
+        : in_memory(0),
+          document_store(0)
+    {
+    }
+    DocumentUpdateStats& operator+=(const DocumentUpdateStats& rhs) noexcept {
+        in_memory += rhs.in_memory;
+        document_store += rhs.document_store;
+        return *this;
+    }
+};
+
+/*
+ * Counters for partial updates, shared by the feed views of a document sub db.
+ * Updated by the master write thread and sampled by the metrics updater.
+ */
+class DocumentUpdateCounters
+{
+    std::atomic<uint64_t> _in_memory;
+    std::atomic<uint64_t> _document_store;
+public:
+    DocumentUpdateCounters() noexcept
+        : _in_memory(0),
+          _document_store(0)
+    {
+    }
+    void add_in_memory() noexcept { _in_memory.fetch_add(1, std::memory_order_relaxed); }
+    void add_document_store() noexcept { _document_store.fetch_add(1, std::memory_order_relaxed); }
+    DocumentUpdateStats get_stats() const noexcept {
+        DocumentUpdateStats stats;
+        stats.in_memory = _in_memory.load(std::memory_order_relaxed);
+        stats.document_store = _document_store.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
+}
@@ -25,6 +25,7 @@
 #include <vespa/searchcore/proton/feedoperation/noopoperation.h>
 #include <vespa/searchcore/proton/index/index_writer.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
+#include <vespa/searchcore/proton/matching/filter_cache.h>
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
 #include <vespa/searchcore/proton/metrics/metricswireservice.h>
 #include <vespa/searchcore/proton/persistenceengine/commit_and_wait_document_retriever.h>
@@ -75,7 +76,8 @@ constexpr uint32_t indexing_thread_stack_size = 128_Ki;
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed), size_t(cfg.cache.size)};
+    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed), size_t(cfg.cache.size),
+            uint32_t(std::max(cfg.fieldInverterShards, 1)), uint32_t(std::max(cfg.fusionWordPartitions, 1))};
 }
 
 ReplayThrottlingPolicy
@@ -204,8 +206,10 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _bucketHandler(_writeService.master()),
       _indexCfg(makeIndexConfig(protonCfg.index)),
       _replay_throttling_policy(std::make_unique<ReplayThrottlingPolicy>(make_replay_throttling_policy(protonCfg.replayThrottlingPolicy))),
+      _replay_concurrency(std::max(protonCfg.replayConcurrency, 1)),
       _config_store(std::move(config_store)),
       _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries)),
+      _filter_cache(std::make_shared<matching::FilterCache>(0)),
       _metricsWireService(metricsWireService),
       _metrics(_docTypeName.getName(), protonCfg.numthreadspersearch),
       _metricsHook(std::make_unique<MetricsUpdateHook>(*this)),
@@ -225,7 +229,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _maintenanceController(shared_service.transport(), _writeService.master(), shared_service.shared(), _refCount, _docTypeName),
       _jobTrackers(),
       _calc(),
-      _metricsUpdater(_subDBs, _writeService, _jobTrackers, *_sessionManager, _writeFilter, *_feedHandler)
+      _metricsUpdater(_subDBs, _writeService, _jobTrackers, *_sessionManager, *_filter_cache, _writeFilter, *_feedHandler)
 {
     assert(configSnapshot);
 
@@ -749,7 +753,8 @@ DocumentDB::startTransactionLogReplay()
                                       oldestFlushedSerial,
                                       newestFlushedSerial,
                                       *_config_store,
-                                      *_replay_throttling_policy);
+                                      *_replay_throttling_policy,
+                                      _replay_concurrency);
     _initGate.countDown();
 
     LOG(debug, "DocumentDB(%s): Database started.", _docTypeName.toString().c_str());
@@ -1109,6 +1114,18 @@ DocumentDB::getDistributionKey() const
     return _owner.getDistributionKey();
 }
 
+std::shared_ptr<search::docstore::ChunkCache>
+DocumentDB::getChunkCache() const
+{
+    return _owner.getChunkCache();
+}
+
+std::shared_ptr<matching::FilterCache>
+DocumentDB::getFilterCache() const
+{
+    return _filter_cache;
+}
+
 std::shared_ptr<const ITransientResourceUsageProvider>
 DocumentDB::transient_usage_provider()
 {
@@ -55,7 +55,10 @@ class ReplayThrottlingPolicy;
 class StatusReport;
 struct MetricsWireService;
 
-namespace matching { class SessionManager; }
+namespace matching {
+    class FilterCache;
+    class SessionManager;
+}
 
 struct ActiveDocs {
     ActiveDocs() noexcept : active(0), target_active(0) { }
@@ -117,8 +120,10 @@ private:
     BucketHandler                                    _bucketHandler;
     index::IndexConfig                               _indexCfg;
     std::unique_ptr<ReplayThrottlingPolicy>          _replay_throttling_policy;
+    uint32_t                                         _replay_concurrency;
     ConfigStore::UP                                  _config_store;
     std::shared_ptr<matching::SessionManager>        _sessionManager; // TODO: This should not have to be a shared pointer.
+    std::shared_ptr<matching::FilterCache>           _filter_cache;
     MetricsWireService                              &_metricsWireService;
     DocumentDBTaggedMetrics                          _metrics;
     std::unique_ptr<metrics::UpdateHook>             _metricsHook;
@@ -391,6 +396,8 @@ public:
     document::BucketSpace getBucketSpace() const override;
     vespalib::string getName() const override;
     uint32_t getDistributionKey() const override;
+    std::shared_ptr<search::docstore::ChunkCache> getChunkCache() const override;
+    std::shared_ptr<matching::FilterCache> getFilterCache() const override;
 
     /**
      * Implements IFeedHandlerOwner
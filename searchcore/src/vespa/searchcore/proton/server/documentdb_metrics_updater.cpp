@@ -11,6 +11,7 @@
 #include <vespa/searchcore/proton/attribute/attribute_usage_filter.h>
 #include <vespa/searchcore/proton/attribute/i_attribute_manager.h>
 #include <vespa/searchcore/proton/docsummary/isummarymanager.h>
+#include <vespa/searchcore/proton/matching/filter_cache.h>
 #include <vespa/searchcore/proton/matching/matching_stats.h>
 #include <vespa/searchcore/proton/matching/matching_stats.h>
 #include <vespa/searchcore/proton/metrics/documentdb_job_trackers.h>
@@ -24,6 +25,8 @@
 LOG_SETUP(".proton.server.documentdb_metrics_updater");
 
 using search::LidUsageStats;
+using search::memoryindex::FieldLatencyStats;
+using search::memoryindex::LatencyHistogram;
 using vespalib::CacheStats;
 using vespalib::MemoryUsage;
 
@@ -35,16 +38,21 @@ DocumentDBMetricsUpdater::DocumentDBMetricsUpdater(const DocumentSubDBCollection
                                                    ExecutorThreadingService &writeService,
                                                    DocumentDBJobTrackers &jobTrackers,
                                                    matching::SessionManager &sessionManager,
+                                                   const matching::FilterCache &filterCache,
                                                    const AttributeUsageFilter &writeFilter,
                                                    FeedHandler& feed_handler)
     : _subDBs(subDBs),
       _writeService(writeService),
       _jobTrackers(jobTrackers),
       _sessionManager(sessionManager),
+      _filterCache(filterCache),
       _writeFilter(writeFilter),
       _feed_handler(feed_handler),
       _lastDocStoreCacheStats(),
-      _last_feed_handler_stats()
+      _lastFilterCacheStats(),
+      _last_memory_index_latency(),
+      _last_feed_handler_stats(),
+      _last_update_stats()
 {
 }
 
@@ -73,12 +81,35 @@ updateDiskUsageMetric(metrics::LongValueMetric &metric, uint64_t diskUsage, Tota
 }
 
 void
-updateIndexMetrics(DocumentDBTaggedMetrics &metrics, const search::SearchableStats &stats, TotalStats &totalStats)
+updateLatencyMetrics(metrics::DoubleAverageMetric &latency, metrics::DoubleValueMetric &latencyP99,
+                     const LatencyHistogram::Snapshot &current, const LatencyHistogram::Snapshot &last)
+{
+    // Samples are lost when a flushed memory index is dropped, then only samples in the remaining ones are used
+    LatencyHistogram::Snapshot delta = current;
+    if (current.count >= last.count) {
+        delta.subtract(last);
+    }
+    if (delta.count > 0) {
+        latency.addTotalValueWithCount(vespalib::to_s(delta.total), delta.count);
+        latencyP99.set(vespalib::to_s(delta.quantile_limit(0.99)));
+    }
+}
+
+void
+updateIndexMetrics(DocumentDBTaggedMetrics &metrics, const search::SearchableStats &stats,
+                   FieldLatencyStats &lastMemoryIndexLatency, TotalStats &totalStats)
 {
     DocumentDBTaggedMetrics::IndexMetrics &indexMetrics = metrics.index;
     updateDiskUsageMetric(indexMetrics.diskUsage, stats.sizeOnDisk(), totalStats);
     updateMemoryUsageMetrics(indexMetrics.memoryUsage, stats.memoryUsage(), totalStats);
     indexMetrics.docsInMemory.set(stats.docsInMemory());
+    auto &memoryIndexMetrics = indexMetrics.memoryIndex;
+    const FieldLatencyStats &latency = stats.memory_index_latency();
+    updateLatencyMetrics(memoryIndexMetrics.invertLatency, memoryIndexMetrics.invertLatencyP99,
+                         latency.invert, lastMemoryIndexLatency.invert);
+    updateLatencyMetrics(memoryIndexMetrics.pushLatency, memoryIndexMetrics.pushLatencyP99,
+                         latency.push, lastMemoryIndexLatency.push);
+    lastMemoryIndexLatency = latency;
 }
 
 struct TempAttributeMetric
@@ -272,6 +303,19 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics &metrics, const DocumentSubDB
     updateDocumentStoreMetrics(metrics.notReady.documentStore, subDBs.getNotReadySubDB(), lastDocStoreCacheStats.notReadySubDb, totalStats);
 }
 
+void
+updateFilterCacheMetrics(DocumentDBTaggedMetrics::FilterCacheMetrics &metrics, const matching::FilterCache &filterCache,
+                         CacheStats &lastCacheStats, TotalStats &totalStats)
+{
+    CacheStats cacheStats = filterCache.get_stats();
+    totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
+    metrics.memoryUsage.set(cacheStats.memory_used);
+    metrics.elements.set(cacheStats.elements);
+    updateDocumentStoreCacheHitRate(cacheStats, lastCacheStats, metrics.hitRate);
+    updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.lookups);
+    lastCacheStats = cacheStats;
+}
+
 template <typename MetricSetType>
 void
 updateLidSpaceMetrics(MetricSetType &metrics, const search::IDocumentMetaStore &metaStore)
@@ -306,6 +350,16 @@ update_feeding_metrics(DocumentDBFeedingMetrics& metrics, FeedHandlerStats stats
     }
 }
 
+void
+update_update_metrics(DocumentDBFeedingMetrics& metrics, const DocumentSubDBCollection &subDbs, DocumentUpdateStats& last_stats)
+{
+    DocumentUpdateStats stats = subDbs.getReadySubDB()->get_update_stats();
+    stats += subDbs.getNotReadySubDB()->get_update_stats();
+    updateCountMetric(stats.in_memory, last_stats.in_memory, metrics.in_memory_updates);
+    updateCountMetric(stats.document_store, last_stats.document_store, metrics.document_store_updates);
+    last_stats = stats;
+}
+
 }
 
 void
@@ -313,17 +367,19 @@ DocumentDBMetricsUpdater::updateMetrics(const metrics::MetricLockGuard & guard,
 {
     TotalStats totalStats;
     ExecutorThreadingServiceStats threadingServiceStats = _writeService.getStats();
-    updateIndexMetrics(metrics, _subDBs.getReadySubDB()->getSearchableStats(), totalStats);
+    updateIndexMetrics(metrics, _subDBs.getReadySubDB()->getSearchableStats(), _last_memory_index_latency, totalStats);
     updateAttributeMetrics(metrics, _subDBs, totalStats);
     updateMatchingMetrics(guard, metrics, *_subDBs.getReadySubDB());
     updateSessionCacheMetrics(metrics, _sessionManager);
     updateDocumentsMetrics(metrics, _subDBs);
     updateDocumentStoreMetrics(metrics, _subDBs, _lastDocStoreCacheStats, totalStats);
+    updateFilterCacheMetrics(metrics.filterCache, _filterCache, _lastFilterCacheStats, totalStats);
     updateMiscMetrics(metrics, threadingServiceStats);
 
     metrics.totalMemoryUsage.update(totalStats.memoryUsage);
     metrics.totalDiskUsage.set(totalStats.diskUsage);
     update_feeding_metrics(metrics.feeding, _feed_handler.get_stats(true), _last_feed_handler_stats);
+    update_update_metrics(metrics.feeding, _subDBs, _last_update_stats);
 }
 
 void
@@ -1,14 +1,19 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "document_update_stats.h"
 #include "feed_handler_stats.h"
 #include <vespa/searchcore/proton/metrics/documentdb_tagged_metrics.h>
+#include <vespa/searchlib/memoryindex/field_latency_stats.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
 #include <optional>
 
 namespace proton {
 
-namespace matching { class SessionManager; }
+namespace matching {
+    class FilterCache;
+    class SessionManager;
+}
 
 class AttributeUsageFilter;
 class DDBState;
@@ -36,11 +41,15 @@ private:
     ExecutorThreadingService      &_writeService;
     DocumentDBJobTrackers         &_jobTrackers;
     matching::SessionManager      &_sessionManager;
+    const matching::FilterCache   &_filterCache;
     const AttributeUsageFilter    &_writeFilter;
     FeedHandler                   &_feed_handler;
     // Last updated document store cache statistics. Necessary due to metrics implementation is upside down.
     DocumentStoreCacheStats        _lastDocStoreCacheStats;
+    vespalib::CacheStats           _lastFilterCacheStats;
+    search::memoryindex::FieldLatencyStats _last_memory_index_latency;
     std::optional<FeedHandlerStats> _last_feed_handler_stats;
+    DocumentUpdateStats            _last_update_stats;
 
     void updateMiscMetrics(DocumentDBTaggedMetrics &metrics, const ExecutorThreadingServiceStats &threadingServiceStats);
     void updateAttributeResourceUsageMetrics(DocumentDBTaggedMetrics::AttributeMetrics &metrics);
@@ -50,6 +59,7 @@ public:
                              ExecutorThreadingService &writeService,
                              DocumentDBJobTrackers &jobTrackers,
                              matching::SessionManager &sessionManager,
+                             const matching::FilterCache &filterCache,
                              const AttributeUsageFilter &writeFilter,
                              FeedHandler& feed_handler);
     ~DocumentDBMetricsUpdater();
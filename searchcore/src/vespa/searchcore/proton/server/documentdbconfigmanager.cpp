@@ -191,6 +191,7 @@ deriveConfig(const ProtonConfig::Summary & summary, const HwInfo & hwInfo) {
             .setMaxNumLids(log.maxnumlids)
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compactCompression(deriveCompression(log.compact.compression))
+            .setCompressionDictionarySize(log.compact.dictionarysize)
             .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
     return {config, logConfig};
 }
@@ -237,7 +237,8 @@ FastAccessDocSubDB::initViews(const DocumentDBConfig &configSnapshot,
     // Called by executor thread
     (void) sessionManager;
     _iSearchView.set(std::make_shared<EmptySearchView>());
-    auto writer = std::make_shared<AttributeWriter>(getAndResetInitAttributeManager());
+    auto writer = std::make_shared<AttributeWriter>(getAndResetInitAttributeManager(),
+                                                   configSnapshot.get_threading_service_config().attribute_put_batch_size());
     {
         std::lock_guard<std::mutex> guard(_configMutex);
         initFeedView(std::move(writer), configSnapshot);
@@ -181,6 +181,8 @@ public:
      * @param flushedSummaryMgrSerial The flushed serial number of the
      *                                document store.
      * @param config_store            Reference to the config store.
+     * @param replay_concurrency      Number of threads deserializing
+     *                                replayed operations.
      */
 
     void
@@ -189,7 +191,8 @@ public:
                          SerialNum oldestFlushedSerial,
                          SerialNum newestFlushedSerial,
                          ConfigStore &config_store,
-                         const ReplayThrottlingPolicy& replay_throttling_policy);
+                         const ReplayThrottlingPolicy& replay_throttling_policy,
+                         uint32_t replay_concurrency);
 
     /**
      * Called when a flush is done and allows pruning of the transaction log.
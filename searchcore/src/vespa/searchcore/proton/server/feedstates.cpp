@@ -10,9 +10,12 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchcore/proton/common/replay_feed_token_factory.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 
 #include <vespa/log/log.h>
@@ -147,28 +150,109 @@ public:
     }
 };
 
+/**
+ * Deserializes a range of entries split into stripes. A stripe is claimed by
+ * the first thread to run, and the state outlives tasks that find no stripes left.
+ */
+struct DeserializeState {
+    using Entries = std::vector<Packet::Entry>;
+    using Operations = std::vector<std::unique_ptr<FeedOperation>>;
+    const Entries &entries;
+    size_t begin;
+    size_t end;
+    Operations &ops;
+    const document::DocumentTypeRepo &repo;
+    size_t num_stripes;
+    size_t stripe_size;
+    std::atomic<size_t> next_stripe;
+    vespalib::CountDownLatch latch;
+    std::vector<std::exception_ptr> errors;
+
+    DeserializeState(const Entries &entries_in, size_t begin_in, size_t end_in, Operations &ops_in,
+                     const document::DocumentTypeRepo &repo_in, size_t num_stripes_in)
+        : entries(entries_in),
+          begin(begin_in),
+          end(end_in),
+          ops(ops_in),
+          repo(repo_in),
+          num_stripes(num_stripes_in),
+          stripe_size((end_in - begin_in + num_stripes_in - 1) / num_stripes_in),
+          next_stripe(0),
+          latch(num_stripes_in),
+          errors(num_stripes_in)
+    {}
+    void run() {
+        for (size_t stripe = next_stripe++; stripe < num_stripes; stripe = next_stripe++) {
+            try {
+                size_t stripe_end = std::min(end, begin + (stripe + 1) * stripe_size);
+                for (size_t i = begin + stripe * stripe_size; i < stripe_end; ++i) {
+                    ops[i - begin] = ReplayPacketDispatcher::deserialize(entries[i], repo);
+                }
+            } catch (...) {
+                errors[stripe] = std::current_exception();
+            }
+            latch.countDown();
+        }
+    }
+};
+
 class PacketDispatcher {
 public:
-    PacketDispatcher(IReplayPacketHandler *packet_handler)
-        : _packet_handler(packet_handler)
+    PacketDispatcher(IReplayPacketHandler *packet_handler, Executor &deserialize_executor, uint32_t concurrency)
+        : _packet_handler(packet_handler),
+          _deserialize_executor(deserialize_executor),
+          _concurrency(std::max(concurrency, 1u))
     {}
 
     void handlePacket(PacketWrapper & wrap);
 private:
+    using Entries = DeserializeState::Entries;
+    using Operations = DeserializeState::Operations;
     void handleEntry(const Packet::Entry &entry);
+    void handleEntries(const Entries &entries, size_t begin, size_t end, TlsReplayProgress *progress);
+    void deserialize(const Entries &entries, size_t begin, size_t end, Operations &ops);
     IReplayPacketHandler *_packet_handler;
+    Executor             &_deserialize_executor;
+    uint32_t              _concurrency;
 };
 
 void
 PacketDispatcher::handlePacket(PacketWrapper & wrap)
 {
     vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
-    while ( !handle.empty() ) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        handleEntry(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+    if (_concurrency == 1) {
+        while ( !handle.empty() ) {
+            Packet::Entry entry;
+            entry.deserialize(handle);
+            handleEntry(entry);
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, entry.serial());
+            }
+        }
+    } else {
+        Entries entries;
+        while ( !handle.empty() ) {
+            entries.emplace_back();
+            entries.back().deserialize(handle);
+        }
+        // Entries that can not be deserialized concurrently split the packet in ranges that are
+        // deserialized concurrently, as they might change the repo used for deserialization.
+        size_t begin = 0;
+        while (begin < entries.size()) {
+            size_t end = begin;
+            while ((end < entries.size()) && ReplayPacketDispatcher::canDeserializeConcurrently(entries[end])) {
+                ++end;
+            }
+            if (end == begin) {
+                handleEntry(entries[begin]);
+                if (wrap.progress != nullptr) {
+                    handleProgress(*wrap.progress, entries[begin].serial());
+                }
+                ++end;
+            } else {
+                handleEntries(entries, begin, end, wrap.progress);
+            }
+            begin = end;
         }
     }
     wrap.result = RPC::OK;
@@ -187,6 +271,44 @@ PacketDispatcher::handleEntry(const Packet::Entry &entry) {
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
+void
+PacketDispatcher::handleEntries(const Entries &entries, size_t begin, size_t end, TlsReplayProgress *progress)
+{
+    Operations ops(end - begin);
+    deserialize(entries, begin, end, ops);
+    ReplayPacketDispatcher dispatcher(*_packet_handler);
+    for (const auto &op : ops) {
+        LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", op->getSerialNum(), op->getType());
+        _packet_handler->check_serial_num(op->getSerialNum());
+        dispatcher.replay(*op);
+        _packet_handler->optionalCommit(op->getSerialNum());
+        if (progress != nullptr) {
+            handleProgress(*progress, op->getSerialNum());
+        }
+    }
+}
+
+void
+PacketDispatcher::deserialize(const Entries &entries, size_t begin, size_t end, Operations &ops)
+{
+    auto state = std::make_shared<DeserializeState>(entries, begin, end, ops, _packet_handler->getDeserializeRepo(),
+                                                    std::min(size_t(_concurrency), end - begin));
+    for (size_t task = 1; task < state->num_stripes; ++task) {
+        auto rejected = _deserialize_executor.execute(makeLambdaTask([state]() { state->run(); }));
+        if (rejected) {
+            break;
+        }
+    }
+    // Stripes not yet picked up by the executor are handled here, so this never waits for queued tasks.
+    state->run();
+    state->latch.await();
+    for (const auto &error : state->errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
 }  // namespace
 
 ReplayTransactionLogState::ReplayTransactionLogState(
@@ -196,10 +318,14 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IReplayConfig &replay_config,
         FeedConfigStore &config_store,
         const ReplayThrottlingPolicy &replay_throttling_policy,
-        IIncSerialNum& inc_serial_num)
+        IIncSerialNum& inc_serial_num,
+        Executor &deserialize_executor,
+        uint32_t replay_concurrency)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num))
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num)),
+      _deserialize_executor(deserialize_executor),
+      _replay_concurrency(replay_concurrency)
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
@@ -207,7 +333,7 @@ ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
     executor.execute(makeLambdaTask([this, wrap = wrap] () {
-        PacketDispatcher dispatcher(_packet_handler.get());
+        PacketDispatcher dispatcher(_packet_handler.get(), _deserialize_executor, _replay_concurrency);
         dispatcher.handlePacket(*wrap);
     }));
 }
@@ -44,10 +44,14 @@ public:
 /**
  * The feed handler is replaying the transaction log.
  * Replayed messages from the transaction log are sent to the active feed view.
+ * The entries of a packet are deserialized by up to 'replay_concurrency' threads,
+ * using the deserialize executor, before they are replayed in serial number order.
  */
 class ReplayTransactionLogState : public FeedState {
     vespalib::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor &_deserialize_executor;
+    uint32_t _replay_concurrency;
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
@@ -56,7 +60,9 @@ public:
             IReplayConfig &replay_config,
             FeedConfigStore &config_store,
             const ReplayThrottlingPolicy &replay_throttling_policy,
-            IIncSerialNum &inc_serial_num);
+            IIncSerialNum &inc_serial_num,
+            vespalib::Executor &deserialize_executor,
+            uint32_t replay_concurrency);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
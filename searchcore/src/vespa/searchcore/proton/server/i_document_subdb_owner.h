@@ -5,6 +5,9 @@
 #include <vespa/document/bucket/bucketspace.h>
 #include <memory>
 
+namespace search::docstore { class ChunkCache; }
+namespace proton::matching { class FilterCache; }
+
 namespace proton {
 
 /**
@@ -18,6 +21,8 @@ public:
     virtual document::BucketSpace getBucketSpace() const = 0;
     virtual vespalib::string getName() const = 0;
     virtual uint32_t getDistributionKey() const = 0;
+    virtual std::shared_ptr<search::docstore::ChunkCache> getChunkCache() const = 0;
+    virtual std::shared_ptr<matching::FilterCache> getFilterCache() const = 0;
 };
 
 } // namespace proton
@@ -5,6 +5,8 @@
 #include <memory>
 #include <cstdint>
 
+namespace search::docstore { class ChunkCache; }
+
 namespace proton {
 
 class IDocumentDBReferenceRegistry;
@@ -17,6 +19,8 @@ public:
     virtual bool isInitializing() const = 0;
     virtual uint32_t getDistributionKey() const = 0;
     virtual std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const = 0;
+    // Cache of decompressed document store chunks shared by all document dbs, or empty if disabled.
+    virtual std::shared_ptr<search::docstore::ChunkCache> getChunkCache() const = 0;
 };
 
 } // namespace proton
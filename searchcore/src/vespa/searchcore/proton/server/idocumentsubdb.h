@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "document_update_stats.h"
 #include <vespa/searchcore/proton/matching/matching_stats.h>
 #include <vespa/searchcore/proton/reprocessing/i_reprocessing_task.h>
 #include <vespa/searchlib/common/serialnum.h>
@@ -115,6 +116,7 @@ public:
     virtual void pruneRemovedFields(SerialNum serialNum) = 0;
     virtual void setIndexSchema(const SchemaSP &schema, SerialNum serialNum) = 0;
     virtual search::SearchableStats getSearchableStats() const = 0;
+    virtual DocumentUpdateStats get_update_stats() const = 0;
     virtual std::unique_ptr<IDocumentRetriever> getDocumentRetriever() = 0;
 
     virtual matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const = 0;
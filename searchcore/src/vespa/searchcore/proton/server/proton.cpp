@@ -34,6 +34,7 @@
 #include <vespa/searchcore/proton/summaryengine/summaryengine.h>
 #include <vespa/searchlib/attribute/interlock.h>
 #include <vespa/searchlib/common/packets.h>
+#include <vespa/searchlib/docstore/chunkcache.h>
 #include <vespa/searchlib/transactionlog/trans_log_server_explorer.h>
 #include <vespa/searchlib/transactionlog/translogserverapp.h>
 #include <vespa/searchlib/util/fileheadertk.h>
@@ -121,6 +122,15 @@ diskMemUsageSamplerConfig(const ProtonConfig &proton, const HwInfo &hwInfo)
              hwInfo };
 }
 
+size_t
+deriveChunkCacheBytes(const ProtonConfig &proton, const HwInfo &hwInfo)
+{
+    const auto &cache = proton.summary.cache.decompressedChunks;
+    return (cache.maxbytes < 0)
+           ? (hwInfo.memory().sizeBytes()*std::min(INT64_C(50), -cache.maxbytes))/100l
+           : cache.maxbytes;
+}
+
 uint32_t
 computeRpcTransportThreads(const ProtonConfig & cfg, const HwInfo::Cpu &cpuInfo) {
     bool areSearchAndDocsumAsync = cfg.docsum.async && cfg.search.async;
@@ -264,6 +274,8 @@ Proton::Proton(FastOS_ThreadPool & threadPool, FNET_Transport & transport, const
       _initDocumentDbsInSequence(false),
       _has_shut_down_config_and_state_components(false),
       _documentDBReferenceRegistry(std::make_shared<DocumentDBReferenceRegistry>()),
+      _chunk_cache(),
+      _last_chunk_cache_stats(),
       _nodeUpLock(),
       _nodeUp()
 { }
@@ -293,6 +305,10 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
 
     setBucketCheckSumType(protonConfig);
     setFS4Compression(protonConfig);
+    size_t chunkCacheBytes = deriveChunkCacheBytes(protonConfig, hwInfo);
+    if (chunkCacheBytes > 0) {
+        _chunk_cache = std::make_shared<search::docstore::ChunkCache>(chunkCacheBytes);
+    }
     _diskMemUsageSampler = std::make_unique<DiskMemUsageSampler>(_transport, protonConfig.basedir,
                                                                  diskMemUsageSamplerConfig(protonConfig, hwInfo));
 
@@ -829,6 +845,11 @@ Proton::updateMetrics(const metrics::MetricLockGuard &)
             metrics.field_writer.update(_shared_service->field_writer().getStats());
         }
     }
+    if (_chunk_cache) {
+        vespalib::CacheStats stats = _chunk_cache->getStats();
+        _metricsEngine->root().documentStoreChunkCache.update(stats, _last_chunk_cache_stats);
+        _last_chunk_cache_stats = stats;
+    }
 }
 
 void
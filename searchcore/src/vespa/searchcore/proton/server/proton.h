@@ -24,6 +24,7 @@
 #include <vespa/vespalib/net/http/json_get_handler.h>
 #include <vespa/vespalib/net/http/json_handler_repo.h>
 #include <vespa/vespalib/net/http/state_explorer.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <mutex>
 #include <shared_mutex>
@@ -31,6 +32,7 @@
 namespace vespalib { class StateServer; }
 namespace search {
     namespace attribute { class Interlock; }
+    namespace docstore { class ChunkCache; }
     namespace transactionlog { class TransLogServerApp; }
 }
 namespace metrics {
@@ -123,6 +125,8 @@ private:
     bool                            _initDocumentDbsInSequence;
     bool                            _has_shut_down_config_and_state_components;
     std::shared_ptr<IDocumentDBReferenceRegistry> _documentDBReferenceRegistry;
+    std::shared_ptr<search::docstore::ChunkCache> _chunk_cache;
+    vespalib::CacheStats            _last_chunk_cache_stats;
     std::mutex                      _nodeUpLock;
     std::set<BucketSpace>           _nodeUp;   // bucketspaces where node is up
 
@@ -141,6 +145,7 @@ private:
     uint32_t getDistributionKey() const override { return _distributionKey; }
     BootstrapConfig::SP getActiveConfigSnapshot() const;
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override;
+    std::shared_ptr<search::docstore::ChunkCache> getChunkCache() const override { return _chunk_cache; }
     // Returns true if the node is up in _any_ bucket space
     bool updateNodeUp(BucketSpace bucketSpace, bool nodeUpInBucketSpace);
     void closeDocumentDBs(vespalib::ThreadStackExecutorBase & executor);
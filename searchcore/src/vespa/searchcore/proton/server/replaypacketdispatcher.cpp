@@ -9,16 +9,29 @@ using vespalib::IllegalStateException;
 
 namespace proton {
 
+namespace {
+
 template <typename OperationType>
+std::unique_ptr<FeedOperation>
+deserializeOperation(std::unique_ptr<OperationType> op, vespalib::nbostream &is,
+                     const search::transactionlog::Packet::Entry &entry, const document::DocumentTypeRepo &repo)
+{
+    op->deserialize(is, repo);
+    op->setSerialNum(entry.serial());
+    return op;
+}
+
 void
-ReplayPacketDispatcher::replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry)
+checkEmpty(const vespalib::nbostream &is, const search::transactionlog::Packet::Entry &entry)
 {
-    op.deserialize(is, _handler.getDeserializeRepo());
-    op.setSerialNum(entry.serial());
-    store(op);
-    _handler.replay(op);
+    if ( ! is.empty()) {
+        throw document::DeserializeException
+            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
+                         entry.type(), is.size()));
+    }
 }
 
+}
 
 ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
     : _handler(handler)
@@ -28,70 +41,118 @@ ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
 
 void
 ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
+{
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
+        op.deserialize(is, _handler.getDeserializeRepo());
+        _handler.replay(op);
+        checkEmpty(is, entry);
+    } else {
+        auto op = deserialize(entry, _handler.getDeserializeRepo());
+        replay(*op);
+    }
+}
+
+bool
+ReplayPacketDispatcher::canDeserializeConcurrently(const Packet::Entry &entry)
+{
+    // Deserializing a new config operation writes the config to the config store.
+    return (entry.type() != FeedOperation::NEW_CONFIG);
+}
+
+std::unique_ptr<FeedOperation>
+ReplayPacketDispatcher::deserialize(const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
 {
     vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+    std::unique_ptr<FeedOperation> op;
     switch (entry.type()) {
-    case FeedOperation::PUT: {
-        PutOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PUT:
+        op = deserializeOperation(std::make_unique<PutOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::REMOVE: {
-        RemoveOperationWithDocId op;
-        replay(op, is, entry);
+    case FeedOperation::REMOVE:
+        op = deserializeOperation(std::make_unique<RemoveOperationWithDocId>(), is, entry, repo);
         break;
-    } case FeedOperation::REMOVE_GID: {
-        RemoveOperationWithGid op;
-        replay(op, is, entry);
+    case FeedOperation::REMOVE_GID:
+        op = deserializeOperation(std::make_unique<RemoveOperationWithGid>(), is, entry, repo);
         break;
-    } case FeedOperation::UPDATE: {
-        UpdateOperation op(static_cast<FeedOperation::Type>(entry.type()));
-        replay(op, is, entry);
+    case FeedOperation::UPDATE:
+        op = deserializeOperation(std::make_unique<UpdateOperation>(static_cast<FeedOperation::Type>(entry.type())), is, entry, repo);
         break;
-    } case FeedOperation::NOOP: {
-        NoopOperation op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::NEW_CONFIG: {
-        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
-        op.deserialize(is, _handler.getDeserializeRepo());
-        _handler.replay(op);
+    case FeedOperation::NOOP:
+        op = deserializeOperation(std::make_unique<NoopOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::DELETE_BUCKET: {
-        DeleteBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::DELETE_BUCKET:
+        op = deserializeOperation(std::make_unique<DeleteBucketOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::SPLIT_BUCKET: {
-        SplitBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPLIT_BUCKET:
+        op = deserializeOperation(std::make_unique<SplitBucketOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::JOIN_BUCKETS: {
-        JoinBucketsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::JOIN_BUCKETS:
+        op = deserializeOperation(std::make_unique<JoinBucketsOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::PRUNE_REMOVED_DOCUMENTS: {
-        PruneRemovedDocumentsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        op = deserializeOperation(std::make_unique<PruneRemovedDocumentsOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::MOVE: {
-        MoveOperation op;
-        replay(op, is, entry);
+    case FeedOperation::MOVE:
+        op = deserializeOperation(std::make_unique<MoveOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::CREATE_BUCKET: {
-        CreateBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::CREATE_BUCKET:
+        op = deserializeOperation(std::make_unique<CreateBucketOperation>(), is, entry, repo);
         break;
-    } case FeedOperation::COMPACT_LID_SPACE: {
-        CompactLidSpaceOperation op;
-        replay(op, is, entry);
+    case FeedOperation::COMPACT_LID_SPACE:
+        op = deserializeOperation(std::make_unique<CompactLidSpaceOperation>(), is, entry, repo);
         break;
-    } default:
+    default:
         throw IllegalStateException
             (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
     }
-    if ( ! is.empty()) {
-        throw document::DeserializeException
-            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
-                         entry.type(), is.size()));
+    checkEmpty(is, entry);
+    return op;
+}
+
+void
+ReplayPacketDispatcher::replay(const FeedOperation &op)
+{
+    store(op);
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        _handler.replay(static_cast<const PutOperation &>(op));
+        break;
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        _handler.replay(static_cast<const RemoveOperation &>(op));
+        break;
+    case FeedOperation::UPDATE:
+        _handler.replay(static_cast<const UpdateOperation &>(op));
+        break;
+    case FeedOperation::NOOP:
+        _handler.replay(static_cast<const NoopOperation &>(op));
+        break;
+    case FeedOperation::DELETE_BUCKET:
+        _handler.replay(static_cast<const DeleteBucketOperation &>(op));
+        break;
+    case FeedOperation::SPLIT_BUCKET:
+        _handler.replay(static_cast<const SplitBucketOperation &>(op));
+        break;
+    case FeedOperation::JOIN_BUCKETS:
+        _handler.replay(static_cast<const JoinBucketsOperation &>(op));
+        break;
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        _handler.replay(static_cast<const PruneRemovedDocumentsOperation &>(op));
+        break;
+    case FeedOperation::MOVE:
+        _handler.replay(static_cast<const MoveOperation &>(op));
+        break;
+    case FeedOperation::CREATE_BUCKET:
+        _handler.replay(static_cast<const CreateBucketOperation &>(op));
+        break;
+    case FeedOperation::COMPACT_LID_SPACE:
+        _handler.replay(static_cast<const CompactLidSpaceOperation &>(op));
+        break;
+    default:
+        throw IllegalStateException
+            (make_string("Can not replay operation with type id '%u'", op.getType()));
     }
 }
 
@@ -4,6 +4,7 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
 
 namespace proton {
 
@@ -19,9 +20,6 @@ private:
     typedef search::transactionlog::Packet Packet;
     IReplayPacketHandler &_handler;
 
-    template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
-
 protected:
     virtual void store(const FeedOperation &op);
 
@@ -30,6 +28,21 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Returns true if the entry can be deserialized without side effects,
+     * and thus concurrently with the deserialization of other entries.
+     */
+    static bool canDeserializeConcurrently(const Packet::Entry &entry);
+    /**
+     * Deserializes an entry for which canDeserializeConcurrently() is true.
+     * Thread safe as long as the given repo is not changed.
+     */
+    static std::unique_ptr<FeedOperation> deserialize(const Packet::Entry &entry, const document::DocumentTypeRepo &repo);
+    /**
+     * Dispatches an operation returned by deserialize() to the handler.
+     */
+    void replay(const FeedOperation &op);
 };
 
 } // namespace proton
@@ -2,6 +2,7 @@
 
 #include "searchable_doc_subdb_configurer.h"
 #include "reconfig_params.h"
+#include <vespa/searchcore/proton/matching/filter_cache.h>
 #include <vespa/searchcore/proton/matching/matcher.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
@@ -92,7 +93,8 @@ SearchableDocSubDBConfigurer(const ISummaryManager::SP &summaryMgr,
                              matching::RankingAssetsRepo &rankingAssetsRepo,
                              const vespalib::Clock &clock,
                              const vespalib::string &subDbName,
-                             uint32_t distributionKey) :
+                             uint32_t distributionKey,
+                             std::shared_ptr<matching::FilterCache> filter_cache) :
     _summaryMgr(summaryMgr),
     _searchView(searchView),
     _feedView(feedView),
@@ -100,7 +102,8 @@ SearchableDocSubDBConfigurer(const ISummaryManager::SP &summaryMgr,
     _rankingAssetsRepo(rankingAssetsRepo),
     _clock(clock),
     _subDbName(subDbName),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _filter_cache(std::move(filter_cache))
 { }
 
 SearchableDocSubDBConfigurer::~SearchableDocSubDBConfigurer() = default;
@@ -110,6 +113,7 @@ SearchableDocSubDBConfigurer::createMatchers(const Schema::SP &schema,
                                              const RankProfilesConfig &cfg)
 {
     auto newMatchers = std::make_shared<Matchers>(_clock, _queryLimiter, _rankingAssetsRepo);
+    uint64_t filter_cache_max_bytes = 0;
     for (const auto &profile : cfg.rankprofile) {
         vespalib::string name = profile.name;
         search::fef::Properties properties;
@@ -118,9 +122,14 @@ SearchableDocSubDBConfigurer::createMatchers(const Schema::SP &schema,
         }
         // schema instance only used during call.
         auto profptr = std::make_shared<Matcher>(*schema, std::move(properties), _clock, _queryLimiter,
-                                                 _rankingAssetsRepo, _distributionKey);
+                                                 _rankingAssetsRepo, _distributionKey, _filter_cache);
+        filter_cache_max_bytes = std::max(filter_cache_max_bytes, profptr->get_filter_cache_max_bytes());
         newMatchers->add(name, std::move(profptr));
     }
+    if (_filter_cache) {
+        // The filter cache is shared by all rank profiles, use the largest budget asked for
+        _filter_cache->set_capacity_bytes(filter_cache_max_bytes);
+    }
     return newMatchers;
 }
 
@@ -202,13 +211,13 @@ SearchableDocSubDBConfigurer::reconfigure(const DocumentDBConfig &newConfig,
         attrMgr = newAttrMgr;
         shouldMatchViewChange = true;
 
-        auto newAttrWriter = std::make_shared<AttributeWriter>(newAttrMgr);
+        auto newAttrWriter = std::make_shared<AttributeWriter>(newAttrMgr, newConfig.get_threading_service_config().attribute_put_batch_size());
         attrWriter = newAttrWriter;
         shouldFeedViewChange = true;
         initializer = createAttributeReprocessingInitializer(newConfig, newAttrMgr, oldConfig, oldAttrMgr,
                                                              _subDbName, currentSerialNum);
     } else if (params.shouldAttributeWriterChange()) {
-        attrWriter = std::make_shared<AttributeWriter>(attrMgr);
+        attrWriter = std::make_shared<AttributeWriter>(attrMgr, newConfig.get_threading_service_config().attribute_put_batch_size());
         shouldFeedViewChange = true;
     }
 
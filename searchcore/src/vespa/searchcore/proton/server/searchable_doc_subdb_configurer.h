@@ -22,6 +22,7 @@
 #include <vespa/searchcore/proton/reference/i_document_db_reference_resolver.h>
 
 namespace proton::matching {
+    class FilterCache;
     class RankingExpressions;
     class OnnxModels;
 }
@@ -46,6 +47,7 @@ private:
     const vespalib::Clock       &_clock;
     vespalib::string             _subDbName;
     uint32_t                     _distributionKey;
+    std::shared_ptr<matching::FilterCache> _filter_cache;
 
     void reconfigureFeedView(IAttributeWriter::SP attrWriter,
                              search::index::Schema::SP schema,
@@ -71,7 +73,8 @@ public:
                                  matching::RankingAssetsRepo &rankingAssetsRepo,
                                  const vespalib::Clock &clock,
                                  const vespalib::string &subDbName,
-                                 uint32_t distributionKey);
+                                 uint32_t distributionKey,
+                                 std::shared_ptr<matching::FilterCache> filter_cache);
     ~SearchableDocSubDBConfigurer();
 
     Matchers::SP createMatchers(const search::index::Schema::SP &schema,
@@ -39,7 +39,8 @@ SearchableDocSubDB::SearchableDocSubDB(const Config &cfg, const Context &ctx)
       _constantValueCache(_tensorLoader),
       _rankingAssetsRepo(_constantValueCache),
       _configurer(_iSummaryMgr, _rSearchView, _rFeedView, ctx._queryLimiter, _rankingAssetsRepo, ctx._clock,
-                  getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey()),
+                  getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey(),
+                  ctx._fastUpdCtx._storeOnlyCtx._owner.getFilterCache()),
       _warmupExecutor(ctx._warmupExecutor),
       _realGidToLidChangeHandler(std::make_shared<GidToLidChangeHandler>()),
       _flushConfig()
@@ -208,7 +209,7 @@ SearchableDocSubDB::initViews(const DocumentDBConfig &configSnapshot, const Sess
                                               attrMgr),
                                       std::move(matchView)));
 
-    auto attrWriter = std::make_shared<AttributeWriter>(attrMgr);
+    auto attrWriter = std::make_shared<AttributeWriter>(attrMgr, configSnapshot.get_threading_service_config().attribute_put_batch_size());
     {
         std::lock_guard<std::mutex> guard(_configMutex);
         initFeedView(std::move(attrWriter), configSnapshot);
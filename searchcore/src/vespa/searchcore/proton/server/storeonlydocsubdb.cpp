@@ -114,6 +114,7 @@ StoreOnlyDocSubDB::StoreOnlyDocSubDB(const Config &cfg, const Context &ctx)
       _dmsFlushTarget(),
       _dmsShrinkTarget(),
       _pendingLidsForCommit(std::make_shared<PendingLidTracker>()),
+      _updateCounters(std::make_shared<DocumentUpdateCounters>()),
       _nodeRetired(false),
       _lastConfiguredCompactionStrategy(),
       _subDbId(cfg._subDbId),
@@ -231,9 +232,11 @@ createSummaryManagerInitializer(const search::LogDocumentStore::Config & storeCf
 {
     GrowStrategy grow = alloc_strategy.get_grow_strategy();
     vespalib::string baseDir(_baseDir + "/summary");
+    search::LogDocumentStore::Config config(storeCfg);
+    config.getLogConfig().setChunkCache(_owner.getChunkCache());
     return std::make_shared<SummaryManagerInitializer>
         (grow, baseDir, getSubDbName(), _writeService.shared(),
-         storeCfg, tuneFile, _fileHeaderContext, _tlSyncer, std::move(bucketizer), std::move(result));
+         config, tuneFile, _fileHeaderContext, _tlSyncer, std::move(bucketizer), std::move(result));
 }
 
 void
@@ -352,7 +355,7 @@ StoreOnlyDocSubDB::getFeedViewPersistentParams()
 {
     SerialNum flushedDMSSN(_flushedDocumentMetaStoreSerialNum);
     SerialNum flushedDSSN(_flushedDocumentStoreSerialNum);
-    return { flushedDMSSN, flushedDSSN, _docTypeName, _subDbId, _subDbType };
+    return { flushedDMSSN, flushedDSSN, _docTypeName, _subDbId, _subDbType, _updateCounters };
 }
 
 void
@@ -521,6 +524,12 @@ StoreOnlyDocSubDB::getSearchableStats() const
     return {};
 }
 
+DocumentUpdateStats
+StoreOnlyDocSubDB::get_update_stats() const
+{
+    return _updateCounters->get_stats();
+}
+
 IDocumentRetriever::UP
 StoreOnlyDocSubDB::getDocumentRetriever()
 {
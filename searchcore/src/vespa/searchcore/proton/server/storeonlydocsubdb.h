@@ -152,6 +152,7 @@ private:
     DocumentMetaStoreFlushTarget::SP           _dmsFlushTarget;
     std::shared_ptr<ShrinkLidSpaceFlushTarget> _dmsShrinkTarget;
     std::shared_ptr<PendingLidTrackerBase>     _pendingLidsForCommit;
+    std::shared_ptr<DocumentUpdateCounters>    _updateCounters;
     bool                                       _nodeRetired;
     vespalib::datastore::CompactionStrategy    _lastConfiguredCompactionStrategy;
 
@@ -228,6 +229,7 @@ public:
     void pruneRemovedFields(SerialNum serialNum) override;
     void setIndexSchema(const Schema::SP &schema, SerialNum serialNum) override;
     search::SearchableStats getSearchableStats() const override;
+    DocumentUpdateStats get_update_stats() const override;
     IDocumentRetriever::UP getDocumentRetriever() override;
     matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const override;
     void close() override;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "document_update_stats.h"
 #include "fileconfigmanager.h"
 #include "ifeedview.h"
 #include "isummaryadapter.h"
@@ -104,17 +105,28 @@ public:
         const DocTypeName      _docTypeName;
         const uint32_t         _subDbId;
         const SubDbType        _subDbType;
+        const std::shared_ptr<DocumentUpdateCounters> _updateCounters;
 
         PersistentParams(SerialNum flushedDocumentMetaStoreSerialNum,
                          SerialNum flushedDocumentStoreSerialNum,
                          const DocTypeName &docTypeName,
                          uint32_t subDbId,
-                         SubDbType subDbType)
+                         SubDbType subDbType,
+                         std::shared_ptr<DocumentUpdateCounters> updateCounters)
             : _flushedDocumentMetaStoreSerialNum(flushedDocumentMetaStoreSerialNum),
               _flushedDocumentStoreSerialNum(flushedDocumentStoreSerialNum),
               _docTypeName(docTypeName),
               _subDbId(subDbId),
-              _subDbType(subDbType)
+              _subDbType(subDbType),
+              _updateCounters(std::move(updateCounters))
+        {}
+        PersistentParams(SerialNum flushedDocumentMetaStoreSerialNum,
+                         SerialNum flushedDocumentStoreSerialNum,
+                         const DocTypeName &docTypeName,
+                         uint32_t subDbId,
+                         SubDbType subDbType)
+            : PersistentParams(flushedDocumentMetaStoreSerialNum, flushedDocumentStoreSerialNum,
+                               docTypeName, subDbId, subDbType, std::make_shared<DocumentUpdateCounters>())
         {}
     };
 
@@ -2,6 +2,7 @@
 
 #include "threading_service_config.h"
 #include <vespa/searchcore/config/config-proton.h>
+#include <algorithm>
 #include <cmath>
 
 namespace proton {
@@ -14,13 +15,15 @@ ThreadingServiceConfig::ThreadingServiceConfig(uint32_t master_task_limit_,
                                                int32_t defaultTaskLimit_,
                                                OptimizeFor optimize_,
                                                uint32_t kindOfWatermark_,
-                                               vespalib::duration reactionTime_)
+                                               vespalib::duration reactionTime_,
+                                               uint32_t attribute_put_batch_size_)
     : _master_task_limit(master_task_limit_),
       _defaultTaskLimit(std::abs(defaultTaskLimit_)),
       _is_task_limit_hard(defaultTaskLimit_ >= 0),
       _optimize(optimize_),
       _kindOfWatermark(kindOfWatermark_),
-      _reactionTime(reactionTime_)
+      _reactionTime(reactionTime_),
+      _attribute_put_batch_size(attribute_put_batch_size_)
 {
 }
 
@@ -46,12 +49,13 @@ ThreadingServiceConfig::make(const ProtonConfig& cfg)
                                   cfg.indexing.tasklimit,
                                   selectOptimization(cfg.indexing.optimize),
                                   cfg.indexing.kindOfWatermark,
-                                  vespalib::from_s(cfg.indexing.reactiontime));
+                                  vespalib::from_s(cfg.indexing.reactiontime),
+                                  std::max(cfg.feeding.attributePutBatchSize, 1));
 }
 
 ThreadingServiceConfig
 ThreadingServiceConfig::make() {
-    return ThreadingServiceConfig(0, 100, OptimizeFor::LATENCY, 0, 10ms);
+    return ThreadingServiceConfig(0, 100, OptimizeFor::LATENCY, 0, 10ms, 1);
 }
 
 void
@@ -69,7 +73,8 @@ ThreadingServiceConfig::operator==(const ThreadingServiceConfig &rhs) const
         _is_task_limit_hard == rhs._is_task_limit_hard &&
         _optimize == rhs._optimize &&
         _kindOfWatermark == rhs._kindOfWatermark &&
-        _reactionTime == rhs._reactionTime;
+        _reactionTime == rhs._reactionTime &&
+        _attribute_put_batch_size == rhs._attribute_put_batch_size;
 }
 
 }
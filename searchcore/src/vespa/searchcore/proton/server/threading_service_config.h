@@ -25,10 +25,12 @@ private:
     OptimizeFor        _optimize;
     uint32_t           _kindOfWatermark;
     vespalib::duration _reactionTime;         // Maximum reaction time to new tasks
+    uint32_t           _attribute_put_batch_size;
 
 private:
     ThreadingServiceConfig(uint32_t master_task_limit_, int32_t defaultTaskLimit_,
-                           OptimizeFor optimize_, uint32_t kindOfWatermark_, vespalib::duration reactionTime_);
+                           OptimizeFor optimize_, uint32_t kindOfWatermark_, vespalib::duration reactionTime_,
+                           uint32_t attribute_put_batch_size_);
 
 public:
     static ThreadingServiceConfig make(const ProtonConfig& cfg);
@@ -40,6 +42,7 @@ public:
     OptimizeFor optimize() const { return _optimize; }
     uint32_t kindOfwatermark() const { return _kindOfWatermark; }
     vespalib::duration reactionTime() const { return _reactionTime; }
+    uint32_t attribute_put_batch_size() const { return _attribute_put_batch_size; }
     bool operator==(const ThreadingServiceConfig &rhs) const;
 };
 
@@ -88,6 +88,7 @@ struct DummyDocumentSubDb : public IDocumentSubDB
     search::SearchableStats getSearchableStats() const override {
         return search::SearchableStats();
     }
+    DocumentUpdateStats get_update_stats() const override { return {}; }
     IDocumentRetriever::UP getDocumentRetriever() override {
         return IDocumentRetriever::UP();
     }
@@ -13,11 +13,13 @@ namespace searchcorespi {
 class FakeIndexSearchable : public IndexSearchable {
 private:
     search::queryeval::FakeSearchable _fake;
+    search::index::FieldLengthInfo    _field_length_info;
 
 public:
-    FakeIndexSearchable() : _fake() { }
+    FakeIndexSearchable() : _fake(), _field_length_info() { }
 
     search::queryeval::FakeSearchable &getFake() { return _fake; }
+    void set_field_length_info(const search::index::FieldLengthInfo &info) { _field_length_info = info; }
     
     /**
      * Implements IndexSearchable
@@ -41,7 +43,7 @@ public:
 
     search::index::FieldLengthInfo get_field_length_info(const vespalib::string& field_name) const override {
         (void) field_name;
-        return search::index::FieldLengthInfo();
+        return _field_length_info;
     }
 
 };
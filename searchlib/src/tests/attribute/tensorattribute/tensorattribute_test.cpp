@@ -1121,8 +1121,9 @@ TEST_F("NN blueprint handles strong filter (pre-filtering)", NearestNeighborBlue
     bp->set_global_filter(*strong_filter, 0.25);
     EXPECT_EQUAL(3u, bp->get_target_hits());
     EXPECT_EQUAL(3u, bp->get_adjusted_target_hits());
-    EXPECT_EQUAL(1u, bp->getState().estimate().estHits);
-    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_FILTER, bp->get_algorithm());
+    // Calculating the distance to the single filter hit is cheaper than searching the index
+    EXPECT_EQUAL(11u, bp->getState().estimate().estHits);
+    EXPECT_EQUAL(NNBA::EXACT_FALLBACK, bp->get_algorithm());
 }
 
 TEST_F("NN blueprint handles weak filter (pre-filtering)", NearestNeighborBlueprintFixture)
@@ -1140,8 +1141,24 @@ TEST_F("NN blueprint handles weak filter (pre-filtering)", NearestNeighborBluepr
     bp->set_global_filter(*weak_filter, 0.6);
     EXPECT_EQUAL(3u, bp->get_target_hits());
     EXPECT_EQUAL(3u, bp->get_adjusted_target_hits());
-    EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
-    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_FILTER, bp->get_algorithm());
+    // Exact search is cheaper than searching the index for such a small corpus
+    EXPECT_EQUAL(11u, bp->getState().estimate().estHits);
+    EXPECT_EQUAL(NNBA::EXACT_FALLBACK, bp->get_algorithm());
+}
+
+TEST("NN blueprint filter plan selects algorithm with lowest estimated cost")
+{
+    auto plan = [](uint32_t filter_hits, double lower_limit) {
+        return NearestNeighborBlueprint::plan_with_filter(1000000, filter_hits, 10, lower_limit, 0.95);
+    };
+    EXPECT_EQUAL(NNBA::EXACT_FALLBACK, plan(30000, 0.0).algorithm);
+    EXPECT_EQUAL(30000.0, plan(30000, 0.0).exact_cost);
+    EXPECT_GREATER(plan(30000, 0.0).index_cost, plan(30000, 0.0).exact_cost);
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_FILTER, plan(200000, 0.0).algorithm);
+    EXPECT_LESS(plan(200000, 0.0).index_cost, plan(200000, 0.0).exact_cost);
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K_WITH_POST_FILTER, plan(980000, 0.0).algorithm);
+    EXPECT_EQUAL(NNBA::EXACT_FALLBACK, plan(200000, 0.3).algorithm);
+    EXPECT_EQUAL(NNBA::EXACT_FALLBACK, plan(0, 0.0).algorithm);
 }
 
 TEST_F("NN blueprint handles strong filter triggering exact search", NearestNeighborBlueprintFixture)
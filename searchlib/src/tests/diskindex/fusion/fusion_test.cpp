@@ -4,6 +4,7 @@
 #include <vespa/searchlib/diskindex/diskindex.h>
 #include <vespa/searchlib/diskindex/fusion.h>
 #include <vespa/searchlib/diskindex/indexbuilder.h>
+#include <vespa/searchlib/diskindex/pagedict4file.h>
 #include <vespa/searchlib/diskindex/zcposoccrandread.h>
 #include <vespa/searchlib/fef/fieldpositionsiterator.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
@@ -64,6 +65,7 @@ class FusionTest : public ::testing::Test
 protected:
     Schema _schema;
     bool   _force_small_merge_chunk;
+    uint32_t _word_partitions;
     const Schema & getSchema() const { return _schema; }
 
     void requireThatFusionIsWorking(const vespalib::string &prefix, bool directio, bool readmmap, bool force_short_merge_chunk);
@@ -396,6 +398,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema, prefix + "dump3", sources, selector,
                       tuneFileIndexing,fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_word_partitions(_word_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -410,6 +413,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema2, prefix + "dump4", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_word_partitions(_word_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -424,6 +428,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema3, prefix + "dump5", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_word_partitions(_word_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -439,6 +444,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_dynamic_k_pos_index_format(true);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_word_partitions(_word_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -453,6 +459,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema, prefix + "dump3", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_word_partitions(_word_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -497,6 +504,7 @@ FusionTest::try_merge_simple_indexes(const vespalib::string &dump_dir, const std
     Fusion fusion(_schema, dump_dir, sources, selector,
                   tuneFileIndexing, fileHeaderContext);
     fusion.set_force_small_merge_chunk(_force_small_merge_chunk);
+    fusion.set_word_partitions(_word_partitions);
     return fusion.merge(executor, flush_token);
 }
 
@@ -509,7 +517,8 @@ FusionTest::merge_simple_indexes(const vespalib::string &dump_dir, const std::ve
 FusionTest::FusionTest()
     : ::testing::Test(),
       _schema(make_schema(false)),
-      _force_small_merge_chunk(false)
+      _force_small_merge_chunk(false),
+      _word_partitions(1)
 {
 }
 
@@ -538,6 +547,12 @@ TEST_F(FusionTest, require_that_small_merge_chunk_fusion_is_working)
     requireThatFusionIsWorking("s", false, false, true);
 }
 
+TEST_F(FusionTest, require_that_word_partitioned_fusion_is_working)
+{
+    _word_partitions = 3;
+    requireThatFusionIsWorking("p", false, false, true);
+}
+
 namespace {
 
 void clean_field_length_testdirs()
@@ -591,6 +606,57 @@ TEST_F(FusionTest, require_that_interleaved_features_can_be_reconstructed_with_s
 
 namespace {
 
+void clean_word_partition_testdirs()
+{
+    std::filesystem::remove_all(std::filesystem::path("wpdump2"));
+    std::filesystem::remove_all(std::filesystem::path("wpdump3"));
+    std::filesystem::remove_all(std::filesystem::path("wpdump4"));
+}
+
+std::vector<std::pair<vespalib::string, PostingListCounts>>
+read_dictionary(const vespalib::string &field_dir)
+{
+    std::vector<std::pair<vespalib::string, PostingListCounts>> result;
+    PageDict4FileSeqRead dict;
+    EXPECT_TRUE(dict.open(field_dir + "/dictionary", TuneFileSeqRead()));
+    vespalib::string word;
+    uint64_t word_num = 0;
+    PostingListCounts counts;
+    for (;;) {
+        dict.readWord(word, word_num, counts);
+        if (word_num == std::numeric_limits<uint64_t>::max()) {
+            break;
+        }
+        result.emplace_back(word, counts);
+    }
+    EXPECT_TRUE(dict.close());
+    return result;
+}
+
+}
+
+TEST_F(FusionTest, require_that_word_partitions_are_stitched_without_reencoding_posting_lists)
+{
+    clean_word_partition_testdirs();
+    _force_small_merge_chunk = true;
+    make_simple_index("wpdump2", MockFieldLengthInspector());
+    merge_simple_indexes("wpdump3", {"wpdump2"});
+    _word_partitions = 3;
+    merge_simple_indexes("wpdump4", {"wpdump2"});
+    for (const vespalib::string field : {"f0", "f1", "f2", "f3"}) {
+        SCOPED_TRACE(field);
+        auto expected = read_dictionary("wpdump3/" + field);
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(expected, read_dictionary("wpdump4/" + field));
+    }
+    DiskIndex disk_index("wpdump4");
+    ASSERT_TRUE(disk_index.setup(TuneFileSearch()));
+    assert_interleaved_features(disk_index, "f0", "a", 10, 1, 7);
+    clean_word_partition_testdirs();
+}
+
+namespace {
+
 void clean_stopped_fusion_testdirs()
 {
     std::filesystem::remove_all(std::filesystem::path("stopdump2"));
@@ -4,16 +4,22 @@
 
 #include <vespa/log/log.h>
 #include <vespa/searchlib/docstore/chunk.h>
+#include <vespa/searchlib/docstore/chunkcache.h>
 #include <vespa/searchlib/docstore/chunkformat.h>
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <zstd.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
+using search::docstore::ChunkCache;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -100,4 +106,94 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), zstd_compressed_length);
 }
 
+ZStdDictionary::SP
+make_dictionary() {
+    std::vector<vespalib::string> blobs;
+    for (size_t i(0); i < 1000; i++) {
+        blobs.push_back(vespalib::make_string("{\"title\":\"document number %zu\",\"category\":\"%s\",\"price\":%zu}",
+                                              i, ((i % 3) == 0) ? "books" : "music", i * 7));
+    }
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (const auto & blob : blobs) {
+        samples.emplace_back(blob.data(), blob.size());
+    }
+    return ZStdDictionary::train(samples, 4_Ki, 3);
+}
+
+TEST("require that V2 can use a zstd dictionary") {
+    auto dictionary = make_dictionary();
+    ASSERT_TRUE(dictionary);
+    vespalib::string blob("{\"title\":\"document number 1234\",\"category\":\"books\",\"price\":8638}");
+    ChunkFormatV2 chunk(10);
+    chunk.getBuffer().write(blob.data(), blob.size());
+    vespalib::DataBuffer buffer;
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD), dictionary.get());
+    EXPECT_LESS(buffer.getDataLen(), blob.size());
+    ChunkFormat::UP deserialized = ChunkFormat::deserialize(buffer.getData(), buffer.getDataLen(), false, dictionary.get());
+    EXPECT_EQUAL(blob, vespalib::string(deserialized->getBuffer().peek(), deserialized->getBuffer().size()));
+    EXPECT_EXCEPTION(ChunkFormat::deserialize(buffer.getData(), buffer.getDataLen(), false), ChunkException,
+                     "requires zstd dictionary");
+}
+
+std::shared_ptr<const Chunk>
+make_packed_chunk(uint32_t id, uint32_t lid, const vespalib::string &blob) {
+    Chunk chunk(id, Chunk::Config(1000));
+    chunk.append(lid, blob.data(), blob.size());
+    vespalib::DataBuffer buffer;
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::LZ4));
+    return std::make_shared<const Chunk>(id, buffer.getData(), buffer.getDataLen());
+}
+
+TEST("require that chunk cache serves decompressed chunks") {
+    ChunkCache cache(1_Mi);
+    ChunkCache::Key key(cache.registerOwner(), 1, 0);
+    EXPECT_FALSE(cache.find(key));
+    cache.insert(key, make_packed_chunk(0, 3, MY_LONG_STRING));
+    auto found = cache.find(key);
+    ASSERT_TRUE(found);
+    vespalib::ConstBufferRef blob = found->getLid(3);
+    EXPECT_EQUAL(vespalib::string(MY_LONG_STRING), vespalib::string(blob.c_str(), blob.size()));
+    vespalib::CacheStats stats = cache.getStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(1u, stats.misses);
+    EXPECT_EQUAL(1u, stats.elements);
+    EXPECT_EQUAL(found->getMemoryUsage().allocatedBytes(), stats.memory_used);
+}
+
+TEST("require that chunk cache keeps chunks from different owners apart") {
+    ChunkCache cache(1_Mi);
+    uint64_t owner1 = cache.registerOwner();
+    uint64_t owner2 = cache.registerOwner();
+    EXPECT_NOT_EQUAL(owner1, owner2);
+    cache.insert(ChunkCache::Key(owner1, 1, 0), make_packed_chunk(0, 1, "a"));
+    EXPECT_TRUE(cache.find(ChunkCache::Key(owner1, 1, 0)));
+    EXPECT_FALSE(cache.find(ChunkCache::Key(owner2, 1, 0)));
+    EXPECT_FALSE(cache.find(ChunkCache::Key(owner1, 2, 0)));
+    EXPECT_FALSE(cache.find(ChunkCache::Key(owner1, 1, 1)));
+}
+
+TEST("require that chunk cache evicts least recently used chunks when over budget") {
+    size_t bytes = make_packed_chunk(0, 1, "a")->getMemoryUsage().allocatedBytes();
+    ChunkCache cache(2 * bytes);
+    uint64_t owner = cache.registerOwner();
+    for (uint32_t id = 0; id < 3; ++id) {
+        cache.insert(ChunkCache::Key(owner, 1, id), make_packed_chunk(id, 1, "a"));
+    }
+    EXPECT_EQUAL(2 * bytes, cache.sizeBytes());
+    EXPECT_FALSE(cache.find(ChunkCache::Key(owner, 1, 0)));
+    EXPECT_TRUE(cache.find(ChunkCache::Key(owner, 1, 1)));
+    cache.insert(ChunkCache::Key(owner, 1, 3), make_packed_chunk(3, 1, "a"));
+    EXPECT_TRUE(cache.find(ChunkCache::Key(owner, 1, 1)));
+    EXPECT_FALSE(cache.find(ChunkCache::Key(owner, 1, 2)));
+    EXPECT_TRUE(cache.find(ChunkCache::Key(owner, 1, 3)));
+    EXPECT_EQUAL(2u, cache.getStats().elements);
+}
+
+TEST("require that chunk cache ignores chunks larger than the budget") {
+    ChunkCache cache(16);
+    cache.insert(ChunkCache::Key(cache.registerOwner(), 1, 0), make_packed_chunk(0, 1, "a"));
+    EXPECT_EQUAL(0u, cache.sizeBytes());
+    EXPECT_EQUAL(0u, cache.getStats().elements);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -9,6 +9,7 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <iomanip>
 #include <iostream>
 
@@ -21,6 +22,7 @@ using namespace search;
 using common::FileHeaderContext;
 using vespalib::CpuUsage;
 using vespalib::ThreadStackExecutor;
+using vespalib::compression::ZStdDictionary;
 
 struct MyFileHeaderContext : public FileHeaderContext {
     void addTags(vespalib::GenericHeader &header, const vespalib::string &name) const override {
@@ -121,7 +123,9 @@ struct WriteFixture : public FixtureBase {
 
     WriteFixture(const vespalib::string &baseName,
                  uint32_t docIdLimit,
-                 bool dirCleanup = true)
+                 bool dirCleanup = true,
+                 CompressionConfig compression = CompressionConfig(),
+                 ZStdDictionary::SP dictionary = {})
         : FixtureBase(baseName, dirCleanup),
           chunk(executor,
                 FileChunk::FileId(0),
@@ -129,11 +133,12 @@ struct WriteFixture : public FixtureBase {
                 baseName,
                 serialNum,
                 docIdLimit,
-                WriteableFileChunk::Config(CompressionConfig(), 0x1000),
+                WriteableFileChunk::Config(compression, 0x1000),
                 tuneFile,
                 fileHeaderCtx,
                 &bucketizer,
-                false)
+                false,
+                std::move(dictionary))
     {
         dir.cleanup(dirCleanup);
     }
@@ -241,6 +246,39 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
 
 using vespalib::compression::CompressionConfig;
 
+TEST("require that zstd dictionary is written to and read from dat file header")
+{
+    std::vector<vespalib::string> blobs;
+    for (uint32_t lid = 0; lid < 2000; ++lid) {
+        blobs.push_back(getData(lid));
+    }
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (const auto &blob : blobs) {
+        samples.emplace_back(blob.data(), blob.size());
+    }
+    auto dictionary = ZStdDictionary::train(samples, 1024, 3);
+    ASSERT_TRUE(dictionary);
+    {
+        WriteFixture f("tmp", 1000, false, CompressionConfig(CompressionConfig::ZSTD), dictionary);
+        EXPECT_EQUAL(dictionary->id(), f.chunk.getCompressionDictionary()->id());
+        f.append(1).append(2).append(3);
+        f.flush();
+    }
+    {
+        ReadFixture f("tmp", false);
+        f.chunk.enableRead();
+        f.updateLidMap(1000);
+        ASSERT_TRUE(f.chunk.getCompressionDictionary());
+        EXPECT_EQUAL(dictionary->id(), f.chunk.getCompressionDictionary()->id());
+        EXPECT_EQUAL(std::vector<vespalib::string>({getData(1), getData(2), getData(3)}), f.chunk.sampleBlobs(1000));
+    }
+    {
+        WriteFixture f("tmp", 1000, true, CompressionConfig(CompressionConfig::ZSTD));
+        ASSERT_TRUE(f.chunk.getCompressionDictionary());
+        EXPECT_EQUAL(dictionary->id(), f.chunk.getCompressionDictionary()->id());
+    }
+}
+
 TEST("require that operator == detects inequality") {
     using C = WriteableFileChunk::Config;
     EXPECT_TRUE(C() == C());
@@ -6,6 +6,7 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/searchlib/docstore/chunkcache.h>
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/searchlib/docstore/logdocumentstore.h>
 #include <vespa/searchlib/docstore/storebybucket.h>
@@ -18,9 +19,11 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/memory.h>
 #include <filesystem>
 #include <iomanip>
+#include <map>
 
 using document::BucketId;
 using document::StringFieldValue;
@@ -740,6 +743,80 @@ TEST("testWriteRead") {
     std::filesystem::remove_all(std::filesystem::path("empty"));
 }
 
+TEST("require that stores can share a cache of decompressed chunks") {
+    const char * blob = "cccccccccccccccccccccccc";
+    auto cache = std::make_shared<ChunkCache>(1_Mi);
+    LogDataStore::Config config;
+    config.setChunkCache(cache);
+    DirectoryHandler dir1("chunkcache1");
+    DirectoryHandler dir2("chunkcache2");
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1, 128_Ki);
+    MyTlSyncer tlSyncer;
+    for (const char * dir : {"chunkcache1", "chunkcache2"}) {
+        LogDataStore datastore(executor, dir, config, GrowStrategy(), TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        for (uint32_t lid = 0; lid < 10; ++lid) {
+            datastore.write(lid + 1, lid, blob, strlen(blob) - (lid % 2));
+        }
+        datastore.flush(datastore.initFlush(10));
+    }
+    LogDataStore store1(executor, "chunkcache1", config, GrowStrategy(), TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+    LogDataStore store2(executor, "chunkcache2", config, GrowStrategy(), TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+    for (uint32_t lid = 0; lid < 10; ++lid) {
+        fetchAndTest(store1, lid, blob, strlen(blob) - (lid % 2));
+    }
+    CacheStats afterFirst = cache->getStats();
+    EXPECT_LESS(0u, afterFirst.elements);
+    EXPECT_EQUAL(afterFirst.elements, afterFirst.misses);
+    for (uint32_t lid = 0; lid < 10; ++lid) {
+        fetchAndTest(store1, lid, blob, strlen(blob) - (lid % 2));
+        fetchAndTest(store2, lid, blob, strlen(blob) - (lid % 2));
+    }
+    CacheStats afterSecond = cache->getStats();
+    EXPECT_EQUAL(2 * afterFirst.elements, afterSecond.elements);
+    EXPECT_EQUAL(2 * afterFirst.misses, afterSecond.misses);
+    EXPECT_EQUAL(2 * afterFirst.hits + 10, afterSecond.hits);
+    EXPECT_EQUAL(cache->sizeBytes(), afterSecond.memory_used);
+}
+
+class CollectBlobs : public IBufferVisitor {
+public:
+    std::map<uint32_t, vespalib::string> blobs;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        blobs[lid] = vespalib::string(buffer.c_str(), buffer.size());
+    }
+};
+
+TEST("require that multi chunk reads give the same result with async io") {
+    DirectoryHandler dir("asyncio");
+    LogDataStore::Config config;
+    config.setFileConfig({{CompressionConfig::LZ4, 9, 60}, 1000});
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1, 128_Ki);
+    MyTlSyncer tlSyncer;
+    IDataStore::LidVector lids;
+    {
+        LogDataStore datastore(executor, "asyncio", config, GrowStrategy(), TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        for (uint32_t lid = 0; lid < 500; ++lid) {
+            vespalib::string blob = vespalib::make_string("blob-%u-", lid) + vespalib::string(lid % 100, 'x');
+            datastore.write(lid + 1, lid, blob.data(), blob.size());
+            if ((lid % 3) != 0) {
+                lids.push_back(lid);
+            }
+        }
+        datastore.flush(datastore.initFlush(500));
+    }
+    TuneFileSummary asyncTune;
+    asyncTune._randRead.setWantAsyncRead(true);
+    CollectBlobs normal;
+    CollectBlobs async;
+    LogDataStore(executor, "asyncio", config, GrowStrategy(), TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr).read(lids, normal);
+    LogDataStore(executor, "asyncio", config, GrowStrategy(), asyncTune, fileHeaderContext, tlSyncer, nullptr).read(lids, async);
+    EXPECT_EQUAL(lids.size(), normal.blobs.size());
+    EXPECT_TRUE(normal.blobs == async.blobs);
+    EXPECT_EQUAL("blob-499-" + vespalib::string(99, 'x'), async.blobs[499]);
+}
+
 TEST("requireThatSyncTokenIsUpdatedAfterFlush") {
 #if 0
     std::string file = "sync.dat";
@@ -1060,6 +1137,8 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setChunkCache(std::make_shared<ChunkCache>(1_Mi)));
+    EXPECT_FALSE(C() == C().setCompressionDictionarySize(4_Ki));
 }
 
 TEST_MAIN() {
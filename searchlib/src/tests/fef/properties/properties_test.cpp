@@ -286,6 +286,41 @@ TEST("test stuff") {
             p.add("vespa.matching.termwise_limit", "0.05");
             EXPECT_EQUAL(matching::TermwiseLimit::lookup(p), 0.05);
         }
+        { // vespa.matching.bm25_pruning
+            EXPECT_EQUAL(matching::Bm25Pruning::NAME, vespalib::string("vespa.matching.bm25_pruning"));
+            EXPECT_EQUAL(matching::Bm25Pruning::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_FALSE(matching::Bm25Pruning::lookup(p));
+            EXPECT_TRUE(matching::Bm25Pruning::lookup(p, true));
+            p.add("vespa.matching.bm25_pruning", "true");
+            EXPECT_TRUE(matching::Bm25Pruning::lookup(p));
+        }
+        { // vespa.matching.filter_cache.max_bytes
+            EXPECT_EQUAL(matching::FilterCacheMaxBytes::NAME, vespalib::string("vespa.matching.filter_cache.max_bytes"));
+            EXPECT_EQUAL(matching::FilterCacheMaxBytes::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::FilterCacheMaxBytes::lookup(p), 0u);
+            p.add("vespa.matching.filter_cache.max_bytes", "10000000000");
+            EXPECT_EQUAL(matching::FilterCacheMaxBytes::lookup(p), 10000000000u);
+        }
+        { // vespa.matching.cost_based_ordering
+            EXPECT_EQUAL(matching::CostBasedOrdering::NAME, vespalib::string("vespa.matching.cost_based_ordering"));
+            EXPECT_EQUAL(matching::CostBasedOrdering::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_FALSE(matching::CostBasedOrdering::lookup(p));
+            EXPECT_TRUE(matching::CostBasedOrdering::lookup(p, true));
+            p.add("vespa.matching.cost_based_ordering", "true");
+            EXPECT_TRUE(matching::CostBasedOrdering::lookup(p));
+        }
+        { // vespa.matching.batch_rank
+            EXPECT_EQUAL(matching::BatchRank::NAME, vespalib::string("vespa.matching.batch_rank"));
+            EXPECT_EQUAL(matching::BatchRank::DEFAULT_VALUE, true);
+            Properties p;
+            EXPECT_TRUE(matching::BatchRank::lookup(p));
+            EXPECT_FALSE(matching::BatchRank::lookup(p, false));
+            p.add("vespa.matching.batch_rank", "false");
+            EXPECT_FALSE(matching::BatchRank::lookup(p));
+        }
         { // vespa.matching.numthreads
             EXPECT_EQUAL(matching::NumThreadsPerSearch::NAME, vespalib::string("vespa.matching.numthreadspersearch"));
             EXPECT_EQUAL(matching::NumThreadsPerSearch::DEFAULT_VALUE, std::numeric_limits<uint32_t>::max());
@@ -311,6 +346,14 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        {
+            EXPECT_EQUAL(matching::WorkStealingMinThreads::NAME, vespalib::string("vespa.matching.work_stealing_min_threads"));
+            EXPECT_EQUAL(matching::WorkStealingMinThreads::DEFAULT_VALUE, 16u);
+            Properties p;
+            EXPECT_EQUAL(matching::WorkStealingMinThreads::lookup(p), 16u);
+            p.add("vespa.matching.work_stealing_min_threads", "0");
+            EXPECT_EQUAL(matching::WorkStealingMinThreads::lookup(p), 0u);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
@@ -395,6 +395,53 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+TEST_F("require that compiled ranking expressions can be executed in batches", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+value(10)").compile();
+    ASSERT_TRUE(f1.program.prepare_batch(4));
+    std::vector<uint32_t> docids = {3, 5, 7};
+    std::vector<feature_t> scores(docids.size());
+    f1.program.execute_batch(docids, scores);
+    EXPECT_EQUAL(16.0, scores[0]);
+    EXPECT_EQUAL(20.0, scores[1]);
+    EXPECT_EQUAL(24.0, scores[2]);
+    EXPECT_EQUAL(f1.get(5), 20.0);
+}
+
+TEST_F("require that const programs can be executed in batches", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "value(7)").compile();
+    ASSERT_TRUE(f1.program.prepare_batch(2));
+    std::vector<uint32_t> docids = {1, 2};
+    std::vector<feature_t> scores(docids.size());
+    f1.program.execute_batch(docids, scores);
+    EXPECT_EQUAL(7.0, scores[0]);
+    EXPECT_EQUAL(7.0, scores[1]);
+}
+
+TEST_F("require that executors without own batch execution are executed one document at a time", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid+ivalue(5)").compile();
+    ASSERT_TRUE(f1.program.prepare_batch(4));
+    std::vector<uint32_t> docids = {3, 5};
+    std::vector<feature_t> scores(docids.size());
+    f1.program.execute_batch(docids, scores);
+    EXPECT_EQUAL(8.0, scores[0]);
+    EXPECT_EQUAL(10.0, scores[1]);
+}
+
+TEST_F("require that programs with executors not supporting batch cannot be executed in batches", Fixture()) {
+    f1.add("mysum(value(10),docid)").compile();
+    EXPECT_FALSE(f1.program.prepare_batch(4));
+}
+
+TEST_F("require that programs with executors not reading batched inputs cannot be executed in batches", Fixture()) {
+    f1.add("track(docid)").compile();
+    EXPECT_FALSE(f1.program.prepare_batch(4));
+}
+
+TEST_F("require that programs with multiple seeds cannot be executed in batches", Fixture()) {
+    f1.add("docid").add("value(1)").compile();
+    EXPECT_FALSE(f1.program.prepare_batch(4));
+}
+
 TEST_F("require that rank program can be profiled", Fixture()) {
     ExecutionProfiler profiler(64);
     f1.add("mysum(value(10),ivalue(5))").compile(&profiler);
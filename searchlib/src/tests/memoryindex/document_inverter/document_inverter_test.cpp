@@ -117,16 +117,21 @@ struct DocumentInverterTest : public ::testing::Test {
     }
 
     DocumentInverterTest()
+        : DocumentInverterTest(1, 1)
+    {
+    }
+
+    DocumentInverterTest(uint32_t invert_threads, uint32_t field_shards)
         : _schema(makeSchema()),
           _b(_schema),
-          _invertThreads(SequencedTaskExecutor::create(invert_executor, 1)),
+          _invertThreads(SequencedTaskExecutor::create(invert_executor, invert_threads)),
           _pushThreads(SequencedTaskExecutor::create(push_executor, 1)),
           _word_store(),
           _remover(_word_store),
           _inserter_backend(),
           _calculator(),
           _fic(_remover, _inserter_backend, _calculator),
-          _inv_context(_schema, *_invertThreads, *_pushThreads, _fic),
+          _inv_context(_schema, *_invertThreads, *_pushThreads, _fic, field_shards),
           _inv(_inv_context)
     {
     }
@@ -281,6 +286,83 @@ TEST_F(DocumentInverterTest, require_that_empty_document_can_be_inverted)
               _inserter_backend.toStr());
 }
 
+struct ShardedDocumentInverterTest : public DocumentInverterTest {
+    ShardedDocumentInverterTest()
+        : DocumentInverterTest(4, 3)
+    {
+    }
+};
+
+TEST_F(ShardedDocumentInverterTest, require_that_shards_are_merged_when_pushing)
+{
+    auto doc10 = makeDoc10(_b);
+    auto doc11 = makeDoc11(_b);
+    auto doc12 = makeDoc12(_b);
+    _inv.invertDocument(10, *doc10, {});
+    _inv.invertDocument(11, *doc11, {});
+    _inv.invertDocument(12, *doc12, {});
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,a=11,"
+              "w=b,a=10,a=11,"
+              "w=c,a=10,w=d,a=10,"
+              "w=doc12,a=12,"
+              "w=e,a=11,"
+              "w=f,a=11,"
+              "w=h,a=12,"
+              "f=1,w=a,a=11,"
+              "w=g,a=11",
+              _inserter_backend.toStr());
+}
+
+TEST_F(ShardedDocumentInverterTest, require_that_removes_are_handled_by_owning_shard)
+{
+    auto doc10 = makeDoc10(_b);
+    auto doc11 = makeDoc11(_b);
+    auto doc12 = makeDoc12(_b);
+    auto doc13 = makeDoc13(_b);
+    auto doc14 = makeDoc14(_b);
+    _inv.invertDocument(10, *doc10, {});
+    _inv.invertDocument(11, *doc11, {});
+    _inv.invertDocument(12, *doc12, {});
+    _inv.invertDocument(13, *doc13, {});
+    _inv.invertDocument(14, *doc14, {});
+    _inv.removeDocuments({11, 13});
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,"
+              "w=b,a=10,"
+              "w=c,a=10,"
+              "w=d,a=10,"
+              "w=doc12,a=12,"
+              "w=doc14,a=14,"
+              "w=h,a=12,"
+              "w=j,a=14",
+              _inserter_backend.toStr());
+    EXPECT_EQ(6u, _calculator.get_num_samples());
+}
+
+TEST_F(ShardedDocumentInverterTest, require_that_latency_stats_are_tracked_per_task)
+{
+    auto doc10 = makeDoc10(_b);
+    auto doc11 = makeDoc11(_b);
+    _inv.invertDocument(10, *doc10, {});
+    _inv.invertDocument(11, *doc11, {});
+    pushDocuments();
+    auto stats = _inv_context.get_field_latency_stats(0);
+    EXPECT_EQ(2u, stats.invert.count);
+    EXPECT_EQ(1u, stats.push.count);
+    uint64_t bucket_count = 0;
+    for (auto bucket_size : stats.invert.buckets) {
+        bucket_count += bucket_size;
+    }
+    EXPECT_EQ(2u, bucket_count);
+    auto all_stats = _inv_context.get_latency_stats();
+    EXPECT_LE(stats.invert.count, all_stats.invert.count);
+    EXPECT_EQ(_inv_context.get_push_contexts().size(), all_stats.push.count);
+    auto delta = all_stats.invert;
+    delta.subtract(stats.invert);
+    EXPECT_EQ(all_stats.invert.count - stats.invert.count, delta.count);
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
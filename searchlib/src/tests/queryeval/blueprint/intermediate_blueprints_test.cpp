@@ -1447,6 +1447,38 @@ TEST("require that highest cost tier sorts last for AND") {
     EXPECT_EQUAL(expect_up->asString(), top_up->asString());
 }
 
+TEST("require that AND children are sorted by estimated hits times cost") {
+    //-------------------------------------------------------------------------
+    Blueprint::UP top_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(10).cost(8.0).create())).
+               addChild(ap(MyLeafSpec(20).create())).
+               addChild(ap(MyLeafSpec(30).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(50).cost(0.1).create()))));
+    //-------------------------------------------------------------------------
+    Blueprint::UP expect_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(50).cost(0.1).create())).
+               addChild(ap(MyLeafSpec(30).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(20).create())).
+               addChild(ap(MyLeafSpec(10).cost(8.0).create()))));
+    //-------------------------------------------------------------------------
+    EXPECT_NOT_EQUAL(expect_up->asString(), top_up->asString());
+    top_up = Blueprint::optimize(std::move(top_up));
+    EXPECT_EQUAL(expect_up->asString(), top_up->asString());
+    expect_up = Blueprint::optimize(std::move(expect_up));
+    EXPECT_EQUAL(expect_up->asString(), top_up->asString());
+}
+
+TEST("require that intermediate cost is the highest child cost") {
+    AndBlueprint blueprint;
+    EXPECT_EQUAL(1.0, blueprint.getState().cost());
+    blueprint.addChild(ap(MyLeafSpec(10).cost(0.5).create()));
+    EXPECT_EQUAL(0.5, blueprint.getState().cost());
+    blueprint.addChild(ap(MyLeafSpec(20).cost(3.0).create()));
+    EXPECT_EQUAL(3.0, blueprint.getState().cost());
+}
+
 TEST("require that intermediate cost tier is minimum cost tier of children") {
     Blueprint::UP bp1(
             ap((new AndBlueprint())->
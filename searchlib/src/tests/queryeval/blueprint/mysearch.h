@@ -141,17 +141,22 @@ class MyLeafSpec
 private:
     FieldSpecBaseList      _fields;
     Blueprint::HitEstimate _estimate;
+    double                 _cost;
     uint32_t               _cost_tier;
     bool                   _want_global_filter;
 
 public:
     explicit MyLeafSpec(uint32_t estHits, bool empty = false)
-        : _fields(), _estimate(estHits, empty), _cost_tier(0), _want_global_filter(false) {}
+        : _fields(), _estimate(estHits, empty), _cost(1.0), _cost_tier(0), _want_global_filter(false) {}
 
     MyLeafSpec &addField(uint32_t fieldId, uint32_t handle) {
         _fields.add(FieldSpecBase(fieldId, handle));
         return *this;
     }
+    MyLeafSpec &cost(double value) {
+        _cost = value;
+        return *this;
+    }
     MyLeafSpec &cost_tier(uint32_t value) {
         assert(value > 0);
         _cost_tier = value;
@@ -168,6 +173,7 @@ public:
     Leaf *create() const {
         Leaf *leaf = new Leaf(_fields);
         leaf->estimate(_estimate.estHits, _estimate.empty);
+        leaf->set_cost(_cost);
         if (_cost_tier > 0) {
             leaf->cost_tier(_cost_tier);
         }
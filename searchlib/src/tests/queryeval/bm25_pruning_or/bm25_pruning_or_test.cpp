@@ -0,0 +1,120 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/queryeval/fake_result.h>
+#include <vespa/searchlib/queryeval/fake_search.h>
+#include <vespa/searchlib/queryeval/field_spec.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/wand/bm25_pruning_or_search.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+
+using namespace search::queryeval;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using score_t = Bm25PruningParams::score_t;
+
+constexpr uint32_t num_terms = 3;
+constexpr uint32_t docid_limit = 1000;
+constexpr uint32_t heap_size = 10;
+
+FakeResult make_result(uint32_t term) {
+    FakeResult result;
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if ((docid % (term + 2)) == 0) {
+            result.doc(docid).num_occs(1 + docid % (3 + term)).field_length(5 + docid % 17);
+        }
+    }
+    return result;
+}
+
+std::shared_ptr<Bm25PruningParams> make_params(uint32_t term_count) {
+    auto params = std::make_shared<Bm25PruningParams>(heap_size, 4);
+    for (uint32_t term = 0; term < term_count; ++term) {
+        params->add_term_field(term, 1.0 + term, 1.2, 0.75, 10.0);
+    }
+    return params;
+}
+
+struct Bm25PruningOrTest : ::testing::Test {
+    std::vector<FakeResult>         results;
+    std::vector<TermFieldMatchData> tfmd;
+    Bm25PruningOrTest()
+        : results(),
+          tfmd(num_terms)
+    {
+        for (uint32_t term = 0; term < num_terms; ++term) {
+            results.push_back(make_result(term));
+            tfmd[term].setNeedInterleavedFeatures(true);
+        }
+    }
+    ~Bm25PruningOrTest() override;
+    std::vector<score_t> expected_best_scores(const Bm25PruningParams &params) const {
+        std::vector<score_t> scores(docid_limit, 0);
+        TermFieldMatchData scratch;
+        for (uint32_t term = 0; term < num_terms; ++term) {
+            for (const auto &doc : results[term].inspect()) {
+                scratch.setNumOccs(doc.num_occs);
+                scratch.setFieldLength(doc.field_length);
+                scores[doc.docId] += 1 + params.lookup(term)->score(scratch);
+            }
+        }
+        std::sort(scores.begin(), scores.end(), std::greater<>());
+        scores.resize(heap_size);
+        return scores;
+    }
+    SearchIterator::UP make_search(const Bm25PruningParams &params) {
+        Bm25PruningOrSearch::Children children;
+        for (uint32_t term = 0; term < num_terms; ++term) {
+            TermFieldMatchDataArray tfmda;
+            tfmda.add(&tfmd[term]);
+            children.emplace_back(std::make_unique<FakeSearch>("tag", "field", "term", results[term], std::move(tfmda)),
+                                  results[term].inspect().size());
+            children.back().fields.push_back({params.lookup(term), &tfmd[term]});
+        }
+        return Bm25PruningOrSearch::create(std::move(children), params, docid_limit);
+    }
+};
+
+Bm25PruningOrTest::~Bm25PruningOrTest() = default;
+
+TEST_F(Bm25PruningOrTest, best_hits_are_not_pruned)
+{
+    auto params = make_params(num_terms);
+    auto search = make_search(*params);
+    std::vector<score_t> scores;
+    search->initRange(1, docid_limit);
+    for (search->seek(1); !search->isAtEnd(); search->seek(search->getDocId() + 1)) {
+        search->unpack(search->getDocId());
+        score_t score = 0;
+        for (uint32_t term = 0; term < num_terms; ++term) {
+            if (tfmd[term].getDocId() == search->getDocId()) {
+                score += 1 + params->lookup(term)->score(tfmd[term]);
+            }
+        }
+        scores.push_back(score);
+    }
+    std::sort(scores.begin(), scores.end(), std::greater<>());
+    ASSERT_LE(heap_size, scores.size());
+    scores.resize(heap_size);
+    EXPECT_EQ(expected_best_scores(*params), scores);
+    auto &pruning_search = dynamic_cast<Bm25PruningOrSearch &>(*search);
+    EXPECT_LT(0u, pruning_search.get_num_pruned());
+    EXPECT_LE(pruning_search.get_num_pruned(), pruning_search.get_num_candidates());
+}
+
+TEST(Bm25PruningOrBlueprintTest, pruning_requires_all_term_fields_below_or)
+{
+    OrBlueprint blueprint;
+    for (uint32_t term = 0; term < 2; ++term) {
+        blueprint.addChild(std::make_unique<FakeBlueprint>(FieldSpec("field", 0, term), make_result(term)));
+    }
+    EXPECT_TRUE(blueprint.set_bm25_pruning(make_params(2)));
+    EXPECT_FALSE(blueprint.set_bm25_pruning(make_params(3)));
+    EXPECT_FALSE(blueprint.set_bm25_pruning({}));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
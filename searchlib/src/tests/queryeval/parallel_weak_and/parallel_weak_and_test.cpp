@@ -593,6 +593,7 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "    estimate: HitEstimate {\n"
                               "        empty: false\n"
                               "        estHits: 2\n"
+                              "        cost: 1\n"
                               "        cost_tier: 1\n"
                               "        tree_size: 2\n"
                               "        allow_termwise_eval: 0\n"
@@ -615,6 +616,7 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "            estimate: HitEstimate {\n"
                               "                empty: false\n"
                               "                estHits: 2\n"
+                              "                cost: 1\n"
                               "                cost_tier: 1\n"
                               "                tree_size: 1\n"
                               "                allow_termwise_eval: 1\n"
@@ -688,4 +690,53 @@ TEST("verify search iterator conformance") {
     }
 }
 
+struct BlockMaxFixture {
+    static constexpr uint32_t num_docs = 4000;
+    DocumentWeightAttributeHelper helper;
+    std::vector<int32_t> weights;
+    TermFieldMatchData tfmd;
+    DummyHeap dummy_heap;
+    BlockMaxFixture() : helper(), weights({1, 2, 3}), tfmd(), dummy_heap() {
+        helper.add_docs(num_docs);
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            // long runs of low weight documents, allowing whole posting list blocks to be skipped
+            helper.set_doc(docid, docid % weights.size(), doc_weight(docid));
+        }
+    }
+    static int32_t doc_weight(uint32_t docid) {
+        return (((docid / 500) % 2) == 1 || (docid % 97) == 0) ? 100 : 1;
+    }
+    SimpleResult expect(score_t threshold) const {
+        SimpleResult result;
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if (weights[docid % weights.size()] * (score_t)doc_weight(docid) > threshold) {
+                result.addHit(docid);
+            }
+        }
+        return result;
+    }
+    SimpleResult search(bool use_dwa, bool strict, score_t threshold) {
+        MatchParams match_params(dummy_heap, threshold, 1.0, 1);
+        std::vector<IDocumentWeightAttribute::LookupResult> dict_entries;
+        for (size_t i = 0; i < weights.size(); ++i) {
+            dict_entries.push_back(helper.dwa().lookup(vespalib::make_string("%zu", i).c_str(), helper.dwa().get_dictionary_snapshot()));
+        }
+        auto itr = create_wand(use_dwa, tfmd, match_params, weights, dict_entries, helper.dwa(), strict);
+        SimpleResult result;
+        return strict ? result.searchStrict(*itr, num_docs) : result.search(*itr, num_docs);
+    }
+};
+
+TEST_F("require that block max pruning does not change the hits", BlockMaxFixture) {
+    for (score_t threshold: {0, 2, 100, 150, 250}) {
+        SimpleResult expect = f.expect(threshold);
+        for (bool use_dwa: {false, true}) {
+            for (bool strict: {false, true}) {
+                TEST_STATE(vespalib::make_string("threshold=%" PRId64 ", use_dwa=%d, strict=%d", threshold, use_dwa, strict).c_str());
+                EXPECT_EQUAL(expect, f.search(use_dwa, strict, threshold));
+            }
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,89 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/attributecontext.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/common/sortresults.h>
+#include <vespa/searchlib/uca/ucaconverter.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/testclock.h>
+#include <vector>
+
+using namespace search;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+
+constexpr uint32_t num_docs = 1000000;
+constexpr double budget = 5.0;
+
+struct Fixture {
+    AttributeManager         mgr;
+    AttributeContext         ctx;
+    vespalib::TestClock      clock;
+    vespalib::Doom           doom;
+    uca::UcaConverterFactory uca_factory;
+    std::vector<RankedHit>   hits;
+
+    Fixture()
+        : mgr(),
+          ctx(mgr),
+          clock(),
+          doom(clock.clock(), vespalib::steady_time::max()),
+          uca_factory(),
+          hits()
+    {
+        srand(1234);
+        auto category = AttributeFactory::createAttribute("category", Config(BasicType::INT32, CollectionType::SINGLE));
+        auto name = AttributeFactory::createAttribute("name", Config(BasicType::STRING, CollectionType::SINGLE));
+        category->addReservedDoc();
+        name->addReservedDoc();
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            uint32_t id;
+            category->addDoc(id);
+            name->addDoc(id);
+            static_cast<IntegerAttribute &>(*category).update(docid, rand() % 16);
+            static_cast<StringAttribute &>(*name).update(docid, vespalib::make_string("name_%u", rand() % 10000).c_str());
+            hits.emplace_back(docid, rand());
+        }
+        category->commit();
+        name->commit();
+        mgr.add(category);
+        mgr.add(name);
+    }
+    ~Fixture();
+    double sort(const vespalib::string &spec, uint32_t topn) {
+        FastS_SortSpec sorter(7, doom, uca_factory);
+        EXPECT_TRUE(sorter.Init(spec, ctx));
+        std::vector<RankedHit> work;
+        return vespalib::BenchmarkTimer::benchmark([&] {
+            work = hits;
+            sorter.sortResults(work.data(), work.size(), topn);
+        }, budget);
+    }
+    double materialize_all_keys(const vespalib::string &spec) {
+        FastS_SortSpec sorter(7, doom, uca_factory);
+        EXPECT_TRUE(sorter.Init(spec, ctx));
+        return vespalib::BenchmarkTimer::benchmark([&] {
+            sorter.initWithoutSorting(hits.data(), hits.size());
+        }, budget);
+    }
+};
+
+Fixture::~Fixture() = default;
+
+TEST_F("benchmark multi-level sort with lazy sort key generation", Fixture) {
+    const vespalib::string spec("+category -name +[docid]");
+    fprintf(stderr, "sort spec '%s', %zu hits\n", spec.c_str(), f.hits.size());
+    fprintf(stderr, "  generate all sort keys: %8.3f ms\n", f.materialize_all_keys(spec) * 1000.0);
+    for (uint32_t topn : {10u, 400u, 10000u, num_docs}) {
+        fprintf(stderr, "  sort, topn = %7u:    %8.3f ms\n", topn, f.sort(spec, topn) * 1000.0);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -67,7 +67,11 @@ private:
     int compareTemplate(AttributeVector *vector, uint32_t a, uint32_t b);
     int compare(AttributeVector *vector, AttrType type, uint32_t a, uint32_t b);
     void sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
-                      uint32_t unique, const std::vector<std::string> &strValues);
+                      uint32_t unique, const std::vector<std::string> &strValues, uint32_t topn);
+    void sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
+                      uint32_t unique, const std::vector<std::string> &strValues) {
+        sortAndCheck(spec, num, unique, strValues, num);
+    }
 public:
     MultilevelSortTest() { srand(time(nullptr)); }
     void testSort();
@@ -200,7 +204,7 @@ MultilevelSortTest::compare(AttributeVector *vector, AttrType type, uint32_t a,
 
 void
 MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
-                                 uint32_t unique, const std::vector<std::string> &strValues)
+                                 uint32_t unique, const std::vector<std::string> &strValues, uint32_t topn)
 {
     VectorMap vec;
     // generate attribute vectors
@@ -269,16 +273,29 @@ MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
         }
     }
 
+    std::vector<RankedHit> expected;
+    if (topn < num) {
+        // the topn hits must be the same as when sorting all hits
+        expected.assign(hits, hits + num);
+        FastS_SortSpec full(7, doom, ucaFactory);
+        full._vectors = sorter._vectors;
+        full.sortResults(expected.data(), num, num);
+    }
+
     vespalib::Timer timer;
-    sorter.sortResults(hits, num, num);
+    sorter.sortResults(hits, num, topn);
     LOG(info, "sort time = %" PRId64 " ms", vespalib::count_ms(timer.elapsed()));
 
-    uint32_t *offsets = new uint32_t[num + 1];
-    char *buf = new char[sorter.getSortDataSize(0, num)];
-    sorter.copySortData(0, num, offsets, buf);
+    for (uint32_t i = 0; i < expected.size() && i < topn; ++i) {
+        EXPECT_EQUAL(expected[i].getDocId(), hits[i].getDocId());
+    }
+
+    uint32_t *offsets = new uint32_t[topn + 1];
+    char *buf = new char[sorter.getSortDataSize(0, topn)];
+    sorter.copySortData(0, topn, offsets, buf);
 
     // check results
-    for (uint32_t i = 0; i < num - 1; ++i) {
+    for (uint32_t i = 0; i < topn - 1; ++i) {
         for (uint32_t j = 0; j < spec.size(); ++j) {
             int cmp = 0;
             if (spec[j]._type == RANK) {
@@ -322,9 +339,9 @@ MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
                      buf + offsets[i], sorter._sortDataArray[i]._len);
         EXPECT_TRUE(cmp == 0);
     }
-    EXPECT_TRUE(sorter._sortDataArray[num-1]._len == (offsets[num] - offsets[num-1]));
-    int cmp = memcmp(&sorter._binarySortData[0] + sorter._sortDataArray[num-1]._idx,
-                 buf + offsets[num-1], sorter._sortDataArray[num-1]._len);
+    EXPECT_TRUE(sorter._sortDataArray[topn-1]._len == (offsets[topn] - offsets[topn-1]));
+    int cmp = memcmp(&sorter._binarySortData[0] + sorter._sortDataArray[topn-1]._idx,
+                 buf + offsets[topn-1], sorter._sortDataArray[topn-1]._len);
     EXPECT_TRUE(cmp == 0);
 
     delete [] hits;
@@ -366,6 +383,11 @@ void MultilevelSortTest::testSort()
         sortAndCheck(spec, 5000, 8, strValues);
         srand(time(nullptr));
         sortAndCheck(spec, 5000, 8, strValues);
+
+        srand(13579);
+        sortAndCheck(spec, 5000, 4, strValues, 1);
+        sortAndCheck(spec, 5000, 4, strValues, 100);
+        sortAndCheck(spec, 5000, 8, strValues, 1000);
     }
     {
         std::vector<std::string> none;
@@ -11,6 +11,7 @@
 LOG_SETUP("distance_function_test");
 
 using namespace search::tensor;
+using vespalib::BFloat16;
 using vespalib::eval::Int8Float;
 using vespalib::eval::TypedCells;
 using search::attribute::DistanceMetric;
@@ -252,6 +253,73 @@ TEST(DistanceFunctionsTest, hamming_gives_expected_score)
     EXPECT_EQ(hamming->calc(TypedCells(bytes_a), TypedCells(bytes_b)), 12.0);
 }
 
+TEST(DistanceFunctionsTest, calc_many_gives_same_result_as_calc)
+{
+    std::vector<float> q{1.0, 2.0, 3.0, 4.0};
+    std::vector<std::vector<float>> vectors;
+    for (int i = 0; i < 40; ++i) {
+        vectors.push_back({float(i), float(-i), 0.5f * i, 1.0f});
+    }
+    std::vector<Int8Float> q8{1, 2, 3, 4};
+    std::vector<std::vector<Int8Float>> vectors8;
+    for (int i = 0; i < 40; ++i) {
+        vectors8.push_back({Int8Float(i), Int8Float(-i), Int8Float(i / 2), 1});
+    }
+    auto verify = [](const DistanceFunction& dist_fun, TypedCells lhs, const std::vector<TypedCells>& rhs) {
+        std::vector<double> distances(rhs.size());
+        dist_fun.calc_many(lhs, rhs, distances.data());
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            EXPECT_DOUBLE_EQ(dist_fun.calc(lhs, rhs[i]), distances[i]);
+        }
+    };
+    std::vector<TypedCells> rhs;
+    for (const auto& v : vectors) {
+        rhs.push_back(t(v));
+    }
+    std::vector<TypedCells> rhs8;
+    for (const auto& v : vectors8) {
+        rhs8.push_back(t(v));
+    }
+    auto ct = vespalib::eval::CellType::FLOAT;
+    verify(*make_distance_function(DistanceMetric::Euclidean, ct), t(q), rhs);
+    verify(*make_distance_function(DistanceMetric::InnerProduct, ct), t(q), rhs);
+    verify(*make_distance_function(DistanceMetric::Angular, ct), t(q), rhs);
+    verify(*make_distance_function(DistanceMetric::Hamming, vespalib::eval::CellType::INT8), t(q8), rhs8);
+    verify(*make_distance_function(DistanceMetric::Euclidean, vespalib::eval::CellType::INT8), t(q8), rhs8);
+}
+
+TEST(DistanceFunctionsTest, bfloat16_cells_give_same_result_as_float_cells)
+{
+    // all values are exactly representable as bfloat16
+    std::vector<float> q{1.0, 2.0, -3.0, 0.5};
+    std::vector<std::vector<float>> vectors;
+    for (int i = 0; i < 40; ++i) {
+        vectors.push_back({float(i), float(-i), 0.5f * i, 1.0f});
+    }
+    auto to_bf16 = [](const std::vector<float>& v) { return std::vector<BFloat16>(v.begin(), v.end()); };
+    std::vector<BFloat16> q16 = to_bf16(q);
+    std::vector<std::vector<BFloat16>> vectors16;
+    for (const auto& v : vectors) {
+        vectors16.push_back(to_bf16(v));
+    }
+    std::vector<TypedCells> rhs16;
+    for (const auto& v : vectors16) {
+        rhs16.push_back(t(v));
+    }
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::InnerProduct, DistanceMetric::Angular}) {
+        auto float_fun = make_distance_function(metric, vespalib::eval::CellType::FLOAT);
+        auto bf16_fun = make_distance_function(metric, vespalib::eval::CellType::BFLOAT16);
+        EXPECT_EQ(vespalib::eval::CellType::BFLOAT16, bf16_fun->expected_cell_type());
+        std::vector<double> distances(rhs16.size());
+        bf16_fun->calc_many(t(q16), rhs16, distances.data());
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            double expect = float_fun->calc(t(q), t(vectors[i]));
+            EXPECT_NEAR(expect, bf16_fun->calc(t(q16), rhs16[i]), 1e-5);
+            EXPECT_NEAR(expect, distances[i], 1e-5);
+        }
+    }
+}
+
 TEST(GeoDegreesTest, gives_expected_score)
 {
     auto ct = vespalib::eval::CellType::DOUBLE;
@@ -33,9 +33,10 @@ private:
     using Vector = std::vector<FloatType>;
     using ArrayRef = vespalib::ConstArrayRef<FloatType>;
     std::vector<Vector> _vectors;
+    mutable std::vector<uint32_t> _prefetched;
 
 public:
-    MyDocVectorAccess() : _vectors() {}
+    MyDocVectorAccess() : _vectors(), _prefetched() {}
     MyDocVectorAccess& set(uint32_t docid, const Vector& vec) {
         if (docid >= _vectors.size()) {
             _vectors.resize(docid + 1);
@@ -47,6 +48,10 @@ public:
         ArrayRef ref(_vectors[docid]);
         return vespalib::eval::TypedCells(ref);
     }
+    void prefetch_vectors(vespalib::ConstArrayRef<uint32_t> docids) const override {
+        _prefetched.insert(_prefetched.end(), docids.begin(), docids.end());
+    }
+    const std::vector<uint32_t>& prefetched() const { return _prefetched; }
 
     void clear() { _vectors.clear(); }
 };
@@ -756,5 +761,107 @@ TEST_F(TwoPhaseTest, two_phase_add)
     expect_levels(7, {{2}, {4}});
 }
 
+TEST_F(TwoPhaseTest, prepared_shrinks_are_only_applied_to_unchanged_link_arrays)
+{
+    for (uint32_t docid = 1; docid <= 7; ++docid) {
+        add_document(docid);
+    }
+    // Both documents are prepared against the same graph, and are likely to shrink the same neighbors.
+    auto up_8 = prepare_add(8);
+    auto up_9 = prepare_add(9);
+    complete_add(8, std::move(up_8));
+    complete_add(9, std::move(up_9));
+    EXPECT_TRUE(index->check_link_symmetry());
+    for (uint32_t docid = 1; docid <= 9; ++docid) {
+        auto node = index->get_node(docid);
+        ASSERT_EQ(1, node.size());
+        EXPECT_LE(node.level(0).size(), index->config().max_links_at_level_0());
+    }
+}
+
+class QuantizedVectorsTest : public HnswIndexTest {
+public:
+    static constexpr uint32_t num_docs = 1500;
+    QuantizedVectorsTest() : HnswIndexTest() {
+        vectors.clear();
+        for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+            vectors.set(docid, {float(docid % 37), float((docid * 7) % 41), float((docid * 13) % 53), float(docid % 11)});
+        }
+        auto generator = std::make_unique<LevelGenerator>();
+        level_generator = generator.get();
+        index = std::make_unique<HnswIndex>(vectors, std::make_unique<SquaredEuclideanDistanceHW<float>>(),
+                                            std::move(generator),
+                                            HnswIndex::Config(16, 8, 100, 0, true, true));
+    }
+};
+
+TEST_F(QuantizedVectorsTest, quantizer_is_trained_when_graph_is_large_enough)
+{
+    for (uint32_t docid = 1; docid < HnswIndex::min_size_before_quantization - 1; ++docid) {
+        add_document(docid);
+    }
+    EXPECT_EQ(nullptr, index->get_quantized_vectors());
+    auto mem_before = memory_usage();
+    for (uint32_t docid = HnswIndex::min_size_before_quantization - 1; docid <= num_docs; ++docid) {
+        add_document(docid);
+    }
+    const auto* quantized = index->get_quantized_vectors();
+    ASSERT_NE(nullptr, quantized);
+    EXPECT_EQ(4u, quantized->dims());
+    EXPECT_LT(mem_before.usedBytes(), memory_usage().usedBytes());
+}
+
+TEST_F(QuantizedVectorsTest, quantizer_is_retrained_incrementally_when_vectors_are_outside_trained_range)
+{
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        add_document(docid);
+    }
+    const auto* quantized = index->get_quantized_vectors();
+    ASSERT_NE(nullptr, quantized);
+    EXPECT_FALSE(quantized->needs_retraining());
+    float scale = quantized->quantizer().scale();
+    uint32_t docid = num_docs;
+    auto add_outliers = [&](uint32_t num_outliers) {
+        for (uint32_t i = 0; i < num_outliers; ++i) {
+            ++docid;
+            vectors.set(docid, {float(1000 + docid % 7), 0, 0, 0});
+            add_document(docid);
+        }
+    };
+    add_outliers(20);
+    // Existing vectors are re-encoded by later puts before the retrained quantizer is used
+    EXPECT_EQ(quantized, index->get_quantized_vectors());
+    EXPECT_TRUE(quantized->needs_retraining());
+    add_outliers(100);
+    const auto* retrained = index->get_quantized_vectors();
+    ASSERT_NE(nullptr, retrained);
+    EXPECT_NE(quantized, retrained);
+    EXPECT_LT(scale, retrained->quantizer().scale());
+    EXPECT_FALSE(retrained->needs_retraining());
+    auto result = index->find_top_k(1, vectors.get_vector(docid), 50, 100100.25);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_GT(result[0].docid, num_docs);
+    EXPECT_EQ(0.0, result[0].distance);
+}
+
+TEST_F(QuantizedVectorsTest, top_k_is_reranked_using_full_precision_vectors)
+{
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        add_document(docid);
+    }
+    ASSERT_NE(nullptr, index->get_quantized_vectors());
+    uint32_t found_self = 0;
+    for (uint32_t docid = 1; docid <= num_docs; docid += 10) {
+        auto qv = vectors.get_vector(docid);
+        auto result = index->find_top_k(1, qv, 50, 100100.25);
+        ASSERT_EQ(1u, result.size());
+        EXPECT_FALSE(vectors.prefetched().empty());
+        if (result[0].docid == docid) {
+            EXPECT_EQ(0.0, result[0].distance);
+            ++found_self;
+        }
+    }
+    EXPECT_GE(found_self, 145u);
+}
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,129 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/transactionlog/domain.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/test/directory_handler.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/destructor_callbacks.h>
+#include <vespa/vespalib/util/gate.h>
+#include <deque>
+#include <mutex>
+
+#include <vespa/log/log.h>
+LOG_SETUP("translog_domain_test");
+
+using namespace search::transactionlog;
+using namespace std::chrono_literals;
+using search::SerialNum;
+using search::index::DummyFileHeaderContext;
+
+constexpr size_t DEFAULT_PACKET_SIZE = 0xf000;
+
+DomainConfig
+createDomainConfig(uint32_t partSizeLimit) {
+    return DomainConfig().setPartSizeLimit(partSizeLimit)
+                         .setEncoding(Encoding(Encoding::xxh64, Encoding::none_multi));
+}
+
+/**
+ * Executor used to serialize commit chunks. Tasks run directly unless the
+ * executor is held, in which case they are queued until run by the test.
+ */
+class HeldExecutor : public vespalib::Executor {
+    std::mutex         _lock;
+    bool               _hold;
+    std::deque<Task::UP> _tasks;
+public:
+    HeldExecutor() : _lock(), _hold(false), _tasks() {}
+    Task::UP execute(Task::UP task) override {
+        {
+            std::lock_guard guard(_lock);
+            if (_hold) {
+                _tasks.push_back(std::move(task));
+                return {};
+            }
+        }
+        task->run();
+        return {};
+    }
+    void wakeup() override { }
+    void hold() {
+        std::lock_guard guard(_lock);
+        _hold = true;
+    }
+    void run_one() {
+        Task::UP task;
+        {
+            std::lock_guard guard(_lock);
+            ASSERT_FALSE(_tasks.empty());
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task->run();
+    }
+    void release() {
+        std::deque<Task::UP> tasks;
+        {
+            std::lock_guard guard(_lock);
+            _hold = false;
+            std::swap(tasks, _tasks);
+        }
+        for (auto & task : tasks) {
+            task->run();
+        }
+    }
+};
+
+void
+commitPacket(Domain & domain, SerialNum serial, Writer::DoneCallback onDone)
+{
+    Packet p(DEFAULT_PACKET_SIZE);
+    p.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef((const char *) &serial, sizeof(serial))));
+    domain.append(p, onDone);
+    auto keep = domain.startCommit(std::move(onDone));
+}
+
+TEST("require that queued commits share fsyncs") {
+    DummyFileHeaderContext fileHeaderContext;
+    search::test::DirectoryHandler testDir("test_group_commit_queued");
+    HeldExecutor executor;
+    Domain domain("groupcommit", testDir.getDir(), executor,
+                  createDomainConfig(0x1000000).setFSyncOnCommit(true).setGroupCommitMaxDelay(1h), fileHeaderContext);
+    // Both commits are queued before the first one is written.
+    executor.hold();
+    vespalib::Gate gate;
+    {
+        auto onDone = std::make_shared<vespalib::GateCallback>(gate);
+        commitPacket(domain, 1, onDone);
+        commitPacket(domain, 2, onDone);
+    }
+    executor.release();
+    gate.await();
+    SyncStats stats = domain.getDomainInfo().syncStats;
+    EXPECT_EQUAL(1u, stats.syncs);
+    EXPECT_EQUAL(2u, stats.chunks);
+}
+
+TEST("require that waiting commits are synced when the delay budget expires") {
+    DummyFileHeaderContext fileHeaderContext;
+    search::test::DirectoryHandler testDir("test_group_commit_deadline");
+    HeldExecutor executor;
+    Domain domain("groupcommit", testDir.getDir(), executor,
+                  createDomainConfig(0x1000000).setFSyncOnCommit(true).setGroupCommitMaxDelay(10ms), fileHeaderContext);
+    executor.hold();
+    vespalib::Gate first;
+    vespalib::Gate second;
+    commitPacket(domain, 1, std::make_shared<vespalib::GateCallback>(first));
+    commitPacket(domain, 2, std::make_shared<vespalib::GateCallback>(second));
+    // The first commit is written and waits for the second one, which is never serialized.
+    executor.run_one();
+    EXPECT_TRUE(first.await(60s));
+    EXPECT_EQUAL(1u, domain.getDomainInfo().syncStats.syncs);
+    executor.release();
+    second.await();
+    SyncStats stats = domain.getDomainInfo().syncStats;
+    EXPECT_EQUAL(2u, stats.syncs);
+    EXPECT_EQUAL(2u, stats.chunks);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
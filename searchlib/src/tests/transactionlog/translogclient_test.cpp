@@ -11,6 +11,8 @@
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/fnet/transport.h>
 #include <vespa/fastos/file.h>
+#include <filesystem>
+#include <fstream>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -893,6 +895,65 @@ TEST("testErase") {
     }
 }
 
+std::vector<PartInfo>
+getParts(const vespalib::string &dir, const vespalib::string &domain)
+{
+    DummyFileHeaderContext fileHeaderContext;
+    TLS tlss(dir, 18377, ".", fileHeaderContext, createDomainConfig(0x1000000));
+    return tlss.tls.getDomainStats()[domain].parts;
+}
+
+std::vector<std::filesystem::path>
+getSkipIndexFiles(const vespalib::string &dir)
+{
+    std::vector<std::filesystem::path> result;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(std::filesystem::path(dir))) {
+        if (entry.path().extension() == ".skip") {
+            result.push_back(entry.path());
+        }
+    }
+    return result;
+}
+
+TEST("require that closed domain parts are opened from skip index") {
+    const unsigned int NUM_PACKETS = 200;
+    const unsigned int NUM_ENTRIES = 100;
+    test::DirectoryHandler testDir("test_skip_index");
+    {
+        DummyFileHeaderContext fileHeaderContext;
+        TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, createDomainConfig(0x10000));
+        TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+
+        createDomainTest(tls, "skip", 0);
+        auto s1 = openDomainTest(tls, "skip");
+        fillDomainTest(s1.get(), NUM_PACKETS, NUM_ENTRIES);
+    }
+    auto skipFiles = getSkipIndexFiles(testDir.getDir());
+    EXPECT_LESS(1u, skipFiles.size());
+    std::vector<PartInfo> parts = getParts(testDir.getDir(), "skip");
+    EXPECT_EQUAL(skipFiles.size(), parts.size());
+    // Corrupt the skip index of one part, which must then be scanned.
+    {
+        std::ofstream corrupt(skipFiles[0], std::ios::binary | std::ios::trunc);
+        corrupt << "garbage";
+    }
+    std::vector<PartInfo> reopened = getParts(testDir.getDir(), "skip");
+    ASSERT_EQUAL(parts.size(), reopened.size());
+    for (size_t i = 0; i < parts.size(); ++i) {
+        EXPECT_EQUAL(parts[i].range.from(), reopened[i].range.from());
+        EXPECT_EQUAL(parts[i].range.to(), reopened[i].range.to());
+        EXPECT_EQUAL(parts[i].numEntries, reopened[i].numEntries);
+        EXPECT_EQUAL(parts[i].byteSize, reopened[i].byteSize);
+    }
+    {
+        DummyFileHeaderContext fileHeaderContext;
+        TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, createDomainConfig(0x1000000));
+        TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+        TEST_DO(assertVisitStats(tls, "skip", 0, NUM_PACKETS * NUM_ENTRIES,
+                                 1, NUM_PACKETS * NUM_ENTRIES, NUM_PACKETS * NUM_ENTRIES, NUM_PACKETS * NUM_ENTRIES - 1));
+    }
+}
+
 TEST("testSync") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
@@ -913,6 +974,31 @@ TEST("testSync") {
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+TEST("require that fsyncs are counted when commits are grouped") {
+    const unsigned int NUM_PACKETS = 20;
+    const unsigned int NUM_ENTRIES = 4;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test_group_commit");
+    TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext,
+             createDomainConfig(0x1000000).setFSyncOnCommit(true).setGroupCommitMaxDelay(100ms));
+    TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+
+    createDomainTest(tls, "groupcommit", 0);
+    auto s1 = openDomainTest(tls, "groupcommit");
+    fillDomainTest(s1.get(), NUM_PACKETS, NUM_ENTRIES);
+    SerialNum syncedTo(0);
+    EXPECT_TRUE(s1->sync(TOTAL_NUM_ENTRIES, syncedTo));
+    EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+
+    SyncStats stats = tlss.tls.getDomainStats()["groupcommit"].syncStats;
+    EXPECT_LESS(0u, stats.syncs);
+    EXPECT_LESS_EQUAL(stats.syncs, stats.chunks + 1);
+    EXPECT_EQUAL(NUM_PACKETS, stats.chunks);
+    EXPECT_LESS(0u, stats.bytes);
+}
+
 TEST("test truncate on version mismatch") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
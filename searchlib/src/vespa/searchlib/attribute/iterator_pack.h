@@ -38,6 +38,18 @@ public:
         return _children[ref].getData();
     }
 
+    // Per block (btree leaf) weight bounds, only valid when the child is not at end
+    static constexpr bool has_block_max() { return true; }
+    int32_t get_block_max_weight(uint16_t ref) const {
+        return _children[ref].getLeafAggregated().getMax();
+    }
+    int32_t get_block_min_weight(uint16_t ref) const {
+        return _children[ref].getLeafAggregated().getMin();
+    }
+    uint32_t get_block_last_docid(uint16_t ref) const {
+        return _children[ref].getLeafLastKey();
+    }
+
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id, uint32_t end_id);
     void or_hits_into(BitVector &result, uint32_t begin_id);
 
@@ -214,6 +214,42 @@ FastS_SortSpec::realloc(uint32_t n, size_t & variableWidth, uint32_t & available
     return _binarySortData.data() + byteUsed;
 }
 
+int
+FastS_SortSpec::serializeLevel(const VectorRef & vec, const RankedHit & hit, uint8_t * dst, size_t available) const
+{
+    switch (vec._type) {
+    case ASC_DOCID:
+    case DESC_DOCID:
+        if (available < (sizeof(hit._docId) + sizeof(_partitionId))) {
+            return -1;
+        }
+        if (vec._type == ASC_DOCID) {
+            serializeForSort<convertForSort<uint32_t, true> >(hit.getDocId(), dst);
+            serializeForSort<convertForSort<uint16_t, true> >(_partitionId, dst + sizeof(hit._docId));
+        } else {
+            serializeForSort<convertForSort<uint32_t, false> >(hit.getDocId(), dst);
+            serializeForSort<convertForSort<uint16_t, false> >(_partitionId, dst + sizeof(hit._docId));
+        }
+        return sizeof(hit._docId) + sizeof(_partitionId);
+    case ASC_RANK:
+    case DESC_RANK:
+        if (available < sizeof(hit._rankValue)) {
+            return -1;
+        }
+        if (vec._type == ASC_RANK) {
+            serializeForSort<convertForSort<search::HitRank, true> >(hit.getRank(), dst);
+        } else {
+            serializeForSort<convertForSort<search::HitRank, false> >(hit.getRank(), dst);
+        }
+        return sizeof(hit._rankValue);
+    case ASC_VECTOR:
+        return vec._vector->serializeForAscendingSort(hit.getDocId(), dst, available, vec._converter);
+    case DESC_VECTOR:
+        return vec._vector->serializeForDescendingSort(hit.getDocId(), dst, available, vec._converter);
+    }
+    return 0;
+}
+
 void
 FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
 {
@@ -245,36 +281,8 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
         uint32_t len = 0;
         for (auto iter = _vectors.begin(); iter != _vectors.end(); ++iter) {
             int written(0);
-            if (available < std::max(sizeof(hits->_docId) + sizeof(_partitionId), sizeof(hits->_rankValue))) {
-                mySortData = realloc(n, variableWidth, available, dataSize, mySortData);
-            }
             do {
-                switch (iter->_type) {
-                case ASC_DOCID:
-                    serializeForSort<convertForSort<uint32_t, true> >(hits[i].getDocId(), mySortData);
-                    serializeForSort<convertForSort<uint16_t, true> >(_partitionId, mySortData + sizeof(hits->_docId));
-                    written = sizeof(hits->_docId) + sizeof(_partitionId);
-                    break;
-                case DESC_DOCID:
-                    serializeForSort<convertForSort<uint32_t, false> >(hits[i].getDocId(), mySortData);
-                    serializeForSort<convertForSort<uint16_t, false> >(_partitionId, mySortData + sizeof(hits->_docId));
-                    written = sizeof(hits->_docId) + sizeof(_partitionId);
-                    break;
-                case ASC_RANK:
-                    serializeForSort<convertForSort<search::HitRank, true> >(hits[i].getRank(), mySortData);
-                    written = sizeof(hits->_rankValue);
-                    break;
-                case DESC_RANK:
-                    serializeForSort<convertForSort<search::HitRank, false> >(hits[i].getRank(), mySortData);
-                    written = sizeof(hits->_rankValue);
-                    break;
-                case ASC_VECTOR:
-                    written = iter->_vector->serializeForAscendingSort(hits[i].getDocId(), mySortData, available, iter->_converter);
-                    break;
-                case DESC_VECTOR:
-                    written = iter->_vector->serializeForDescendingSort(hits[i].getDocId(), mySortData, available, iter->_converter);
-                    break;
-                }
+                written = serializeLevel(*iter, hits[i], mySortData, available);
                 if (written == -1) {
                     mySortData = realloc(n, variableWidth, available, dataSize, mySortData);
                 }
@@ -444,17 +452,109 @@ public:
 };
 
 
+size_t
+FastS_SortSpec::initLevelSortData(SortData * sd, uint32_t n, const VectorRef & vec, size_t used)
+{
+    size_t width = 0;
+    if (vec._type >= ASC_DOCID) { // doc id
+        width = sizeof(uint32_t) + sizeof(uint16_t);
+    } else if (vec._type >= ASC_RANK) { // rank value
+        width = sizeof(search::HitRank);
+    } else {
+        width = vec._vector->getFixedWidth();
+        if (width == 0) { // string
+            width = 11;
+        }
+    }
+    if (_binarySortData.size() < (used + width * n)) {
+        _binarySortData.resize(used + width * n);
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        int written(0);
+        while ((written = serializeLevel(vec, sd[i], _binarySortData.data() + used, _binarySortData.size() - used)) == -1) {
+            _binarySortData.resize(_binarySortData.size() * 2);
+        }
+        sd[i]._idx = used;
+        sd[i]._len = written;
+        sd[i]._pos = 0;
+        used += written;
+    }
+    return used;
+}
+
+/**
+ * Sort the hits on the sort key of the given level only. Keys for
+ * the next level are only generated for runs of hits that are tied on
+ * this level and that overlap the topn hits wanted.
+ **/
+void
+FastS_SortSpec::sortLevel(SortData * sd, uint32_t n, uint32_t topn, uint32_t level, size_t & used, uint32_t * radixScratchPad)
+{
+    used = initLevelSortData(sd, n, _vectors[level], used);
+    const uint8_t * data = _binarySortData.data();
+    StdSortDataCompare cmp(data);
+    search::radix_sort(SortDataRadix(data), cmp, SortDataEof(), 1, sd, n, radixScratchPad, 0, 96, topn);
+    if (((level + 1) == _vectors.size()) || (topn == 0) || _doom.hard_doom()) {
+        return;
+    }
+    // hits tied with the last wanted hit are kept next to it by the radix sort
+    uint32_t end = topn;
+    while ((end < n) && (cmp.cmp(sd[topn - 1], sd[end]) == 0)) {
+        ++end;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> ties;
+    for (uint32_t i = 0; i < topn; ) {
+        uint32_t j = i + 1;
+        while ((j < end) && (cmp.cmp(sd[i], sd[j]) == 0)) {
+            ++j;
+        }
+        if ((j - i) > 1) {
+            ties.emplace_back(i, j);
+        }
+        i = j;
+    }
+    for (const auto & tie : ties) {
+        sortLevel(sd + tie.first, tie.second - tie.first, std::min(topn, tie.second) - tie.first,
+                  level + 1, used, radixScratchPad);
+    }
+}
+
 void
 FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
 {
-    initSortData(a, n);
+    topn = std::min(topn, n);
+    if (_vectors.empty() || (topn == n)) {
+        initSortData(a, n);
+        SortData * sortData = _sortDataArray.data();
+        {
+            Array<uint32_t> radixScratchPad(n, Alloc::alloc(0, MMAP_LIMIT));
+            search::radix_sort(SortDataRadix(_binarySortData.data()), StdSortDataCompare(_binarySortData.data()), SortDataEof(), 1, sortData, n, radixScratchPad.data(), 0, 96, topn);
+        }
+        for (uint32_t i(0), m(_sortDataArray.size()); i < m; ++i) {
+            a[i]._rankValue = _sortDataArray[i]._rankValue;
+            a[i]._docId = _sortDataArray[i]._docId;
+        }
+        return;
+    }
+    // Only the topn hits need to be ordered. Sort one level at a
+    // time, only generating keys for the next level where needed to
+    // break ties.
+    freeSortData();
+    _sortDataArray.resize(n);
     SortData * sortData = _sortDataArray.data();
+    for (uint32_t i = 0; i < n; ++i) {
+        sortData[i]._docId = a[i]._docId;
+        sortData[i]._rankValue = a[i]._rankValue;
+    }
     {
         Array<uint32_t> radixScratchPad(n, Alloc::alloc(0, MMAP_LIMIT));
-        search::radix_sort(SortDataRadix(_binarySortData.data()), StdSortDataCompare(_binarySortData.data()), SortDataEof(), 1, sortData, n, radixScratchPad.data(), 0, 96, topn);
+        size_t used = 0;
+        sortLevel(sortData, n, topn, 0, used, radixScratchPad.data());
     }
-    for (uint32_t i(0), m(_sortDataArray.size()); i < m; ++i) {
-        a[i]._rankValue = _sortDataArray[i]._rankValue;
-        a[i]._docId = _sortDataArray[i]._docId;
+    for (uint32_t i = 0; i < n; ++i) {
+        a[i]._rankValue = sortData[i]._rankValue;
+        a[i]._docId = sortData[i]._docId;
     }
+    // complete sort data is only needed for the topn hits
+    initSortData(a, topn);
 }
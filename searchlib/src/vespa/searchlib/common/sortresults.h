@@ -105,6 +105,9 @@ private:
     bool Add(search::attribute::IAttributeContext & vecMan, const search::common::SortInfo & sInfo);
     void initSortData(const search::RankedHit *a, uint32_t n);
     uint8_t * realloc(uint32_t n, size_t & variableWidth, uint32_t & available, uint32_t & dataSize, uint8_t *mySortData);
+    int serializeLevel(const VectorRef & vec, const search::RankedHit & hit, uint8_t * dst, size_t available) const;
+    size_t initLevelSortData(SortData * sd, uint32_t n, const VectorRef & vec, size_t used);
+    void sortLevel(SortData * sd, uint32_t n, uint32_t topn, uint32_t level, size_t & used, uint32_t * radixScratchPad);
 
 public:
     FastS_SortSpec(const FastS_SortSpec &) = delete;
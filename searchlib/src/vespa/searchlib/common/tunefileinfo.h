@@ -98,14 +98,21 @@ private:
     TuneControl _tuneControl;
     int         _mmapFlags;
     int         _advise;
+    bool        _asyncRead;
 public:
     TuneFileRandRead() noexcept
         : _tuneControl(NORMAL),
           _mmapFlags(0),
-          _advise(0)
+          _advise(0),
+          _asyncRead(false)
     { }
 
     void setAdvise(int advise)        { _advise = advise; }
+    /**
+     * Let independent reads be in flight at the same time; io_uring for normal io,
+     * and read ahead of the whole range up front for memory mapped files.
+     */
+    void setWantAsyncRead(bool asyncRead) { _asyncRead = asyncRead; }
     void setWantMemoryMap() { _tuneControl = MMAP; }
     void setWantDirectIO()  { _tuneControl = DIRECTIO; }
     void setWantNormal()    { _tuneControl = NORMAL; }
@@ -113,6 +120,7 @@ public:
     bool getWantMemoryMap()  const { return _tuneControl == MMAP; }
     int  getMemoryMapFlags() const { return _mmapFlags; }
     int  getAdvise()         const { return _advise; }
+    bool getWantAsyncRead()  const { return _asyncRead; }
 
     template <typename TuneControlConfig, typename MMapConfig>
     void setFromConfig(const enum TuneControlConfig::Io & tuneControlConfig, const MMapConfig & mmapFlags);
@@ -120,7 +128,7 @@ public:
     void setFromMmapConfig(const MMapConfig & mmapFlags);
 
     bool operator==(const TuneFileRandRead &rhs) const {
-        return (_tuneControl == rhs._tuneControl) && (_mmapFlags == rhs._mmapFlags);
+        return (_tuneControl == rhs._tuneControl) && (_mmapFlags == rhs._mmapFlags) && (_asyncRead == rhs._asyncRead);
     }
 
     bool operator!=(const TuneFileRandRead &rhs) const {
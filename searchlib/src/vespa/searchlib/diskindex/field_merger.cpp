@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "field_merger.h"
+#include "bitvectordictionary.h"
 #include "fieldreader.h"
 #include "field_length_scanner.h"
 #include "fusion_input_index.h"
@@ -45,6 +46,8 @@ constexpr uint32_t renumber_word_ids_merge_chunk = 1000000;
 constexpr uint32_t merge_postings_heap_limit = 4;
 constexpr uint32_t merge_postings_merge_chunk = 50000;
 constexpr uint32_t scan_chunk = 80000;
+constexpr uint64_t min_words_per_partition = 100000;
+constexpr uint32_t stitch_partitions_word_chunk = 10000;
 
 vespalib::string
 createTmpPath(const vespalib::string & base, uint32_t index) {
@@ -55,6 +58,15 @@ createTmpPath(const vespalib::string & base, uint32_t index) {
     return os.str();
 }
 
+vespalib::string
+createPartitionPath(const vespalib::string & base, uint32_t partition) {
+    vespalib::asciistream os;
+    os << base;
+    os << "/partition";
+    os << partition;
+    return os.str();
+}
+
 }
 
 FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token)
@@ -73,6 +85,11 @@ FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index,
       _writer(),
       _field_length_scanner(),
       _open_reader_idx(std::numeric_limits<uint32_t>::max()),
+      _num_partitions(1u),
+      _pending_partitions(0u),
+      _partitions_failed(false),
+      _stitch_partition(0u),
+      _stitch_bit_vectors(),
       _state(State::MERGE_START),
       _failed(false)
 {
@@ -313,6 +330,20 @@ FieldMerger::scan_element_lengths()
 }
 
 
+bool
+FieldMerger::open_field_writer(FieldWriter& writer, const vespalib::string& dir, const FieldLengthInfo& field_length_info)
+{
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    if (!writer.open(dir + "/", 64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
+                     index.use_interleaved_features(), index.getSchema(),
+                     index.getIndex(),
+                     field_length_info,
+                     _fusion_out_index.get_tune_file_indexing()._write, _fusion_out_index.get_file_header_context())) {
+        throw IllegalArgumentException(make_string("Could not open output posocc + dictionary in %s", dir.c_str()));
+    }
+    return true;
+}
+
 bool
 FieldMerger::open_field_writer()
 {
@@ -320,19 +351,11 @@ FieldMerger::open_field_writer()
     if (!_readers.empty()) {
         field_length_info = _readers.back()->get_field_length_info();
     }
-    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
-    if (!_writer->open(_field_dir + "/", 64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
-                       index.use_interleaved_features(), index.getSchema(),
-                       index.getIndex(),
-                       field_length_info,
-                       _fusion_out_index.get_tune_file_indexing()._write, _fusion_out_index.get_file_header_context())) {
-        throw IllegalArgumentException(make_string("Could not open output posocc + dictionary in %s", _field_dir.c_str()));
-    }
-    return true;
+    return open_field_writer(*_writer, _field_dir, field_length_info);
 }
 
 bool
-FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
+FieldMerger::select_cooked_or_raw_features(FieldWriter& writer, FieldReader& reader)
 {
     bool rawFormatOK = true;
     bool cookedFormatOK = true;
@@ -345,7 +368,7 @@ FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
         return true;
     }
     {
-        _writer->getFeatureParams(featureParams);
+        writer.getFeatureParams(featureParams);
         cookedFormat = featureParams.getStr("cookedEncoding");
         rawFormat = featureParams.getStr("encoding");
         if (rawFormat == "") {
@@ -395,7 +418,7 @@ FieldMerger::setup_merge_heap()
 {
     _heap = std::make_unique<PostingPriorityQueueMerger<FieldReader, FieldWriter>>();
     for (auto &reader : _readers) {
-        if (!select_cooked_or_raw_features(*reader)) {
+        if (!select_cooked_or_raw_features(*_writer, *reader)) {
             return false;
         }
         if (reader->isValid()) {
@@ -417,6 +440,13 @@ FieldMerger::merge_postings_start()
     _writer = std::make_unique<FieldWriter>(_fusion_out_index.get_doc_id_limit(), _num_word_ids);
     _readers.reserve(_fusion_out_index.get_old_indexes().size());
     allocate_field_length_scanner();
+    _num_partitions = calc_num_partitions();
+    if (_num_partitions > 1u) {
+        LOG(debug, "Merge postings for field %s using %u word partitions", _field_name.c_str(), _num_partitions);
+        _pending_partitions = _num_partitions;
+        _state = State::MERGE_PARTITIONS;
+        return;
+    }
     _open_reader_idx = 0;
     _state = State::OPEN_POSTINGS_FIELD_READERS;
 }
@@ -471,6 +501,187 @@ FieldMerger::merge_postings_failed()
                                                _field_name.c_str(), _field_dir.c_str()));
 }
 
+uint32_t
+FieldMerger::calc_num_partitions() const
+{
+    uint32_t word_partitions = _fusion_out_index.get_word_partitions();
+    if (word_partitions <= 1u || _field_length_scanner) {
+        return 1u;   // Scanning element lengths requires sequential merge
+    }
+    uint64_t min_words = _fusion_out_index.get_force_small_merge_chunk() ? 1u : min_words_per_partition;
+    uint64_t max_partitions = _num_word_ids / min_words;
+    return std::max(1u, static_cast<uint32_t>(std::min(static_cast<uint64_t>(word_partitions), max_partitions)));
+}
+
+uint64_t
+FieldMerger::get_partition_word_num_begin(uint32_t partition) const
+{
+    return 1u + (_num_word_ids * partition) / _num_partitions;
+}
+
+vespalib::string
+FieldMerger::get_partition_dir(uint32_t partition) const
+{
+    return createPartitionPath(_field_dir, partition);
+}
+
+bool
+FieldMerger::merge_partition_postings(uint32_t partition)
+{
+    vespalib::string partition_dir = get_partition_dir(partition);
+    std::filesystem::create_directory(std::filesystem::path(partition_dir));
+    uint64_t word_num_begin = get_partition_word_num_begin(partition);
+    uint64_t word_num_end = get_partition_word_num_begin(partition + 1);
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    std::vector<std::unique_ptr<FieldReader>> readers;
+    readers.reserve(_fusion_out_index.get_old_indexes().size());
+    for (const auto& oi : _fusion_out_index.get_old_indexes()) {
+        const Schema &oldSchema = oi.getSchema();
+        if (!index.hasOldFields(oldSchema)) {
+            continue; // drop data
+        }
+        readers.push_back(FieldReader::allocFieldReader(index, oldSchema, {}));
+        auto& reader = *readers.back();
+        reader.setup(_word_num_mappings[oi.getIndex()], oi.getDocIdMapping());
+        reader.set_word_range(word_num_begin, word_num_end);
+        if (!reader.open(oi.getPath() + "/" + _field_name + "/", _fusion_out_index.get_tune_file_indexing()._read)) {
+            return false;
+        }
+    }
+    FieldLengthInfo field_length_info;
+    if (!readers.empty()) {
+        field_length_info = readers.back()->get_field_length_info();
+    }
+    FieldWriter writer(_fusion_out_index.get_doc_id_limit(), _num_word_ids);
+    open_field_writer(writer, partition_dir, field_length_info);
+    PostingPriorityQueueMerger<FieldReader, FieldWriter> heap;
+    for (auto &reader : readers) {
+        if (!select_cooked_or_raw_features(writer, *reader)) {
+            return false;
+        }
+        if (reader->isValid()) {
+            reader->read();
+        }
+        if (reader->isValid()) {
+            heap.initialAdd(reader.get());
+        }
+    }
+    heap.setup(merge_postings_heap_limit);
+    heap.set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_merge_chunk);
+    while (!heap.empty()) {
+        heap.merge(writer, *_flush_token);
+        if (_flush_token->stop_requested()) {
+            return false;
+        }
+    }
+    bool res = true;
+    for (auto &reader : readers) {
+        if (!reader->close()) {
+            res = false;
+        }
+    }
+    if (!writer.close()) {
+        LOG(error, "Could not close output posocc + dictionary in %s", partition_dir.c_str());
+        res = false;
+    }
+    return res;
+}
+
+bool
+FieldMerger::merge_partition(uint32_t partition)
+{
+    try {
+        if (!merge_partition_postings(partition)) {
+            _partitions_failed = true;
+        }
+    } catch (const std::exception &e) {
+        LOG(error, "Could not merge word partition %u for field %s: %s", partition, _field_name.c_str(), e.what());
+        _partitions_failed = true;
+    }
+    if (_pending_partitions.fetch_sub(1u) != 1u) {
+        return false;
+    }
+    _state = State::STITCH_PARTITIONS_START;
+    return true;
+}
+
+bool
+FieldMerger::open_partition_reader()
+{
+    vespalib::string partition_dir = get_partition_dir(_stitch_partition) + "/";
+    auto reader = std::make_unique<FieldReader>();
+    DocIdMapping doc_id_mapping;
+    doc_id_mapping.setup(_fusion_out_index.get_doc_id_limit());
+    reader->setup(WordNumMapping(), doc_id_mapping);
+    if (!reader->open(partition_dir, _fusion_out_index.get_tune_file_indexing()._read)) {
+        return false;
+    }
+    _readers.push_back(std::move(reader));
+    _stitch_bit_vectors = std::make_unique<BitVectorDictionary>();
+    return _stitch_bit_vectors->open(partition_dir, TuneFileRandRead(), BitVectorKeyScope::PERFIELD_WORDS);
+}
+
+void
+FieldMerger::stitch_partitions_start()
+{
+    if (_partitions_failed) {
+        merge_postings_failed();
+        return;
+    }
+    _stitch_partition = 0u;
+    if (!open_partition_reader() || !open_field_writer()) {
+        merge_postings_failed();
+        return;
+    }
+    _state = State::STITCH_PARTITIONS;
+}
+
+void
+FieldMerger::stitch_partitions_main()
+{
+    // Encoded posting lists are copied as is, only dictionary and bit vector index are rewritten
+    uint32_t remaining_words = _fusion_out_index.get_force_small_merge_chunk() ? 1u : stitch_partitions_word_chunk;
+    auto& reader = *_readers.back();
+    while (remaining_words > 0u && !_flush_token->stop_requested() && reader.copyWord(*_writer, *_stitch_bit_vectors)) {
+        --remaining_words;
+    }
+    if (_flush_token->stop_requested()) {
+        _failed = true;
+        return;
+    }
+    if (reader.isValid()) {
+        return;
+    }
+    _stitch_bit_vectors.reset();
+    if (!reader.close()) {
+        merge_postings_failed();
+        return;
+    }
+    _readers.pop_back();
+    if (++_stitch_partition < _num_partitions) {
+        if (!open_partition_reader()) {
+            merge_postings_failed();
+        }
+        return;
+    }
+    _state = State::MERGE_POSTINGS_FINISH;
+}
+
+bool
+FieldMerger::clean_partition_dirs()
+{
+    for (uint32_t partition = 0; partition < _num_partitions; ++partition) {
+        vespalib::string partition_dir = get_partition_dir(partition);
+        std::error_code ec;
+        std::filesystem::remove_all(std::filesystem::path(partition_dir), ec);
+        if (ec) {
+            LOG(error, "Failed to clean partition dir %s", partition_dir.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
 void
 FieldMerger::merge_field_start()
 {
@@ -513,7 +724,7 @@ FieldMerger::merge_field_finish()
     }
     vespalib::File::sync(_field_dir);
 
-    if (!clean_tmp_dirs()) {
+    if (!clean_tmp_dirs() || (_num_partitions > 1u && !clean_partition_dirs())) {
         _failed = true;
         return;
     }
@@ -539,6 +750,9 @@ FieldMerger::process_merge_field()
             break;
         } else {
             merge_postings_start();
+            if (_state == State::MERGE_PARTITIONS) {
+                break;  // Partitions are merged by separate tasks
+            }
         }
         [[fallthrough]];
     case State::OPEN_POSTINGS_FIELD_READERS:
@@ -553,6 +767,12 @@ FieldMerger::process_merge_field()
     case State::MERGE_POSTINGS:
         merge_postings_main();
         break;
+    case State::STITCH_PARTITIONS_START:
+        stitch_partitions_start();
+        break;
+    case State::STITCH_PARTITIONS:
+        stitch_partitions_main();
+        break;
     case State::MERGE_POSTINGS_FINISH:
         merge_field_finish();
         break;
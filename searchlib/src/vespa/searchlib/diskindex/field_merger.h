@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -12,8 +13,11 @@ class IFlushToken;
 template <class Reader, class Writer> class PostingPriorityQueueMerger;
 }
 
+namespace search::index { class FieldLengthInfo; }
+
 namespace search::diskindex {
 
+class BitVectorDictionary;
 class DictionaryWordReader;
 class FieldLengthScanner;
 class FieldReader;
@@ -37,6 +41,9 @@ class FieldMerger
         SCAN_ELEMENT_LENGTHS,
         OPEN_POSTINGS_FIELD_READERS_FINISH,
         MERGE_POSTINGS,
+        MERGE_PARTITIONS,
+        STITCH_PARTITIONS_START,
+        STITCH_PARTITIONS,
         MERGE_POSTINGS_FINISH,
         MERGE_DONE
     };
@@ -56,6 +63,11 @@ class FieldMerger
     std::unique_ptr<FieldWriter> _writer;
     std::shared_ptr<FieldLengthScanner> _field_length_scanner;
     uint32_t _open_reader_idx;
+    uint32_t _num_partitions;
+    std::atomic<uint32_t> _pending_partitions;
+    std::atomic<bool> _partitions_failed;
+    uint32_t _stitch_partition;
+    std::unique_ptr<BitVectorDictionary> _stitch_bit_vectors;
     State _state;
     bool _failed;
 
@@ -71,20 +83,36 @@ class FieldMerger
     bool open_input_field_reader();
     void open_input_field_readers();
     void scan_element_lengths();
+    bool open_field_writer(FieldWriter& writer, const vespalib::string& dir, const index::FieldLengthInfo& field_length_info);
     bool open_field_writer();
-    bool select_cooked_or_raw_features(FieldReader& reader);
+    bool select_cooked_or_raw_features(FieldWriter& writer, FieldReader& reader);
     bool setup_merge_heap();
     void merge_postings_start();
     void merge_postings_open_field_readers_done();
     void merge_postings_main();
     bool merge_postings_finish();
     void merge_postings_failed();
+    uint32_t calc_num_partitions() const;
+    uint64_t get_partition_word_num_begin(uint32_t partition) const;
+    vespalib::string get_partition_dir(uint32_t partition) const;
+    bool merge_partition_postings(uint32_t partition);
+    bool open_partition_reader();
+    void stitch_partitions_start();
+    void stitch_partitions_main();
+    bool clean_partition_dirs();
 public:
     FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token);
     ~FieldMerger();
     void merge_field_start();
     void merge_field_finish();
     void process_merge_field(); // Called multiple times
+    /*
+     * Merge postings for one word range. Called concurrently for all
+     * partitions, returns true for the last partition to complete.
+     */
+    bool merge_partition(uint32_t partition);
+    uint32_t get_num_partitions() const noexcept { return _num_partitions; }
+    bool merging_partitions() const noexcept { return _state == State::MERGE_PARTITIONS; }
     uint32_t get_id() const noexcept { return _id; }
     bool done() const noexcept { return _state == State::MERGE_DONE; }
     bool failed() const noexcept { return _failed; }
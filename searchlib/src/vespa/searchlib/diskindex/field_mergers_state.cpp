@@ -3,6 +3,7 @@
 #include "field_mergers_state.h"
 #include "field_merger.h"
 #include "field_merger_task.h"
+#include "field_partition_merger_task.h"
 #include "fusion_output_index.h"
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/cpu_usage.h>
@@ -74,4 +75,14 @@ FieldMergersState::schedule_task(FieldMerger& field_merger)
     assert(!rejected);
 }
 
+void
+FieldMergersState::schedule_partition_tasks(FieldMerger& field_merger)
+{
+    for (uint32_t partition = 0; partition < field_merger.get_num_partitions(); ++partition) {
+        auto task = std::make_unique<FieldPartitionMergerTask>(field_merger, *this, partition);
+        auto rejected = _executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::COMPACT));
+        assert(!rejected);
+    }
+}
+
 }
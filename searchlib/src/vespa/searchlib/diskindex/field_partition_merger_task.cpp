@@ -0,0 +1,18 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_partition_merger_task.h"
+#include "field_merger.h"
+#include "field_mergers_state.h"
+
+namespace search::diskindex {
+
+void
+FieldPartitionMergerTask::run()
+{
+    if (_field_merger.merge_partition(_partition)) {
+        // Last partition done, continue with stitching partitions
+        _field_mergers_state.schedule_task(_field_merger);
+    }
+}
+
+}
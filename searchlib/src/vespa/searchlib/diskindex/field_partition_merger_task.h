@@ -0,0 +1,32 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/threadexecutor.h>
+
+namespace search::diskindex {
+
+class FieldMerger;
+class FieldMergersState;
+
+/*
+ * Task for merging the postings for one word partition of a field.
+ */
+class FieldPartitionMergerTask : public vespalib::Executor::Task
+{
+    FieldMerger&       _field_merger;
+    FieldMergersState& _field_mergers_state;
+    uint32_t           _partition;
+
+    void run() override;
+public:
+    FieldPartitionMergerTask(FieldMerger& field_merger, FieldMergersState& field_mergers_state, uint32_t partition)
+        : vespalib::Executor::Task(),
+          _field_merger(field_merger),
+          _field_mergers_state(field_mergers_state),
+          _partition(partition)
+    {
+    }
+};
+
+}
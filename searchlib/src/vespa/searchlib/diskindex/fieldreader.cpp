@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "fieldreader.h"
+#include "bitvectordictionary.h"
 #include "zcposocc.h"
 #include "extposocc.h"
 #include "pagedict4file.h"
@@ -40,7 +41,9 @@ FieldReader::FieldReader()
       _oldWordNum(noWordNumHigh()),
       _residue(0u),
       _docIdLimit(0u),
-      _word()
+      _word(),
+      _wordNumBegin(noWordNum()),
+      _wordNumEnd(noWordNumHigh())
 {
 }
 
@@ -52,15 +55,30 @@ void
 FieldReader::readCounts()
 {
     PostingListCounts counts;
-    _dictFile->readWord(_word, _oldWordNum, counts);
-    _oldposoccfile->readCounts(counts);
-    if (_oldWordNum != noWordNumHigh()) {
+    for (;;) {
+        _dictFile->readWord(_word, _oldWordNum, counts);
+        if (_oldWordNum == noWordNumHigh()) {
+            _oldposoccfile->readCounts(counts);
+            _wordNum = _oldWordNum;
+            return;
+        }
         _wordNum = _wordNumMapper.map(_oldWordNum);
         assert(_wordNum != noWordNum());
         assert(_wordNum != noWordNumHigh());
+        if (_wordNum < _wordNumBegin) {
+            _oldposoccfile->skipWord(counts);
+            continue;
+        }
+        if (_wordNum >= _wordNumEnd) {
+            // Word numbers are mapped in order, remaining words are outside range
+            _oldWordNum = noWordNumHigh();
+            _wordNum = _oldWordNum;
+            return;
+        }
+        _oldposoccfile->readCounts(counts);
         _residue = counts._numDocs;
-    } else
-        _wordNum = _oldWordNum;
+        return;
+    }
 }
 
 
@@ -93,6 +111,21 @@ FieldReader::read()
 }
 
 
+bool
+FieldReader::copyWord(FieldWriter &writer, BitVectorDictionary &bitVectors)
+{
+    PostingListCounts counts;
+    _dictFile->readWord(_word, _oldWordNum, counts);
+    _wordNum = _oldWordNum;
+    if (_oldWordNum == noWordNumHigh()) {
+        return false;
+    }
+    auto bitVector = bitVectors.lookup(_oldWordNum);
+    writer.copyWord(_word, counts, *_oldposoccfile, bitVector.get());
+    return true;
+}
+
+
 bool
 FieldReader::allowRawFeatures()
 {
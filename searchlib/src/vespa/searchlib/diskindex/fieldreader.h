@@ -12,6 +12,7 @@
 
 namespace search::diskindex {
 
+class BitVectorDictionary;
 class FieldLengthScanner;
 
 /*
@@ -51,6 +52,8 @@ protected:
     uint32_t _residue;
     uint32_t _docIdLimit;
     vespalib::string _word;
+    uint64_t _wordNumBegin;
+    uint64_t _wordNumEnd;
 
     static uint64_t noWordNumHigh() {
         return std::numeric_limits<uint64_t>::max();
@@ -82,6 +85,15 @@ public:
         writer.add(_docIdAndFeatures);
     }
 
+    /*
+     * Copy the next word verbatim to writer, without decoding its
+     * posting list. Used instead of read() when no word number or
+     * document id mapping is needed and the writer uses the same
+     * format and feature parameters, e.g. when stitching word
+     * partitions. Returns false when there are no more words.
+     */
+    bool copyWord(FieldWriter &writer, BitVectorDictionary &bitVectors);
+
     bool isValid() const { return _wordNum != noWordNumHigh(); }
 
     bool operator<(const FieldReader &rhs) const {
@@ -91,11 +103,21 @@ public:
     }
 
     virtual void setup(const WordNumMapping &wordNumMapping, const DocIdMapping &docIdMapping);
+
+    /*
+     * Limit reader to words with mapped word numbers in [begin, end).
+     * Posting lists for words before the range are skipped.
+     */
+    void set_word_range(uint64_t begin, uint64_t end) {
+        _wordNumBegin = begin;
+        _wordNumEnd = end;
+    }
     virtual bool open(const vespalib::string &prefix, const TuneFileSeqRead &tuneFileRead);
     virtual bool close();
     virtual void setFeatureParams(const PostingListParams &params);
     virtual void getFeatureParams(PostingListParams &params);
     uint32_t getDocIdLimit() const { return _docIdLimit; }
+    const vespalib::string &get_word() const { return _word; }
     const index::FieldLengthInfo &get_field_length_info() const;
 
     static std::unique_ptr<FieldReader> allocFieldReader(const IndexIterator &index, const Schema &oldSchema, std::shared_ptr<FieldLengthScanner> field_length_scanner);
@@ -27,7 +27,8 @@ FieldWriter::FieldWriter(uint32_t docIdLimit, uint64_t numWordIds)
       _numWordIds(numWordIds),
       _prefix(),
       _compactWordNum(0),
-      _word()
+      _word(),
+      _copiedWord(false)
 {
 }
 
@@ -111,7 +112,7 @@ FieldWriter::flush()
     } else {
         assert(counts._bitLength == 0);
         assert(_bvc.empty());
-        assert(_compactWordNum == 0);
+        assert(_compactWordNum == 0 || _copiedWord);
     }
 }
 
@@ -126,6 +127,7 @@ FieldWriter::newWord(uint64_t wordNum, vespalib::stringref word)
     ++_compactWordNum;
     _word = word;
     _prevDocId = 0;
+    _copiedWord = false;
 }
 
 void
@@ -134,6 +136,27 @@ FieldWriter::newWord(vespalib::stringref word)
     newWord(_wordNum + 1, word);
 }
 
+void
+FieldWriter::copyWord(vespalib::stringref word, const PostingListCounts &counts,
+                      index::PostingListFileSeqRead &posoccfile, const BitVector *bitVector)
+{
+    assert(_wordNum < _numWordIds);
+    flush();
+    ++_wordNum;
+    ++_compactWordNum;
+    _word = word;
+    _prevDocId = 0;
+    _copiedWord = true;
+    _posoccfile->copyWord(posoccfile, counts);
+    PostingListCounts &outCounts = _posoccfile->getCounts();
+    assert(outCounts._numDocs == counts._numDocs);
+    _dictFile->writeWord(_word, outCounts);
+    if (bitVector != nullptr) {
+        _bmapfile.addWordSingle(_compactWordNum, *bitVector);
+    }
+    outCounts.clear();
+}
+
 bool
 FieldWriter::close()
 {
@@ -44,6 +44,7 @@ private:
     vespalib::string _prefix;
     uint64_t _compactWordNum;
     vespalib::string _word;
+    bool _copiedWord;
 
     void flush();
 
@@ -58,6 +59,14 @@ public:
     void newWord(uint64_t wordNum, vespalib::stringref word);
     void newWord(vespalib::stringref word);
 
+    /*
+     * Copy the next word from a posting list file using the same
+     * format and feature parameters, without decoding its posting list.
+     * The bit vector for the word, if any, is written as is.
+     */
+    void copyWord(vespalib::stringref word, const PostingListCounts &counts,
+                  index::PostingListFileSeqRead &posoccfile, const BitVector *bitVector);
+
     void add(const DocIdAndFeatures &features) {
         assert(features.doc_id() < _docIdLimit);
         assert(features.doc_id() > _prevDocId);
@@ -43,6 +43,11 @@ public:
     ~Fusion();
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _fusion_out_index.set_dynamic_k_pos_index_format(dynamic_k_pos_index_format); }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _fusion_out_index.set_force_small_merge_chunk(force_small_merge_chunk); }
+    /*
+     * Split the dictionary of each field into word ranges that are merged
+     * concurrently before being stitched together into the output field.
+     */
+    void set_word_partitions(uint32_t word_partitions) { _fusion_out_index.set_word_partitions(word_partitions); }
     bool merge(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken> flush_token);
 };
 
@@ -26,6 +26,7 @@ private:
     const uint32_t                       _doc_id_limit;
     bool                                 _dynamic_k_pos_index_format;
     bool                                 _force_small_merge_chunk;
+    uint32_t                             _word_partitions;
     const TuneFileIndexing&              _tune_file_indexing;
     const common::FileHeaderContext&     _file_header_context;
 public:
@@ -34,12 +35,14 @@ public:
 
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _dynamic_k_pos_index_format = dynamic_k_pos_index_format; }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _force_small_merge_chunk = force_small_merge_chunk; }
+    void set_word_partitions(uint32_t word_partitions) { _word_partitions = word_partitions; }
     const index::Schema& get_schema() const noexcept { return _schema; }
     const vespalib::string& get_path() const noexcept { return _path; }
     const std::vector<FusionInputIndex>& get_old_indexes() const noexcept { return _old_indexes; }
     uint32_t get_doc_id_limit() const noexcept { return _doc_id_limit; }
     bool get_dynamic_k_pos_index_format() const noexcept { return _dynamic_k_pos_index_format; }
     bool get_force_small_merge_chunk() const noexcept { return _force_small_merge_chunk; }
+    uint32_t get_word_partitions() const noexcept { return _word_partitions; }
     const TuneFileIndexing& get_tune_file_indexing() const noexcept { return _tune_file_indexing; }
     const common::FileHeaderContext& get_file_header_context() const noexcept { return _file_header_context; }
 };
@@ -224,6 +224,34 @@ Zc4PostingWriter<bigEndian>::flush_word()
     _writePos = writePos;
 }
 
+/*
+ * Copy an encoded posting list verbatim from decode_context. Skip info
+ * and feature positions are relative to the start of the posting list,
+ * thus no decoding is needed when the posting list parameters match.
+ */
+template <bool bigEndian>
+void
+Zc4PostingWriter<bigEndian>::copy_word(bitcompression::DecodeContext64Base &decode_context, const PostingListCounts &counts)
+{
+    assert(_docIds.empty() && _counts._segments.empty());
+    EncodeContext &e = _encode_context;
+    uint64_t bitsLeft = counts._bitLength;
+    while (bitsLeft >= 64) {
+        e.writeBits(decode_context.readBits(64), 64);
+        e.writeComprBufferIfNeeded();
+        bitsLeft -= 64;
+    }
+    if (bitsLeft > 0) {
+        e.writeBits(decode_context.readBits(bitsLeft), bitsLeft);
+        e.writeComprBufferIfNeeded();
+    }
+    uint64_t writePos = e.getWriteOffset();
+    assert(writePos - _writePos == counts._bitLength);
+    _counts = counts;
+    _writePos = writePos;
+    _numWords++;
+}
+
 template <bool bigEndian>
 void
 Zc4PostingWriter<bigEndian>::set_encode_features(EncodeContext *encode_features)
@@ -39,6 +39,7 @@ public:
     void flush_word_with_skip(bool hasMore);
     void flush_word_no_skip();
     void flush_word();
+    void copy_word(bitcompression::DecodeContext64Base &decode_context, const index::PostingListCounts &counts);
     void write_docid_and_features(const index::DocIdAndFeatures &features);
     void set_encode_features(EncodeContext *encode_features);
     void on_open();
@@ -5,6 +5,8 @@
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/fastos/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.zcposoccrandread");
@@ -41,7 +43,8 @@ ZcPosOccRandRead::ZcPosOccRandRead()
       _numWords(0),
       _fileBitSize(0),
       _headerBitSize(0),
-      _fieldsParams()
+      _fieldsParams(),
+      _prefetch(false)
 { }
 
 
@@ -109,6 +112,15 @@ ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
         handle._mem = mapPtr;
         handle._allocMem = nullptr;
         handle._allocSize = 0;
+        if (_prefetch) {
+            // Start reading the whole posting list now, so that the posting lists of all
+            // terms in a query are read concurrently instead of page by page while iterating.
+            uint64_t endOffset = (handle._bitOffset + _headerBitSize + handle._bitLength + 7) >> 3;
+            static const size_t pageSize = sysconf(_SC_PAGESIZE);
+            uintptr_t start = reinterpret_cast<uintptr_t>(mapPtr);
+            uintptr_t pageStart = start - (start % pageSize);
+            madvise(reinterpret_cast<void *>(pageStart), (start - pageStart) + (endOffset - startOffset), MADV_WILLNEED);
+        }
     } else {
         uint64_t endOffset = (handle._bitOffset + _headerBitSize +
                               handle._bitLength + 7) >> 3;
@@ -155,6 +167,7 @@ ZcPosOccRandRead::
 open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead)
 {
     _file->setFAdviseOptions(tuneFileRead.getAdvise());
+    _prefetch = tuneFileRead.getWantAsyncRead();
     if (tuneFileRead.getWantMemoryMap()) {
         _file->enableMemoryMap(tuneFileRead.getMemoryMapFlags());
     } else  if (tuneFileRead.getWantDirectIO()) {
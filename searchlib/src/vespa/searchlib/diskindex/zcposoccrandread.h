@@ -21,6 +21,7 @@ protected:
     uint64_t _fileBitSize;
     uint64_t _headerBitSize;
     bitcompression::PosOccFieldsParams _fieldsParams;
+    bool             _prefetch;  // Read ahead memory mapped posting lists when handed out
 
 public:
     ZcPosOccRandRead();
@@ -23,6 +23,7 @@ vespalib::string interleaved_features("interleaved_features");
 namespace search::diskindex {
 
 using index::PostingListCountFileSeqRead;
+using index::PostingListFileSeqRead;
 using index::PostingListCountFileSeqWrite;
 using common::FileHeaderContext;
 using bitcompression::FeatureDecodeContextBE;
@@ -61,6 +62,16 @@ Zc4PostingSeqRead::readCounts(const PostingListCounts &counts)
     _reader.set_counts(counts);
 }
 
+void
+Zc4PostingSeqRead::skipWord(const PostingListCounts &counts)
+{
+    // The posting list for a word (all chunks) is stored in counts._bitLength consecutive bits.
+    if (counts._bitLength != 0) {
+        auto &d = _reader.get_decode_features();
+        d.getReadContext()->setPosition(d.getReadOffset() + counts._bitLength);
+    }
+}
+
 
 bool
 Zc4PostingSeqRead::open(const vespalib::string &name,
@@ -217,6 +228,28 @@ Zc4PostingSeqWrite::flushWord()
 }
 
 
+void
+Zc4PostingSeqWrite::copyWord(PostingListFileSeqRead &source, const PostingListCounts &counts)
+{
+    auto zc_source = dynamic_cast<Zc4PostingSeqRead *>(&source);
+    if (zc_source == nullptr) {
+        PostingListFileSeqWrite::copyWord(source, counts);
+        return;
+    }
+    auto &reader = zc_source->get_reader();
+    const auto &posting_params = reader.get_posting_params();
+    if (posting_params._dynamic_k != _writer.get_dynamic_k() ||
+        posting_params._min_skip_docs != _writer.get_min_skip_docs() ||
+        posting_params._min_chunk_docs != _writer.get_min_chunk_docs() ||
+        posting_params._doc_id_limit != _writer.get_docid_limit() ||
+        posting_params._encode_interleaved_features != _writer.get_encode_interleaved_features()) {
+        PostingListFileSeqWrite::copyWord(source, counts);
+        return;
+    }
+    _writer.copy_word(reader.get_decode_features(), counts);
+}
+
+
 void
 Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
 {
@@ -38,12 +38,14 @@ public:
 
     void readDocIdAndFeatures(DocIdAndFeatures &features) override;
     void readCounts(const PostingListCounts &counts) override; // Fill in for next word
+    void skipWord(const PostingListCounts &counts) override;
     bool open(const vespalib::string &name, const TuneFileSeqRead &tuneFileRead) override;
     bool close() override;
     void getParams(PostingListParams &params) override;
     void getFeatureParams(PostingListParams &params) override;
     void readHeader();
     static const vespalib::string &getIdentifier(bool dynamic_k);
+    Zc4PostingReader<true> &get_reader() { return _reader; }
 };
 
 
@@ -74,6 +76,7 @@ public:
 
     void writeDocIdAndFeatures(const DocIdAndFeatures &features) override;
     void flushWord() override;
+    void copyWord(index::PostingListFileSeqRead &source, const PostingListCounts &counts) override;
 
     bool open(const vespalib::string &name,
               const TuneFileSeqWrite &tuneFileWrite,
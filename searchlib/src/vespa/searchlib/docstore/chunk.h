@@ -14,6 +14,7 @@ namespace vespalib {
     class DataBuffer;
 }
 namespace vespalib::alloc { class Alloc; }
+namespace vespalib::compression { class ZStdDictionary; }
 
 namespace search {
 
@@ -87,7 +88,8 @@ public:
     };
     typedef std::vector<Entry> LidList;
     Chunk(uint32_t id, const Config & config);
-    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false);
+    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false,
+          vespalib::compression::ZStdDictionary * dictionary=nullptr);
     ~Chunk();
     LidMeta append(uint32_t lid, const void * buffer, size_t len);
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const;
@@ -98,7 +100,8 @@ public:
     const LidList & getLids() const { return _lids; }
     LidList getUniqueLids() const;
     size_t getMaxPackSize(const CompressionConfig & compression) const;
-    void pack(uint64_t lastSerial, vespalib::DataBuffer & buffer, const CompressionConfig & compression);
+    void pack(uint64_t lastSerial, vespalib::DataBuffer & buffer, const CompressionConfig & compression,
+              vespalib::compression::ZStdDictionary * dictionary=nullptr);
     uint64_t getLastSerial() const { return _lastSerial; }
     uint32_t getId() const { return _id; }
     bool validSerial() const { return getLastSerial() != static_cast<uint64_t>(-1l); }
@@ -0,0 +1,71 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "chunkcache.h"
+#include "chunk.h"
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+
+namespace search::docstore {
+
+ChunkCache::Lru::Lru(size_t maxBytes)
+    : vespalib::lrucache_map<LruParam>(UNLIMITED),
+      _maxBytes(maxBytes),
+      _sizeBytes(0)
+{ }
+
+ChunkCache::Lru::~Lru() = default;
+
+bool
+ChunkCache::Lru::removeOldest(const value_type &v)
+{
+    bool remove(sizeBytes() > capacityBytes());
+    if (remove) {
+        _sizeBytes.store(sizeBytes() - v.second._value.bytes, std::memory_order_relaxed);
+    }
+    return remove;
+}
+
+ChunkCache::ChunkCache(size_t maxBytes)
+    : _lock(),
+      _lru(maxBytes),
+      _nextOwner(1),
+      _hits(0),
+      _misses(0)
+{ }
+
+ChunkCache::~ChunkCache() = default;
+
+ChunkCache::ChunkSP
+ChunkCache::find(const Key &key)
+{
+    std::lock_guard guard(_lock);
+    Entry *found = _lru.findAndRef(key);
+    if (found == nullptr) {
+        ++_misses;
+        return ChunkSP();
+    }
+    ++_hits;
+    return found->chunk;
+}
+
+void
+ChunkCache::insert(const Key &key, ChunkSP chunk)
+{
+    size_t bytes = chunk->getMemoryUsage().allocatedBytes();
+    if (bytes > _lru.capacityBytes()) {
+        return;
+    }
+    std::lock_guard guard(_lock);
+    if ( ! _lru.hasKey(key)) {
+        _lru.addBytes(bytes);
+        _lru.insert(key, Entry(std::move(chunk), bytes));
+    }
+}
+
+vespalib::CacheStats
+ChunkCache::getStats() const
+{
+    std::lock_guard guard(_lock);
+    return vespalib::CacheStats(_hits, _misses, _lru.size(), _lru.sizeBytes(), 0);
+}
+
+}
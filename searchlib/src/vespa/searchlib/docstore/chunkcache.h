@@ -0,0 +1,84 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace search { class Chunk; }
+
+namespace search::docstore {
+
+/**
+ * Caches decompressed chunks read from the data files of log data stores,
+ * so that hot chunks are neither read from disk nor decompressed again.
+ * Cached chunks are immutable and blobs are served directly from them.
+ *
+ * Memory is accounted as the allocated size of the cached chunks. A single
+ * cache can be shared by the stores of several document dbs, giving them
+ * a common memory budget. Each store registers itself as a separate owner,
+ * so that equal file and chunk ids in different stores do not collide.
+ **/
+class ChunkCache {
+public:
+    using ChunkSP = std::shared_ptr<const Chunk>;
+    class Key {
+    public:
+        Key(uint64_t owner, uint64_t nameId, uint32_t chunkId) noexcept
+            : _owner(owner), _nameId(nameId), _chunkId(chunkId)
+        { }
+        size_t hash() const noexcept { return (_owner * 1000003) ^ (_nameId * 8191) ^ _chunkId; }
+        bool operator==(const Key &rhs) const noexcept {
+            return (_owner == rhs._owner) && (_nameId == rhs._nameId) && (_chunkId == rhs._chunkId);
+        }
+    private:
+        uint64_t _owner;
+        uint64_t _nameId;
+        uint32_t _chunkId;
+    };
+
+    explicit ChunkCache(size_t maxBytes);
+    ~ChunkCache();
+
+    uint64_t registerOwner() { return _nextOwner.fetch_add(1, std::memory_order_relaxed); }
+    ChunkSP find(const Key &key);
+    void insert(const Key &key, ChunkSP chunk);
+
+    void setCapacityBytes(size_t maxBytes) { _lru.setCapacityBytes(maxBytes); }
+    size_t capacityBytes() const { return _lru.capacityBytes(); }
+    size_t sizeBytes() const { return _lru.sizeBytes(); }
+    vespalib::CacheStats getStats() const;
+private:
+    struct Entry {
+        ChunkSP chunk;
+        size_t  bytes;
+        Entry() noexcept : chunk(), bytes(0) { }
+        Entry(ChunkSP chunk_in, size_t bytes_in) noexcept : chunk(std::move(chunk_in)), bytes(bytes_in) { }
+    };
+    using LruParam = vespalib::LruParam<Key, Entry>;
+    class Lru : public vespalib::lrucache_map<LruParam> {
+    public:
+        using value_type = LruParam::value_type;
+        explicit Lru(size_t maxBytes);
+        ~Lru() override;
+        void setCapacityBytes(size_t maxBytes) { _maxBytes.store(maxBytes, std::memory_order_relaxed); }
+        size_t capacityBytes() const { return _maxBytes.load(std::memory_order_relaxed); }
+        size_t sizeBytes() const { return _sizeBytes.load(std::memory_order_relaxed); }
+        void addBytes(size_t bytes) { _sizeBytes.store(sizeBytes() + bytes, std::memory_order_relaxed); }
+    private:
+        bool removeOldest(const value_type &v) override;
+        std::atomic<size_t> _maxBytes;
+        std::atomic<size_t> _sizeBytes;
+    };
+
+    mutable std::mutex    _lock;
+    Lru                   _lru;
+    std::atomic<uint64_t> _nextOwner;
+    size_t                _hits;
+    size_t                _misses;
+};
+
+}
@@ -3,6 +3,7 @@
 #include "chunkformats.h"
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 namespace search {
 
@@ -12,6 +13,7 @@ using vespalib::compression::compress;
 using vespalib::compression::decompress;
 using vespalib::compression::computeMaxCompressedsize;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 ChunkException::ChunkException(const vespalib::string & msg, vespalib::stringref location) :
     Exception(make_string("Illegal chunk: %s", msg.c_str()), location)
@@ -19,7 +21,8 @@ ChunkException::ChunkException(const vespalib::string & msg, vespalib::stringref
 }
 
 void
-ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression)
+ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+                  ZStdDictionary * dictionary)
 {
     vespalib::nbostream & os = _dataBuf;
     os << lastSerial;
@@ -33,7 +36,18 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const
     const size_t oldPos(compressed.getDataLen());
     compressed.writeInt8(compression.type);
     compressed.writeInt32(os.size());
-    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.data(), os.size()), compressed, false));
+    vespalib::ConstBufferRef raw(os.data(), os.size());
+    CompressionConfig::Type type(CompressionConfig::NONE);
+    if ((dictionary != nullptr) && (compression.type == CompressionConfig::ZSTD)) {
+        if (raw.size() >= compression.minSize) {
+            type = compress(*dictionary, compression, raw, compressed);
+        }
+        if (type == CompressionConfig::NONE) {
+            compressed.writeBytes(raw.c_str(), raw.size());
+        }
+    } else {
+        type = compress(compression, raw, compressed, false);
+    }
     if (compression.type != type) {
         compressed.getData()[oldPos] = type;
     }
@@ -67,7 +81,7 @@ ChunkFormat::verifyCompression(uint8_t type)
 }
 
 ChunkFormat::UP
-ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
+ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc, ZStdDictionary * dictionary)
 {
     uint8_t version(0);
     vespalib::nbostream raw(buffer, len);
@@ -89,9 +103,9 @@ ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
         }
     } else if (version == ChunkFormatV2::VERSION) {
         if (skipcrc) {
-            return std::make_unique<ChunkFormatV2>(raw);
+            return std::make_unique<ChunkFormatV2>(raw, dictionary);
         } else {
-            return std::make_unique<ChunkFormatV2>(raw, crc32);
+            return std::make_unique<ChunkFormatV2>(raw, crc32, dictionary);
         }
     } else {
         throw ChunkException(make_string("Unknown version %d", version), VESPA_STRLOC);
@@ -117,7 +131,7 @@ ChunkFormat::verifyCrc(const vespalib::nbostream & is, uint32_t expectedCrc) con
 }
 
 void
-ChunkFormat::deserializeBody(vespalib::nbostream & is)
+ChunkFormat::deserializeBody(vespalib::nbostream & is, ZStdDictionary * dictionary)
 {
     if (includeSerializedSize()) {
         uint32_t serializedSize(0);
@@ -133,6 +147,19 @@ ChunkFormat::deserializeBody(vespalib::nbostream & is)
     verifyCompression(type);
     uint32_t uncompressedLen(0);
     is >> uncompressedLen;
+    if (type == CompressionConfig::ZSTD) {
+        uint32_t dictionaryId = ZStdDictionary::getDictionaryId(is.peek(), is.size() - sizeof(uint32_t));
+        if (dictionaryId != 0) {
+            if ((dictionary == nullptr) || (dictionary->id() != dictionaryId)) {
+                throw ChunkException(make_string("Chunk requires zstd dictionary %u, which is not available", dictionaryId), VESPA_STRLOC);
+            }
+            vespalib::DataBuffer uncompressed(uncompressedLen);
+            decompress(*dictionary, uncompressedLen, vespalib::ConstBufferRef(is.peek(), is.size() - sizeof(uint32_t)), uncompressed, false);
+            const size_t sz(uncompressed.getDataLen());
+            vespalib::nbostream(std::move(uncompressed).stealBuffer(), sz).swap(_dataBuf);
+            return;
+        }
+    }
     // This is a dirty trick to fool some odd sanity checking in DataBuffer::swap
     vespalib::DataBuffer uncompressed(const_cast<char *>(is.peek()), (size_t)0);
     vespalib::ConstBufferRef data(is.peek(), is.size() - sizeof(uint32_t));
@@ -33,19 +33,19 @@ ChunkFormatV1::computeCrc(const void * buf, size_t sz) const
     return vespalib::crc_32_type::crc(buf, sz);
 }
 
-ChunkFormatV2::ChunkFormatV2(vespalib::nbostream & is) :
+ChunkFormatV2::ChunkFormatV2(vespalib::nbostream & is, ZStdDictionary * dictionary) :
     ChunkFormat()
 {
     verifyMagic(is);
-    deserializeBody(is);
+    deserializeBody(is, dictionary);
 }
 
-ChunkFormatV2::ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc) :
+ChunkFormatV2::ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc, ZStdDictionary * dictionary) :
     ChunkFormat()
 {
     verifyCrc(is, expectedCrc);
     verifyMagic(is);
-    deserializeBody(is);
+    deserializeBody(is, dictionary);
 }
 
 
@@ -27,8 +27,8 @@ class ChunkFormatV2 : public ChunkFormat
 {
 public:
     enum {VERSION=1, MAGIC=0x5ba32de7};
-    ChunkFormatV2(vespalib::nbostream & is);
-    ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc);
+    ChunkFormatV2(vespalib::nbostream & is, ZStdDictionary * dictionary);
+    ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc, ZStdDictionary * dictionary);
     ChunkFormatV2(size_t maxSize);
 private:
     bool includeSerializedSize() const override { return true; }
@@ -175,13 +175,21 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
         if (value.empty()) {
             return std::unique_ptr<document::Document>();
         }
-        Value::Result result = value.decompressed();
-        if ( result.second ) {
-            return std::make_unique<document::Document>(repo, std::move(result.first));
+        if (value.getCompression() == CompressionConfig::NONE) {
+            // Deserialize directly from the cached blob, avoiding a copy.
+            auto blob = value.uncompressedRef();
+            if (blob.second) {
+                nbostream is(blob.first.c_str(), blob.first.size());
+                return std::make_unique<document::Document>(repo, is);
+            }
         } else {
-            LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
-            _cache->invalidate(lid);
+            Value::Result result = value.decompressed();
+            if ( result.second ) {
+                return std::make_unique<document::Document>(repo, std::move(result.first));
+            }
         }
+        LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
+        _cache->invalidate(lid);
     }
 
     _uncached_lookups.fetch_add(1);
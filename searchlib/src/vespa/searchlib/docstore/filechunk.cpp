@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "filechunk.h"
+#include "chunkcache.h"
 #include "data_store_file_chunk_stats.h"
 #include "summaryexceptions.h"
 #include "randreaders.h"
@@ -9,6 +10,8 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/encoding/base64.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/executor.h>
@@ -24,14 +27,17 @@ LOG_SETUP(".search.filechunk");
 using vespalib::CpuUsage;
 using vespalib::GenericHeader;
 using vespalib::getErrorString;
+using vespalib::compression::ZStdDictionary;
 
 namespace search {
 
 namespace {
 
 constexpr size_t ALIGNMENT=0x1000;
+constexpr size_t MAX_CHUNKS_PER_BATCH=32;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string COMPRESSION_DICTIONARY_KEY("zstdDictionary");
 
 }
 
@@ -86,7 +92,10 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _chunkCache(nullptr),
+      _chunkCacheOwner(0),
+      _compressionDictionary()
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -270,6 +279,9 @@ FileChunk::enableRead()
             LOG(debug, "enableRead(): MMapRandReadDynamic: file='%s'", _dataFileName.c_str());
             _file = std::make_unique<MMapRandReadDynamic>(_dataFileName, mmapFlags, fadviseOptions);
         }
+    } else if (_tune._randRead.getWantAsyncRead() && UringRandRead::isSupported()) {
+        LOG(debug, "enableRead(): UringRandRead: file='%s'", _dataFileName.c_str());
+        _file = std::make_unique<UringRandRead>(_dataFileName);
     } else {
         LOG(debug, "enableRead(): NormalRandRead: file='%s'", _dataFileName.c_str());
         _file = std::make_unique<NormalRandRead>(_dataFileName);
@@ -278,6 +290,9 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _compressionDictionary) {
+        _compressionDictionary = readCompressionDictionary(*_file, _dataHeaderLen);
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -353,7 +368,7 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _compressionDictionary.get()));
         });
         executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
 
@@ -375,34 +390,106 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
-    uint32_t prevChunk = begin->getChunkId();
-    uint32_t start(0);
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
-            prevChunk = li.getChunkId();
+    std::vector<std::pair<size_t, size_t>> groups;
+    std::vector<ChunkInfo> chunkInfos;
+    size_t start(0);
+    for (size_t i(1); i <= count; i++) {
+        if ((i == count) || ((begin + i)->getChunkId() != (begin + start)->getChunkId())) {
+            groups.emplace_back(start, i);
+            chunkInfos.push_back(_chunkInfo[(begin + start)->getChunkId()]);
             start = i;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    read(begin, groups, chunkInfos, visitor);
 }
 
 void
-FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
+FileChunk::read(LidInfoWithLidV::const_iterator begin, const std::vector<std::pair<size_t, size_t>> & groups,
+                const std::vector<ChunkInfo> & chunkInfos, IBufferVisitor & visitor) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
-        if (buf.size() != 0) {
-            visitor.visit(li.getLid(), buf);
+    // Lids are grouped by chunk. The chunks are fetched MAX_CHUNKS_PER_BATCH at a time so that
+    // readers capable of asynchronous io can have all the reads in flight at once.
+    for (size_t batchStart(0); batchStart < groups.size(); batchStart += MAX_CHUNKS_PER_BATCH) {
+        size_t batchEnd = std::min(groups.size(), batchStart + MAX_CHUNKS_PER_BATCH);
+        std::vector<std::shared_ptr<const Chunk>> chunks(batchEnd - batchStart);
+        std::vector<vespalib::DataBuffer> buffers;
+        std::vector<FileRandRead::Request> requests;
+        std::vector<size_t> requested;
+        buffers.reserve(chunks.size());
+        for (size_t g(batchStart); g < batchEnd; g++) {
+            SubChunkId chunkId = (begin + groups[g].first)->getChunkId();
+            if (_chunkCache != nullptr) {
+                chunks[g - batchStart] = _chunkCache->find(docstore::ChunkCache::Key(_chunkCacheOwner, _nameId.getId(), chunkId));
+            }
+            if ( ! chunks[g - batchStart]) {
+                const ChunkInfo & ci = chunkInfos[g];
+                buffers.emplace_back(0ul, ALIGNMENT);
+                requests.push_back(FileRandRead::Request{ci.getOffset(), ci.getSize(), &buffers.back(), FileRandRead::FSP()});
+                requested.push_back(g);
+            }
+        }
+        if ( ! requests.empty()) {
+            _file->readBatch(requests);
+            for (size_t r(0); r < requests.size(); r++) {
+                size_t g = requested[r];
+                SubChunkId chunkId = (begin + groups[g].first)->getChunkId();
+                const vespalib::DataBuffer & whole = *requests[r].buffer;
+                auto chunk = std::make_shared<const Chunk>(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead,
+                                                           _compressionDictionary.get());
+                if (_chunkCache != nullptr) {
+                    _chunkCache->insert(docstore::ChunkCache::Key(_chunkCacheOwner, _nameId.getId(), chunkId), chunk);
+                }
+                chunks[g - batchStart] = std::move(chunk);
+            }
+        }
+        for (size_t g(batchStart); g < batchEnd; g++) {
+            for (size_t i(groups[g].first); i < groups[g].second; i++) {
+                const LidInfoWithLid & li = *(begin + i);
+                vespalib::ConstBufferRef buf = chunks[g - batchStart]->getLid(li.getLid());
+                if (buf.size() != 0) {
+                    visitor.visit(li.getLid(), buf);
+                }
+            }
+        }
+    }
+}
+
+std::vector<vespalib::string>
+FileChunk::sampleBlobs(size_t maxBytes) const
+{
+    std::vector<vespalib::string> samples;
+    size_t sampledBytes(0);
+    for (uint32_t chunkId(0); (chunkId < getNumChunks()) && (sampledBytes < maxBytes); chunkId++) {
+        const ChunkInfo & ci = _chunkInfo[chunkId];
+        vespalib::DataBuffer whole(0ul, ALIGNMENT);
+        FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
+        Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _compressionDictionary.get());
+        for (const Chunk::Entry & e : chunk.getLids()) {
+            vespalib::ConstBufferRef blob = chunk.getLid(e.getLid());
+            samples.emplace_back(blob.c_str(), blob.size());
+            sampledBytes += blob.size();
+        }
+    }
+    return samples;
+}
+
+std::shared_ptr<const Chunk>
+FileChunk::readChunk(SubChunkId chunkId, const ChunkInfo & chunkInfo) const
+{
+    if (_chunkCache != nullptr) {
+        auto cached = _chunkCache->find(docstore::ChunkCache::Key(_chunkCacheOwner, _nameId.getId(), chunkId));
+        if (cached) {
+            return cached;
         }
     }
+    vespalib::DataBuffer whole(0ul, ALIGNMENT);
+    FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
+    auto chunk = std::make_shared<const Chunk>(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead,
+                                               _compressionDictionary.get());
+    if (_chunkCache != nullptr) {
+        _chunkCache->insert(docstore::ChunkCache::Key(_chunkCacheOwner, _nameId.getId(), chunkId), chunk);
+    }
+    return chunk;
 }
 
 ssize_t
@@ -418,10 +505,13 @@ ssize_t
 FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
                 vespalib::DataBuffer & buffer) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
-    return chunk.read(lid, buffer);
+    // Chunks read from file are immutable, so the blob can be copied out without taking the chunk lock.
+    auto chunk = readChunk(chunkId, chunkInfo);
+    vespalib::ConstBufferRef buf = chunk->getLid(lid);
+    if (buf.size() != 0) {
+        buffer.writeBytes(buf.c_str(), buf.size());
+    }
+    return buf.size();
 }
 
 uint64_t
@@ -482,6 +572,35 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+std::shared_ptr<ZStdDictionary>
+FileChunk::readCompressionDictionary(FileRandRead &datFile, uint64_t dataHeaderLen)
+{
+    vespalib::DataBuffer h(dataHeaderLen, ALIGNMENT);
+    FileRandRead::FSP keepAlive(datFile.read(0, h, dataHeaderLen));
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    // Read only files never compress, so the level does not matter.
+    return readCompressionDictionary(header, 0);
+}
+
+std::shared_ptr<ZStdDictionary>
+FileChunk::readCompressionDictionary(const vespalib::GenericHeader &header, int compressionLevel)
+{
+    if ( ! header.hasTag(COMPRESSION_DICTIONARY_KEY)) {
+        return {};
+    }
+    std::string content = vespalib::Base64::decode(header.getTag(COMPRESSION_DICTIONARY_KEY).asString());
+    return std::make_shared<ZStdDictionary>(vespalib::ConstBufferRef(content.data(), content.size()), compressionLevel);
+}
+
+void
+FileChunk::writeCompressionDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary)
+{
+    vespalib::ConstBufferRef content = dictionary.content();
+    header.putTag(vespalib::GenericHeader::Tag(COMPRESSION_DICTIONARY_KEY, vespalib::Base64::encode(content.c_str(), content.size())));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -496,7 +615,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _compressionDictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -21,9 +21,11 @@ namespace vespalib {
     class GenericHeader;
     class Executor;
 }
+namespace vespalib::compression { class ZStdDictionary; }
 
 namespace search {
 
+namespace docstore { class ChunkCache; }
 class DataStoreFileChunkStats;
 
 class IWriteData
@@ -110,6 +112,19 @@ public:
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
 
+    /**
+     * Use the given cache for decompressed chunks read from file.
+     * Must be called before the file chunk is made available to readers.
+     */
+    void setChunkCache(docstore::ChunkCache *cache, uint64_t owner) { _chunkCache = cache; _chunkCacheOwner = owner; }
+    const std::shared_ptr<vespalib::compression::ZStdDictionary> & getCompressionDictionary() const {
+        return _compressionDictionary;
+    }
+    /**
+     * Returns copies of the blobs stored in the first chunks of the file, at least maxBytes
+     * in total if the file is that large. Used as samples when training compression dictionaries.
+     */
+    std::vector<vespalib::string> sampleBlobs(size_t maxBytes) const;
     virtual size_t updateLidMap(const unique_lock &guard, ISetLid &lidMap, uint64_t serialNum, uint32_t docIdLimit);
     virtual ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const;
     virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
@@ -236,9 +251,16 @@ protected:
 
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
-    void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    void read(LidInfoWithLidV::const_iterator begin, const std::vector<std::pair<size_t, size_t>> & groups,
+              const std::vector<ChunkInfo> & chunkInfos, IBufferVisitor & visitor) const;
+    std::shared_ptr<const Chunk> readChunk(SubChunkId chunkId, const ChunkInfo & chunkInfo) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static std::shared_ptr<vespalib::compression::ZStdDictionary>
+    readCompressionDictionary(FileRandRead &datFile, uint64_t dataHeaderLen);
+    static std::shared_ptr<vespalib::compression::ZStdDictionary>
+    readCompressionDictionary(const vespalib::GenericHeader &header, int compressionLevel);
+    static void writeCompressionDictionary(vespalib::GenericHeader &header, const vespalib::compression::ZStdDictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer   * _bucketizer;
@@ -253,6 +275,10 @@ protected:
     uint32_t              _numLids;
     uint32_t              _docIdLimit; // Limit when the file was created. Stored in idx file header.
     vespalib::system_time  _modificationTime;
+    docstore::ChunkCache * _chunkCache;
+    uint64_t               _chunkCacheOwner;
+    // Dictionary the chunks were compressed with, stored in the data file header.
+    std::shared_ptr<vespalib::compression::ZStdDictionary> _compressionDictionary;
 };
 
 } // namespace search
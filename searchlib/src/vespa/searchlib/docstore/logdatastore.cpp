@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "logdatastore.h"
+#include "chunkcache.h"
 #include "storebybucket.h"
 #include "compacter.h"
 #include <vespa/vespalib/data/fileheader.h>
@@ -10,6 +11,7 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <thread>
 #include <cassert>
 
@@ -35,6 +37,7 @@ using vespalib::IllegalStateException;
 using vespalib::getErrorString;
 using vespalib::getLastErrorString;
 using vespalib::make_string;
+using vespalib::compression::ZStdDictionary;
 
 using CpuCategory = CpuUsage::Category;
 
@@ -45,7 +48,9 @@ LogDataStore::Config::Config()
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
       _skipCrcOnRead(false),
       _compactCompression(CompressionConfig::LZ4),
-      _fileConfig()
+      _fileConfig(),
+      _chunkCache(),
+      _compressionDictionarySize(0)
 { }
 
 bool
@@ -55,7 +60,9 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
-            (_fileConfig == rhs._fileConfig);
+            (_fileConfig == rhs._fileConfig) &&
+            (_chunkCache == rhs._chunkCache) &&
+            (_compressionDictionarySize == rhs._compressionDictionarySize);
 }
 
 LogDataStore::LogDataStore(vespalib::Executor &executor, const vespalib::string &dirName, const Config &config,
@@ -78,7 +85,10 @@ LogDataStore::LogDataStore(vespalib::Executor &executor, const vespalib::string
       _tlSyncer(tlSyncer),
       _bucketizer(std::move(bucketizer)),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _chunkCache(config.getChunkCache()),
+      _chunkCacheOwner(_chunkCache ? _chunkCache->registerOwner() : 0),
+      _compressionDictionary()
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
@@ -452,7 +462,11 @@ void LogDataStore::compactFile(FileId fileId)
         size_t disk_bloat = fc->getDiskBloat();
         size_t compacted_size = (disk_footprint <= disk_bloat) ? 0u : (disk_footprint - disk_bloat);
         if ( ! shouldCompactToActiveFile(compacted_size)) {
+            auto dictionary = trainCompressionDictionary(*fc);
             MonitorGuard guard(_updateLock);
+            if (dictionary) {
+                _compressionDictionary = std::move(dictionary);
+            }
             destinationFileId = allocateFileId(guard);
             setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
         }
@@ -629,6 +643,7 @@ FileChunk::UP
 LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
     auto file = std::make_unique<FileChunk>(fileId, nameId, getBaseDir(), _tune,
                                             _bucketizer.get(), _config.crcOnReadDisabled());
+    file->setChunkCache(_chunkCache.get(), _chunkCacheOwner);
     file->enableRead();
     return file;
 }
@@ -646,7 +661,8 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
     auto file = std::make_unique< WriteableFileChunk>(_executor, fileId, nameId, getBaseDir(), serialNum,docIdLimit,
                                                       _config.getFileConfig(), _tune, _fileHeaderContext,
-                                                      _bucketizer.get(), _config.crcOnReadDisabled());
+                                                      _bucketizer.get(), _config.crcOnReadDisabled(), _compressionDictionary);
+    file->setChunkCache(_chunkCache.get(), _chunkCacheOwner);
     file->enableRead();
     return file;
 }
@@ -657,6 +673,29 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum)
     return createWritableFile(fileId, serialNum, NameId(vespalib::system_clock::now().time_since_epoch().count()));
 }
 
+std::shared_ptr<ZStdDictionary>
+LogDataStore::trainCompressionDictionary(const FileChunk & fc) const
+{
+    size_t dictionarySize = _config.getCompressionDictionarySize();
+    const CompressionConfig & compression = _config.getFileConfig().getCompression();
+    if ((dictionarySize == 0) || (compression.type != CompressionConfig::ZSTD)) {
+        return {};
+    }
+    // Zstd recommends around 100 times the dictionary size as training data.
+    std::vector<vespalib::string> blobs = fc.sampleBlobs(dictionarySize * 100);
+    std::vector<vespalib::ConstBufferRef> samples;
+    samples.reserve(blobs.size());
+    for (const auto & blob : blobs) {
+        samples.emplace_back(blob.data(), blob.size());
+    }
+    auto dictionary = ZStdDictionary::train(samples, dictionarySize, compression.compressionLevel);
+    if (dictionary) {
+        LOG(info, "Trained compression dictionary %u of %zu bytes from %zu documents in file '%s'",
+            dictionary->id(), dictionary->content().size(), blobs.size(), fc.getName().c_str());
+    }
+    return dictionary;
+}
+
 namespace {
 
 vespalib::string
@@ -789,6 +828,15 @@ LogDataStore::preload()
             throw vespalib::IllegalArgumentException(getBaseDir() + " does not have any summary data... And that is no good in readonly case.");
         }
     }
+    for (auto it = _fileChunks.rbegin(); it != _fileChunks.rend(); ++it) {
+        if (*it && (*it)->getCompressionDictionary()) {
+            const auto & dictionary = (*it)->getCompressionDictionary();
+            // Files opened read only do not know the compression level.
+            int level = _config.getFileConfig().getCompression().compressionLevel;
+            _compressionDictionary = std::make_shared<ZStdDictionary>(dictionary->content(), level);
+            break;
+        }
+    }
     _active = FileId(_fileChunks.size() - 1);
     _prevActive = _active.prev();
 }
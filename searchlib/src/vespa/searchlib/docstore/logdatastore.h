@@ -20,6 +20,7 @@
 namespace search {
 
 namespace common { class FileHeaderContext; }
+namespace docstore { class ChunkCache; }
 
 
 /**
@@ -62,6 +63,18 @@ public:
 
         const WriteableFileChunk::Config & getFileConfig() const { return _fileConfig; }
         Config & disableCrcOnRead(bool v) { _skipCrcOnRead = v; return *this;}
+        /**
+         * Cache of decompressed chunks, possibly shared with other stores.
+         * Only the cache given at construction time is used by the store.
+         */
+        Config & setChunkCache(std::shared_ptr<docstore::ChunkCache> v) { _chunkCache = std::move(v); return *this; }
+        const std::shared_ptr<docstore::ChunkCache> & getChunkCache() const { return _chunkCache; }
+        /**
+         * Max size of the zstd dictionary trained from the documents of a file when it is compacted.
+         * New files are compressed with the latest dictionary. 0 disables dictionary compression.
+         */
+        Config & setCompressionDictionarySize(size_t v) { _compressionDictionarySize = v; return *this; }
+        size_t getCompressionDictionarySize() const { return _compressionDictionarySize; }
 
         bool operator == (const Config &) const;
     private:
@@ -72,6 +85,8 @@ public:
         bool                        _skipCrcOnRead;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
+        std::shared_ptr<docstore::ChunkCache> _chunkCache;
+        size_t                      _compressionDictionarySize;
     };
 public:
     /**
@@ -188,6 +203,7 @@ private:
 
     void compactWorst(uint64_t syncToken, bool compactDiskBloat);
     void compactFile(FileId chunkId);
+    std::shared_ptr<vespalib::compression::ZStdDictionary> trainCompressionDictionary(const FileChunk & fc) const;
 
     typedef vespalib::RcuVector<uint64_t> LidInfoVector;
     typedef std::vector<FileChunk::UP> FileChunkVector;
@@ -269,6 +285,9 @@ private:
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    std::shared_ptr<docstore::ChunkCache>    _chunkCache;
+    uint64_t                                 _chunkCacheOwner;
+    std::shared_ptr<vespalib::compression::ZStdDictionary> _compressionDictionary;
 };
 
 } // namespace search
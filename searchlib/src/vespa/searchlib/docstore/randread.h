@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 class FastOS_FileInterface;
 
@@ -16,8 +17,27 @@ class FileRandRead
 {
 public:
     typedef std::shared_ptr<FastOS_FileInterface> FSP;
+    /**
+     * A single read in a batch. The result is placed in buffer, and keepAlive must be
+     * held for as long as the buffer content is used.
+     */
+    struct Request {
+        size_t                 offset;
+        size_t                 size;
+        vespalib::DataBuffer * buffer;
+        FSP                    keepAlive;
+    };
     virtual ~FileRandRead() { }
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Performs all the given reads. Implementations able to do asynchronous io will have
+     * all of them in flight at the same time, the default just reads them one by one.
+     */
+    virtual void readBatch(std::vector<Request> & requests) {
+        for (Request & request : requests) {
+            request.keepAlive = read(request.offset, *request.buffer, request.size);
+        }
+    }
     virtual int64_t getSize() = 0;
 };
 
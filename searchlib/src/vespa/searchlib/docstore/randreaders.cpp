@@ -3,13 +3,226 @@
 #include "randreaders.h"
 #include "summaryexceptions.h"
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/fastos/file.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SEARCH_DOCSTORE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.docstore.randreaders");
 
+using vespalib::IoException;
+using vespalib::make_string;
+
 namespace search {
 
+namespace {
+
+#ifdef SEARCH_DOCSTORE_IO_URING
+
+/**
+ * Minimal io_uring submission/completion ring used for batches of reads.
+ * Talks to the kernel directly so that there is no dependency on liburing.
+ */
+class Ring
+{
+public:
+    static constexpr unsigned ENTRIES = 64;
+    Ring();
+    Ring(const Ring &) = delete;
+    Ring & operator=(const Ring &) = delete;
+    ~Ring();
+    bool valid() const { return _fd >= 0; }
+    unsigned capacity() const { return _sqEntries; }
+    /**
+     * Reads requests [first, first + count) and waits for all of them to complete.
+     * results[i] is set to the number of bytes read for request i, or -errno.
+     * If the requests cannot be submitted, results[i] is left unchanged for the
+     * requests not submitted, and the caller must read them in another way.
+     */
+    void readAll(int fileFd, std::vector<FileRandRead::Request> & requests, size_t first, size_t count,
+                 std::vector<int> & results);
+private:
+    unsigned reap(std::vector<int> & results);
+    void waitFor(size_t submitted, size_t completed, std::vector<int> & results);
+    int                 _fd;
+    unsigned            _sqEntries;
+    void              * _sqPtr;
+    size_t              _sqSize;
+    void              * _cqPtr;
+    size_t              _cqSize;
+    io_uring_sqe      * _sqes;
+    size_t              _sqesSize;
+    unsigned          * _sqHead;
+    unsigned          * _sqTail;
+    unsigned            _sqMask;
+    unsigned          * _sqArray;
+    unsigned          * _cqHead;
+    unsigned          * _cqTail;
+    unsigned            _cqMask;
+    const io_uring_cqe * _cqes;
+};
+
+Ring::Ring()
+    : _fd(-1), _sqEntries(0),
+      _sqPtr(MAP_FAILED), _sqSize(0), _cqPtr(MAP_FAILED), _cqSize(0), _sqes(nullptr), _sqesSize(0),
+      _sqHead(nullptr), _sqTail(nullptr), _sqMask(0), _sqArray(nullptr),
+      _cqHead(nullptr), _cqTail(nullptr), _cqMask(0), _cqes(nullptr)
+{
+    io_uring_params params{};
+    int fd = syscall(__NR_io_uring_setup, ENTRIES, &params);
+    if (fd < 0) {
+        LOG(debug, "io_uring_setup failed: errno=%d", errno);
+        return;
+    }
+    _sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+    }
+    _sqPtr = mmap(nullptr, _sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (_sqPtr != MAP_FAILED) {
+        _cqPtr = singleMap
+            ? _sqPtr
+            : mmap(nullptr, _cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    }
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void * sqes = (_cqPtr != MAP_FAILED)
+        ? mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES)
+        : MAP_FAILED;
+    if (sqes == MAP_FAILED) {
+        LOG(debug, "mmap of io_uring rings failed: errno=%d", errno);
+        if (_cqPtr != MAP_FAILED && _cqPtr != _sqPtr) {
+            munmap(_cqPtr, _cqSize);
+        }
+        if (_sqPtr != MAP_FAILED) {
+            munmap(_sqPtr, _sqSize);
+        }
+        _sqPtr = _cqPtr = MAP_FAILED;
+        close(fd);
+        return;
+    }
+    char * sq = static_cast<char *>(_sqPtr);
+    char * cq = static_cast<char *>(_cqPtr);
+    _sqes = static_cast<io_uring_sqe *>(sqes);
+    _sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    _sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    _sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    _sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    _cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    _cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<const io_uring_cqe *>(cq + params.cq_off.cqes);
+    _sqEntries = params.sq_entries;
+    _fd = fd;
+}
+
+Ring::~Ring()
+{
+    if (valid()) {
+        munmap(_sqes, _sqesSize);
+        if (_cqPtr != _sqPtr) {
+            munmap(_cqPtr, _cqSize);
+        }
+        munmap(_sqPtr, _sqSize);
+        close(_fd);
+    }
+}
+
+unsigned
+Ring::reap(std::vector<int> & results)
+{
+    unsigned head = *_cqHead;
+    unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+    unsigned reaped = 0;
+    for (; head != tail; ++head, ++reaped) {
+        const io_uring_cqe & cqe = _cqes[head & _cqMask];
+        results[cqe.user_data] = cqe.res;
+    }
+    __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+void
+Ring::readAll(int fileFd, std::vector<FileRandRead::Request> & requests, size_t first, size_t count,
+              std::vector<int> & results)
+{
+    unsigned tail = *_sqTail;
+    for (size_t i(first); i < first + count; i++, tail++) {
+        const FileRandRead::Request & request = requests[i];
+        unsigned index = tail & _sqMask;
+        io_uring_sqe & sqe = _sqes[index];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fileFd;
+        sqe.off = request.offset;
+        sqe.addr = reinterpret_cast<uint64_t>(request.buffer->getFree());
+        sqe.len = std::min(request.size, size_t(INT_MAX));
+        sqe.user_data = i;
+        _sqArray[index] = index;
+    }
+    __atomic_store_n(_sqTail, tail, __ATOMIC_RELEASE);
+    unsigned firstTail = tail - count;
+    size_t completed = 0;
+    while (completed < count) {
+        unsigned toSubmit = tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        int ret = syscall(__NR_io_uring_enter, _fd, toSubmit, count - completed, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if ((ret < 0) && (errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY)) {
+            int error = errno;
+            // Take back the requests not yet consumed by the kernel, they are read with pread by the caller.
+            unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+            __atomic_store_n(_sqTail, head, __ATOMIC_RELEASE);
+            size_t submitted = head - firstTail;
+            LOG(warning, "io_uring_enter failed: errno=%d, %zu of %zu reads will be done with pread",
+                error, count - submitted, count);
+            completed += reap(results);
+            waitFor(submitted, completed, results);
+            return;
+        }
+        completed += reap(results);
+    }
+}
+
+void
+Ring::waitFor(size_t submitted, size_t completed, std::vector<int> & results)
+{
+    while (completed < submitted) {
+        int ret = syscall(__NR_io_uring_enter, _fd, 0, submitted - completed, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if ((ret < 0) && (errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY)) {
+            // The kernel may still be writing into the buffers, so there is no safe way to back out.
+            LOG_ABORT("io_uring_enter failed with reads in flight");
+        }
+        completed += reap(results);
+    }
+}
+
+Ring *
+getRing()
+{
+    thread_local std::unique_ptr<Ring> ring;
+    if ( ! ring) {
+        ring = std::make_unique<Ring>();
+    }
+    return ring->valid() ? ring.get() : nullptr;
+}
+
+#endif
+
+}
+
+
 DirectIORandRead::DirectIORandRead(const vespalib::string & fileName)
     : _file(std::make_unique<FastOS_File>(fileName.c_str())),
       _alignment(1),
@@ -167,4 +380,100 @@ NormalRandRead::getSize()
     return _file->GetSize();
 }
 
+UringRandRead::UringRandRead(const vespalib::string & fileName)
+    : _fileName(fileName),
+      _fd(::open(fileName.c_str(), O_RDONLY | O_CLOEXEC))
+{
+    if (_fd < 0) {
+        throw IoException(make_string("Failed opening data file '%s'", fileName.c_str()),
+                          IoException::getErrorType(errno), VESPA_STRLOC);
+    }
+}
+
+UringRandRead::~UringRandRead()
+{
+    ::close(_fd);
+}
+
+bool
+UringRandRead::isSupported()
+{
+#ifdef SEARCH_DOCSTORE_IO_URING
+    static const bool supported = Ring().valid();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void
+UringRandRead::preadFully(Request & request, size_t done)
+{
+    char * buf = static_cast<char *>(request.buffer->getFree());
+    while (done < request.size) {
+        ssize_t ret = ::pread(_fd, buf + done, request.size - done, request.offset + done);
+        if (ret > 0) {
+            done += ret;
+        } else if ((ret < 0) && (errno == EINTR)) {
+            continue;
+        } else {
+            throw IoException(make_string("Failed reading %zu bytes at offset %zu from '%s'",
+                                          request.size, request.offset, _fileName.c_str()),
+                              (ret < 0) ? IoException::getErrorType(errno) : IoException::CORRUPT_DATA,
+                              VESPA_STRLOC);
+        }
+    }
+}
+
+FileRandRead::FSP
+UringRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
+{
+    Request request{offset, sz, &buffer, FSP()};
+    buffer.clear();
+    buffer.ensureFree(sz);
+    preadFully(request, 0);
+    buffer.moveFreeToData(sz);
+    return FSP();
+}
+
+void
+UringRandRead::readBatch(std::vector<Request> & requests)
+{
+    for (Request & request : requests) {
+        request.buffer->clear();
+        request.buffer->ensureFree(request.size);
+    }
+    std::vector<int> results(requests.size(), 0);
+#ifdef SEARCH_DOCSTORE_IO_URING
+    Ring * ring = (requests.size() > 1) ? getRing() : nullptr;
+    if (ring != nullptr) {
+        for (size_t first(0); first < requests.size(); first += ring->capacity()) {
+            size_t count = std::min(size_t(ring->capacity()), requests.size() - first);
+            ring->readAll(_fd, requests, first, count, results);
+        }
+    }
+#endif
+    for (size_t i(0); i < requests.size(); i++) {
+        Request & request = requests[i];
+        // Short reads, errors and kernels without IORING_OP_READ are completed with pread.
+        size_t done = (results[i] > 0) ? std::min(size_t(results[i]), request.size) : 0;
+        if (done < request.size) {
+            preadFully(request, done);
+        }
+        request.buffer->moveFreeToData(request.size);
+        request.keepAlive = FSP();
+    }
+}
+
+int64_t
+UringRandRead::getSize()
+{
+    struct stat st;
+    if (fstat(_fd, &st) != 0) {
+        throw IoException(make_string("Failed to stat '%s'", _fileName.c_str()),
+                          IoException::getErrorType(errno), VESPA_STRLOC);
+    }
+    return st.st_size;
+}
+
 }
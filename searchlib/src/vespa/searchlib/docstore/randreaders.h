@@ -60,4 +60,24 @@ private:
     std::unique_ptr<FastOS_FileInterface>  _file;
 };
 
+/**
+ * Reads using io_uring, so that all reads in a batch are in flight at the same time.
+ * Each thread gets its own ring on first use. If io_uring is not available on the
+ * running kernel it falls back to plain pread.
+ */
+class UringRandRead : public FileRandRead
+{
+public:
+    UringRandRead(const vespalib::string & fileName);
+    ~UringRandRead() override;
+    FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void readBatch(std::vector<Request> & requests) override;
+    int64_t getSize() override;
+    static bool isSupported();
+private:
+    void preadFully(Request & request, size_t done);
+    vespalib::string _fileName;
+    int              _fd;
+};
+
 }
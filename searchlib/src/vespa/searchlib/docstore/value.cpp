@@ -83,4 +83,13 @@ Value::decompressed() const {
     return std::make_pair<vespalib::DataBuffer, bool>(std::move(uncompressed), crc == _uncompressedCrc);
 }
 
+std::pair<vespalib::ConstBufferRef, bool>
+Value::uncompressedRef() const {
+    if ((getCompression() != CompressionConfig::NONE) || empty()) {
+        return std::make_pair(vespalib::ConstBufferRef(), false);
+    }
+    uint64_t crc = XXH64(get(), size(), 0);
+    return std::make_pair(vespalib::ConstBufferRef(get(), size()), crc == _uncompressedCrc);
+}
+
 }
@@ -4,6 +4,7 @@
 
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/buffer.h>
 
 namespace search::docstore {
 
@@ -40,6 +41,11 @@ public:
     void set(vespalib::DataBuffer &&buf, ssize_t len);
 
     Result decompressed() const;
+    /**
+     * Reference to the serialized blob when it is kept uncompressed, or an empty
+     * reference otherwise. The bool tells whether the crc check passed.
+     */
+    std::pair<vespalib::ConstBufferRef, bool> uncompressedRef() const;
 
     size_t size() const { return _compressedSize; }
     size_t capacity() const { return _buf ? _buf->size() : 0; }
@@ -122,6 +122,10 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *> inputs,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -237,6 +241,23 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                                          vespalib::ConstArrayRef<const feature_t *>,
+                                          vespalib::ConstArrayRef<feature_t *> outputs)
+{
+    for (size_t i = 0; i < docids.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+        outputs[0][i] = __builtin_expect(attribute::isUndefined(v), false)
+                        ? attribute::getUndefined<feature_t>()
+                        : util::getAsFeature(v);
+    }
+    std::fill_n(outputs[1], docids.size(), 0.0); // weight
+    std::fill_n(outputs[2], docids.size(), 0.0); // contains
+    std::fill_n(outputs[3], docids.size(), 1.0); // count
+}
+
 template <typename BaseType>
 void
 ArrayAttributeExecutor<BaseType>::execute(uint32_t docId)
@@ -27,21 +27,6 @@ using fef::ITermFieldData;
 using fef::MatchDataDetails;
 using fef::objectstore::as_value;
 
-namespace {
-
-double
-get_inverse_document_frequency(const ITermFieldData& term_field,
-                               const fef::IQueryEnvironment& env,
-                               const ITermData& term)
-
-{
-    double fallback = Bm25Executor::calculate_inverse_document_frequency(term_field.get_matching_doc_count(),
-                                                                         term_field.get_total_doc_count());
-    return util::lookupSignificance(env, term, fallback);
-}
-
-}
-
 Bm25Executor::Bm25Executor(const fef::FieldInfo& field,
                            const fef::IQueryEnvironment& env,
                            double avg_field_length,
@@ -73,6 +58,17 @@ Bm25Executor::calculate_inverse_document_frequency(uint32_t matching_doc_count,
                          static_cast<double>(matching_doc_count + 0.5)));
 }
 
+double
+Bm25Executor::get_inverse_document_frequency(const ITermFieldData& term_field,
+                                             const fef::IQueryEnvironment& env,
+                                             const ITermData& term)
+
+{
+    double fallback = calculate_inverse_document_frequency(term_field.get_matching_doc_count(),
+                                                           term_field.get_total_doc_count());
+    return util::lookupSignificance(env, term, fallback);
+}
+
 void
 Bm25Executor::handle_bind_match_data(const fef::MatchData& match_data)
 {
@@ -100,9 +96,10 @@ Bm25Executor::execute(uint32_t doc_id)
 }
 
 bool
-Bm25Blueprint::lookup_param(const fef::Properties& props, const vespalib::string& param, double& result) const
+Bm25Blueprint::lookup_param(const fef::Properties& props, const vespalib::string& field_name,
+                            const vespalib::string& param, double& result)
 {
-    vespalib::string key = getBaseName() + "(" + _field->name() + ")." + param;
+    vespalib::string key = "bm25(" + field_name + ")." + param;
     auto value = props.lookup(key);
     if (value.found()) {
         try {
@@ -127,6 +124,16 @@ Bm25Blueprint::Bm25Blueprint()
 {
 }
 
+bool
+Bm25Blueprint::lookup_params(const fef::Properties& props, const vespalib::string& field_name,
+                             double& k1_param, double& b_param)
+{
+    k1_param = default_k1_param;
+    b_param = default_b_param;
+    return lookup_param(props, field_name, "k1", k1_param) &&
+           lookup_param(props, field_name, "b", b_param);
+}
+
 void
 Bm25Blueprint::visitDumpFeatures(const fef::IIndexEnvironment& env, fef::IDumpFeatureVisitor& visitor) const
 {
@@ -152,10 +159,7 @@ Bm25Blueprint::setup(const fef::IIndexEnvironment& env, const fef::ParameterList
     const auto& field_name = params[0].getValue();
     _field = env.getFieldByName(field_name);
 
-    if (!lookup_param(env.getProperties(), "k1", _k1_param)) {
-        return false;
-    }
-    if (!lookup_param(env.getProperties(), "b", _b_param)) {
+    if (!lookup_params(env.getProperties(), _field->name(), _k1_param, _b_param)) {
         return false;
     }
 
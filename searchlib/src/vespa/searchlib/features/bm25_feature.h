@@ -3,6 +3,8 @@
 #include <vespa/searchlib/fef/blueprint.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
 
+namespace search::fef { class ITermFieldData; }
+
 namespace search::features {
 
 /**
@@ -39,6 +41,9 @@ public:
                  double b_param);
 
     double static calculate_inverse_document_frequency(uint32_t matching_doc_count, uint32_t total_doc_count);
+    double static get_inverse_document_frequency(const fef::ITermFieldData& term_field,
+                                                 const fef::IQueryEnvironment& env,
+                                                 const fef::ITermData& term);
 
     void handle_bind_match_data(const fef::MatchData& match_data) override;
     void execute(uint32_t docId) override;
@@ -54,11 +59,19 @@ private:
     double _k1_param;
     double _b_param;
 
-    bool lookup_param(const fef::Properties& props, const vespalib::string& param, double& result) const;
+    static bool lookup_param(const fef::Properties& props, const vespalib::string& field_name,
+                             const vespalib::string& param, double& result);
 
 public:
     Bm25Blueprint();
 
+    /**
+     * Lookup the k1 and b params used for the given field.
+     * Returns false if a param is not a valid number.
+     */
+    static bool lookup_params(const fef::Properties& props, const vespalib::string& field_name,
+                              double& k1_param, double& b_param);
+
     void visitDumpFeatures(const fef::IIndexEnvironment& env, fef::IDumpFeatureVisitor& visitor) const override;
     fef::Blueprint::UP createInstance() const override;
     fef::ParameterDescriptions getDescriptions() const override {
@@ -230,6 +230,17 @@ void DotProductExecutorBase<BaseType>::execute(uint32_t docId) {
             &_queryVector[0], values.data(), commonRange));
 }
 
+template <typename BaseType>
+void DotProductExecutorBase<BaseType>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                                                     vespalib::ConstArrayRef<const feature_t *>,
+                                                     vespalib::ConstArrayRef<feature_t *> outputs) {
+    for (size_t i = 0; i < docids.size(); ++i) {
+        auto values = getAttributeValues(docids[i]);
+        size_t commonRange = std::min(values.size(), _queryVector.size());
+        outputs[0][i] = _multiplier.dotProduct(&_queryVector[0], values.data(), commonRange);
+    }
+}
+
 template <typename BaseType>
 DotProductByArrayReadViewExecutor<BaseType>::DotProductByArrayReadViewExecutor(const ArrayReadView* array_read_view, const V & queryVector) :
     DotProductExecutorBase<BaseType>(queryVector),
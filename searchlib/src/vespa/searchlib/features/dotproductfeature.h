@@ -175,6 +175,10 @@ public:
     DotProductExecutorBase(const V & queryVector);
     ~DotProductExecutorBase() override;
     void execute(uint32_t docId) final override;
+    bool supports_batch() const final override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *> inputs,
+                       vespalib::ConstArrayRef<feature_t *> outputs) final override;
 };
 
 /**
@@ -58,6 +58,10 @@ public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    bool supports_batch_inputs() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -76,6 +80,10 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    bool supports_batch_inputs() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -171,6 +179,18 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                                  ConstArrayRef<feature_t *> outputs)
+{
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][doc];
+        }
+        outputs[0][doc] = _forest.eval(*_ctx, &_params[0]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -195,6 +215,18 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                                                 ConstArrayRef<feature_t *> outputs)
+{
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][doc];
+        }
+        outputs[0][doc] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -2,6 +2,7 @@
 
 #include "featureexecutor.h"
 #include <vespa/vespalib/util/classname.h>
+#include <cstdlib>
 
 namespace search::fef {
 
@@ -20,6 +21,31 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+bool
+FeatureExecutor::supports_batch_inputs() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                               vespalib::ConstArrayRef<const feature_t *>,
+                               vespalib::ConstArrayRef<feature_t *> outputs)
+{
+    for (size_t i = 0; i < docids.size(); ++i) {
+        execute(docids[i]);
+        for (size_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
+            outputs[out_idx][i] = _outputs.get_number(out_idx);
+        }
+    }
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
@@ -150,6 +150,45 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor supports batch execution. A
+     * feature executor supporting batch execution must have numeric
+     * inputs and outputs, and its output values may not depend on
+     * match data, only on the docid and the input values.
+     *
+     * @return true if execute_batch may be called
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Check if the execute_batch implementation of this feature
+     * executor reads its inputs from the input columns. If not, the
+     * executor is only executed in a batch when all its inputs are
+     * constant, since inputs calculated in the same batch are not
+     * available through the per document inputs.
+     *
+     * @return true if execute_batch uses the input columns
+     **/
+    virtual bool supports_batch_inputs() const;
+
+    /**
+     * Execute this feature executor for a block of documents. Each
+     * input and output is a column with one value per document.
+     * Outputs bound to this executor may be overwritten. Only called
+     * if supports_batch returns true. The default implementation
+     * executes one document at a time and copies the bound outputs
+     * into the output columns, which is only correct for executors
+     * without inputs calculated in the same batch (see
+     * supports_batch_inputs).
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs one column per input feature
+     * @param outputs one column per output feature
+     **/
+    virtual void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                               vespalib::ConstArrayRef<const feature_t *> inputs,
+                               vespalib::ConstArrayRef<feature_t *> outputs);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
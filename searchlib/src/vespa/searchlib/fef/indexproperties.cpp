@@ -55,6 +55,16 @@ lookupUint32(const Properties &props, const vespalib::string &name, uint32_t def
     return defaultValue;
 }
 
+uint64_t
+lookupUint64(const Properties &props, const vespalib::string &name, uint64_t defaultValue)
+{
+    Property p = props.lookup(name);
+    if (p.found()) {
+        return strtoull(p.get().c_str(), nullptr, 0);
+    }
+    return defaultValue;
+}
+
 bool
 lookupBool(const Properties &props, const vespalib::string &name, bool defaultValue)
 {
@@ -366,6 +376,21 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string WorkStealingMinThreads::NAME("vespa.matching.work_stealing_min_threads");
+const uint32_t WorkStealingMinThreads::DEFAULT_VALUE(16);
+
+uint32_t
+WorkStealingMinThreads::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+WorkStealingMinThreads::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -413,6 +438,70 @@ GlobalFilterUpperLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string Bm25Pruning::NAME("vespa.matching.bm25_pruning");
+
+const bool Bm25Pruning::DEFAULT_VALUE(false);
+
+bool
+Bm25Pruning::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+Bm25Pruning::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string FilterCacheMaxBytes::NAME("vespa.matching.filter_cache.max_bytes");
+
+const uint64_t FilterCacheMaxBytes::DEFAULT_VALUE(0);
+
+uint64_t
+FilterCacheMaxBytes::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint64_t
+FilterCacheMaxBytes::lookup(const Properties &props, uint64_t defaultValue)
+{
+    return lookupUint64(props, NAME, defaultValue);
+}
+
+const vespalib::string CostBasedOrdering::NAME("vespa.matching.cost_based_ordering");
+
+const bool CostBasedOrdering::DEFAULT_VALUE(false);
+
+bool
+CostBasedOrdering::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+CostBasedOrdering::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string BatchRank::NAME("vespa.matching.batch_rank");
+
+const bool BatchRank::DEFAULT_VALUE(true);
+
+bool
+BatchRank::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+BatchRank::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -279,6 +279,19 @@ namespace matching {
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
 
+    /**
+     * Property for the minimum number of search threads for a query
+     * before the docid space is handed out by work stealing instead of
+     * the adaptive scheduler. Only used when the number of search
+     * partitions is 0. The value 0 disables work stealing.
+     **/
+    struct WorkStealingMinThreads {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
     /**
      * Property to control fallback to not building a global filter
      * for a query with a blueprint that wants a global filter. If the
@@ -306,6 +319,61 @@ namespace matching {
         static double lookup(const Properties &props);
         static double lookup(const Properties &props, double defaultValue);
     };
+
+    /**
+     * Property to enable pruning of documents that cannot be among the
+     * best hits when the query is an OR of terms and the first phase
+     * rank expression is a sum of bm25 features. Hits that are pruned
+     * are not counted in the total hit count. Not used when sorting,
+     * grouping or caching the search session.
+     **/
+    struct Bm25Pruning {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
+    /**
+     * Property to enable the cache of filter results shared between
+     * queries in the same document db, and to ask for its memory
+     * budget (in bytes). The cache uses the largest budget asked for
+     * by any rank profile. Filter subtrees searching only attributes
+     * are cached as bitvectors keyed on the attribute generations. A
+     * value of 0 disables the cache for the rank profile.
+     **/
+    struct FilterCacheMaxBytes {
+        static const vespalib::string NAME;
+        static const uint64_t DEFAULT_VALUE;
+        static uint64_t lookup(const Properties &props);
+        static uint64_t lookup(const Properties &props, uint64_t defaultValue);
+    };
+
+    /**
+     * Property to enable ordering of AND children by estimated hits
+     * times a relative cost measured by sampling the seek cost and
+     * hit ratio of query terms searching the same fields in earlier
+     * queries.
+     **/
+    struct CostBasedOrdering {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
+    /**
+     * Property to enable first phase ranking of matched documents in
+     * batches, when the first phase rank program supports it. The
+     * default value is true. Setting it to false makes every
+     * document be ranked on its own.
+     **/
+    struct BatchRank {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
 }
 
 namespace softtimeout {
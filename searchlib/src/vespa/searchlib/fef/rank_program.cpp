@@ -223,7 +223,10 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _cold_stash(),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_size(0),
+      _batch_steps(),
+      _batch_result(nullptr)
 {
 }
 
@@ -306,6 +309,97 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+bool
+RankProgram::prepare_batch(size_t batch_size)
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    const auto &seeds = _resolver->getSeedMap();
+    assert(_executors.size() == specs.size());
+    assert(_batch_result == nullptr);
+    if (seeds.size() != 1) {
+        return false;
+    }
+    auto seed = seeds.begin()->second;
+    if (specs[seed.executor].output_types[seed.output].is_object()) {
+        return false;
+    }
+    std::vector<bool> needed(specs.size(), false);
+    std::vector<uint32_t> todo;
+    auto need = [&](BlueprintResolver::FeatureRef ref) {
+        if (!needed[ref.executor] && !check_const(_executors[ref.executor]->outputs().get_raw(ref.output))) {
+            needed[ref.executor] = true;
+            todo.push_back(ref.executor);
+        }
+    };
+    need(seed);
+    while (!todo.empty()) {
+        uint32_t i = todo.back();
+        todo.pop_back();
+        if (!_executors[i]->supports_batch()) {
+            return false;
+        }
+        for (const auto &type: specs[i].output_types) {
+            if (type.is_object()) {
+                return false;
+            }
+        }
+        bool batch_inputs = _executors[i]->supports_batch_inputs();
+        for (const auto &ref: specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return false;
+            }
+            if (!batch_inputs && !check_const(_executors[ref.executor]->outputs().get_raw(ref.output))) {
+                return false;
+            }
+            need(ref);
+        }
+    }
+    // executors are ordered so that inputs are calculated before they are used
+    std::vector<feature_t *> columns(specs.size(), nullptr);
+    for (uint32_t i = 0; i < specs.size(); ++i) {
+        if (!needed[i]) {
+            continue;
+        }
+        size_t num_outputs = specs[i].output_types.size();
+        columns[i] = _hot_stash.create_array<feature_t>(num_outputs * batch_size).data();
+        auto outputs = _hot_stash.create_array<feature_t *>(num_outputs);
+        for (size_t out_idx = 0; out_idx < num_outputs; ++out_idx) {
+            outputs[out_idx] = columns[i] + (out_idx * batch_size);
+        }
+        auto inputs = _hot_stash.create_array<const feature_t *>(specs[i].inputs.size());
+        for (size_t in_idx = 0; in_idx < specs[i].inputs.size(); ++in_idx) {
+            auto ref = specs[i].inputs[in_idx];
+            const NumberOrObject *input_value = _executors[ref.executor]->outputs().get_raw(ref.output);
+            if (check_const(input_value)) {
+                inputs[in_idx] = _hot_stash.create_array<feature_t>(batch_size, input_value->as_number).data();
+            } else {
+                inputs[in_idx] = columns[ref.executor] + (ref.output * batch_size);
+            }
+        }
+        _batch_steps.push_back(BatchStep{_executors[i], inputs, outputs});
+    }
+    if (needed[seed.executor]) {
+        _batch_result = columns[seed.executor] + (seed.output * batch_size);
+    } else {
+        feature_t value = _executors[seed.executor]->outputs().get_number(seed.output);
+        _batch_result = _hot_stash.create_array<feature_t>(batch_size, value).data();
+    }
+    _batch_size = batch_size;
+    return true;
+}
+
+void
+RankProgram::execute_batch(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ArrayRef<feature_t> result)
+{
+    assert(_batch_result != nullptr);
+    assert(docids.size() <= _batch_size);
+    assert(result.size() >= docids.size());
+    for (const auto &step: _batch_steps) {
+        step.executor->execute_batch(docids, step.inputs, step.outputs);
+    }
+    std::copy(_batch_result, _batch_result + docids.size(), result.begin());
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
@@ -36,12 +36,21 @@ private:
     using ValueSet = vespalib::hash_set<const NumberOrObject *, vespalib::hash<const NumberOrObject *>,
                                         std::equal_to<>, vespalib::hashtable_base::and_modulator>;
 
+    struct BatchStep {
+        FeatureExecutor                            *executor;
+        vespalib::ConstArrayRef<const feature_t *>  inputs;
+        vespalib::ConstArrayRef<feature_t *>        outputs;
+    };
+
     BlueprintResolver::SP            _resolver;
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    size_t                           _batch_size;
+    std::vector<BatchStep>           _batch_steps;
+    const feature_t                 *_batch_result;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
@@ -91,6 +100,29 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    /**
+     * Prepare this rank program for calculating its seed feature for
+     * a block of documents at a time. The intermediate feature values
+     * are stored in columns with one value per document. This is only
+     * possible for programs with a single numeric seed, where all
+     * non-constant executors needed to calculate it support batch
+     * execution, and where executors that do not read input columns
+     * only have constant inputs. Must be called after setup.
+     *
+     * @return true if the program can be executed in batches
+     * @param batch_size max number of documents in each batch
+     **/
+    bool prepare_batch(size_t batch_size);
+
+    /**
+     * Calculate the seed feature for the given documents. May only be
+     * called after prepare_batch returned true.
+     *
+     * @param docids the documents to calculate, at most batch_size
+     * @param result receives one value per document
+     **/
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ArrayRef<feature_t> result);
 };
 
 }
@@ -40,6 +40,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
+      _workStealingMinThreads(0),
       _heapSize(0),
       _arraySize(0),
       _estimatePoint(0),
@@ -67,6 +68,10 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _softTimeoutFactor(0.5),
       _global_filter_lower_limit(0.0),
       _global_filter_upper_limit(1.0),
+      _bm25_pruning(false),
+      _filter_cache_max_bytes(0),
+      _cost_based_ordering(false),
+      _batch_rank(true),
       _mutateOnMatch(),
       _mutateOnFirstPhase(),
       _mutateOnSecondPhase(),
@@ -100,6 +105,7 @@ RankSetup::configure()
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    setWorkStealingMinThreads(matching::WorkStealingMinThreads::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -120,6 +126,10 @@ RankSetup::configure()
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
     set_global_filter_lower_limit(matching::GlobalFilterLowerLimit::lookup(_indexEnv.getProperties()));
     set_global_filter_upper_limit(matching::GlobalFilterUpperLimit::lookup(_indexEnv.getProperties()));
+    set_bm25_pruning(matching::Bm25Pruning::lookup(_indexEnv.getProperties()));
+    set_filter_cache_max_bytes(matching::FilterCacheMaxBytes::lookup(_indexEnv.getProperties()));
+    set_cost_based_ordering(matching::CostBasedOrdering::lookup(_indexEnv.getProperties()));
+    set_batch_rank(matching::BatchRank::lookup(_indexEnv.getProperties()));
     _mutateOnMatch._attribute = mutate::on_match::Attribute::lookup(_indexEnv.getProperties());
     _mutateOnMatch._operation = mutate::on_match::Operation::lookup(_indexEnv.getProperties());
     _mutateOnFirstPhase._attribute = mutate::on_first_phase::Attribute::lookup(_indexEnv.getProperties());
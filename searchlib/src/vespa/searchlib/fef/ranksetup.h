@@ -50,6 +50,7 @@ private:
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    uint32_t                 _workStealingMinThreads;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -77,6 +78,10 @@ private:
     double                   _softTimeoutFactor;
     double                   _global_filter_lower_limit;
     double                   _global_filter_upper_limit;
+    bool                     _bm25_pruning;
+    uint64_t                 _filter_cache_max_bytes;
+    bool                     _cost_based_ordering;
+    bool                     _batch_rank;
     MutateOperation          _mutateOnMatch;
     MutateOperation          _mutateOnFirstPhase;
     MutateOperation          _mutateOnSecondPhase;
@@ -182,6 +187,10 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    void setWorkStealingMinThreads(uint32_t workStealingMinThreads) { _workStealingMinThreads = workStealingMinThreads; }
+
+    uint32_t getWorkStealingMinThreads() const { return _workStealingMinThreads; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -408,6 +417,14 @@ public:
     double get_global_filter_lower_limit() const { return _global_filter_lower_limit; }
     void set_global_filter_upper_limit(double v) { _global_filter_upper_limit = v; }
     double get_global_filter_upper_limit() const { return _global_filter_upper_limit; }
+    void set_bm25_pruning(bool v) { _bm25_pruning = v; }
+    bool get_bm25_pruning() const { return _bm25_pruning; }
+    void set_filter_cache_max_bytes(uint64_t v) { _filter_cache_max_bytes = v; }
+    uint64_t get_filter_cache_max_bytes() const { return _filter_cache_max_bytes; }
+    void set_cost_based_ordering(bool v) { _cost_based_ordering = v; }
+    bool get_cost_based_ordering() const { return _cost_based_ordering; }
+    void set_batch_rank(bool v) { _batch_rank = v; }
+    bool get_batch_rank() const { return _batch_rank; }
 
     /**
      * This method may be used to indicate that certain features
@@ -17,6 +17,8 @@ struct ImpureValueExecutor : FeatureExecutor {
     double value;
     ImpureValueExecutor(double value_in) : value(value_in) {}
     void execute(uint32_t) override { outputs().set_number(0, value); }
+    // uses the default per document batch execution
+    bool supports_batch() const override { return true; }
 };
 
 bool
@@ -38,6 +40,15 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *>,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override
+    {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs[0][i] = docids[i];
+        }
+    }
 };
 
 bool
@@ -90,6 +101,8 @@ struct TrackingExecutor : FeatureExecutor {
         ++ext_cnt;
         outputs().set_number(0, inputs().get_number(0));
     }
+    // uses the default per document batch execution, without batched inputs
+    bool supports_batch() const override { return true; }
 };
 
 bool
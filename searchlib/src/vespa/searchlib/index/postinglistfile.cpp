@@ -2,6 +2,7 @@
 
 #include "postinglistfile.h"
 #include "postinglistparams.h"
+#include "docidandfeatures.h"
 #include <vespa/fastos/file.h>
 
 namespace search::index {
@@ -9,6 +10,16 @@ namespace search::index {
 PostingListFileSeqRead::PostingListFileSeqRead() = default;
 PostingListFileSeqRead::~PostingListFileSeqRead() = default;
 
+void
+PostingListFileSeqRead::skipWord(const PostingListCounts &counts)
+{
+    readCounts(counts);
+    DocIdAndFeatures features;
+    for (uint32_t i = 0; i < counts._numDocs; ++i) {
+        readDocIdAndFeatures(features);
+    }
+}
+
 void
 PostingListFileSeqRead::
 getParams(PostingListParams &params)
@@ -37,6 +48,18 @@ PostingListFileSeqWrite::PostingListFileSeqWrite()
 
 PostingListFileSeqWrite::~PostingListFileSeqWrite() = default;
 
+void
+PostingListFileSeqWrite::copyWord(PostingListFileSeqRead &source, const PostingListCounts &counts)
+{
+    source.readCounts(counts);
+    DocIdAndFeatures features;
+    for (uint32_t i = 0; i < counts._numDocs; ++i) {
+        source.readDocIdAndFeatures(features);
+        writeDocIdAndFeatures(features);
+    }
+    flushWord();
+}
+
 void
 PostingListFileSeqWrite::
 setParams(const PostingListParams &params)
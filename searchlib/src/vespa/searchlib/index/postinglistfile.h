@@ -36,6 +36,12 @@ public:
      */
     virtual void readCounts(const PostingListCounts &counts) = 0;
 
+    /**
+     * Skip the posting list for a word, instead of reading counts,
+     * document ids and features.
+     */
+    virtual void skipWord(const PostingListCounts &counts);
+
     /**
      * Open posting list file for sequential read.
      */
@@ -88,6 +94,15 @@ public:
      */
     virtual void flushWord() = 0;
 
+    /**
+     * Copy the posting list for a word from a posting list file using
+     * the same format and feature parameters, instead of writing
+     * document ids and features.  Counts are updated as if the word
+     * had been written and flushed.  The default implementation
+     * decodes and encodes all document ids and features.
+     */
+    virtual void copyWord(PostingListFileSeqRead &source, const PostingListCounts &counts);
+
     /**
      * Open posting list file for sequential write.
      */
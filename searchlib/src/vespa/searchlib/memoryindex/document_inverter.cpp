@@ -11,7 +11,9 @@
 #include <vespa/searchlib/common/schedule_sequenced_task_callback.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 #include <vespa/vespalib/util/retain_guard.h>
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 
 namespace search::memoryindex {
 
@@ -29,26 +31,37 @@ DocumentInverter::DocumentInverter(DocumentInverterContext& context)
 {
     auto& schema = context.get_schema();
     auto& field_indexes = context.get_field_indexes();
+    auto& schema_index_fields = context.get_schema_index_fields();
+    _inverters.resize(context.get_field_shards());
     for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
         auto &remover(field_indexes.get_remover(fieldId));
         auto &inserter(field_indexes.get_inserter(fieldId));
         auto &calculator(field_indexes.get_calculator(fieldId));
-        _inverters.push_back(std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator));
+        _inverters[0].push_back(std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator));
     }
-    auto& schema_index_fields = context.get_schema_index_fields();
+    for (uint32_t shard = 1; shard < _inverters.size(); ++shard) {
+        _inverters[shard].resize(schema.getNumIndexFields());
+        for (uint32_t fieldId : schema_index_fields._textFields) {
+            auto &remover(field_indexes.get_remover(fieldId));
+            auto &inserter(field_indexes.get_inserter(fieldId));
+            auto &calculator(field_indexes.get_calculator(fieldId));
+            _inverters[shard][fieldId] = std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator);
+        }
+    }
+    auto &inverters = _inverters[0];
     for (auto &urlField : schema_index_fields._uriFields) {
         Schema::CollectionType collectionType =
             schema.getIndexField(urlField._all).getCollectionType();
         _urlInverters.push_back(std::make_unique<UrlFieldInverter>
                                 (collectionType,
-                                 _inverters[urlField._all].get(),
-                                 _inverters[urlField._scheme].get(),
-                                 _inverters[urlField._host].get(),
-                                 _inverters[urlField._port].get(),
-                                 _inverters[urlField._path].get(),
-                                 _inverters[urlField._query].get(),
-                                 _inverters[urlField._fragment].get(),
-                                 _inverters[urlField._hostname].get()));
+                                 inverters[urlField._all].get(),
+                                 inverters[urlField._scheme].get(),
+                                 inverters[urlField._host].get(),
+                                 inverters[urlField._port].get(),
+                                 inverters[urlField._path].get(),
+                                 inverters[urlField._query].get(),
+                                 inverters[urlField._fragment].get(),
+                                 inverters[urlField._hostname].get()));
     }
 }
 
@@ -63,8 +76,11 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc, OnWriteDon
     auto& invert_threads = _context.get_invert_threads();
     auto& invert_contexts = _context.get_invert_contexts();
     for (auto& invert_context : invert_contexts) {
+        if (!invert_context.owns(docId)) {
+            continue;
+        }
         auto id = invert_context.get_id();
-        auto task = std::make_unique<InvertTask>(_context, invert_context, _inverters, _urlInverters, docId, doc, on_write_done);
+        auto task = std::make_unique<InvertTask>(_context, invert_context, _inverters[invert_context.get_shard()], _urlInverters, docId, doc, on_write_done);
         invert_threads.executeTask(id, std::move(task));
     }
 }
@@ -80,9 +96,19 @@ DocumentInverter::removeDocuments(LidVector lids)
 {
     auto& invert_threads = _context.get_invert_threads();
     auto& invert_contexts = _context.get_invert_contexts();
+    LidVector shard_lids;
     for (auto& invert_context : invert_contexts) {
         auto id = invert_context.get_id();
-        auto task = std::make_unique<RemoveTask>(invert_context, _inverters, _urlInverters, lids);
+        if (invert_context.is_sharded()) {
+            shard_lids.clear();
+            std::copy_if(lids.begin(), lids.end(), std::back_inserter(shard_lids),
+                         [&invert_context](uint32_t lid) { return invert_context.owns(lid); });
+            if (shard_lids.empty()) {
+                continue;
+            }
+        }
+        auto task = std::make_unique<RemoveTask>(invert_context, _inverters[invert_context.get_shard()], _urlInverters,
+                                                 invert_context.is_sharded() ? shard_lids : lids);
         invert_threads.executeTask(id, std::move(task));
     }
 }
@@ -96,7 +122,7 @@ DocumentInverter::pushDocuments(OnWriteDoneType on_write_done)
     auto& push_threads = _context.get_push_threads();
     auto& push_contexts = _context.get_push_contexts();
     for (auto& push_context : push_contexts) {
-        auto task = std::make_unique<PushTask>(push_context, _inverters, _urlInverters, on_write_done, retain);
+        auto task = std::make_unique<PushTask>(_context, push_context, _inverters, _urlInverters, on_write_done, retain);
         all_push_tasks.emplace_back(std::make_shared<ScheduleSequencedTaskCallback>(push_threads, push_context.get_id(), std::move(task)));
     }
     auto& invert_threads = _context.get_invert_threads();
@@ -29,6 +29,7 @@ class IFieldIndexCollection;
  * Class used to invert the fields for a set of documents, preparing for pushing changes info field indexes.
  *
  * Each text and uri field in the document is handled separately by a FieldInverter and UrlFieldInverter.
+ * With multiple field shards, each text field is handled by one FieldInverter per shard.
  */
 class DocumentInverter {
 private:
@@ -40,7 +41,9 @@ private:
     using LidVector = std::vector<uint32_t>;
     using OnWriteDoneType = const std::shared_ptr<vespalib::IDestructorCallback> &;
 
-    std::vector<std::unique_ptr<FieldInverter>> _inverters;
+    using FieldInverters = std::vector<std::unique_ptr<FieldInverter>>;
+
+    std::vector<FieldInverters>                    _inverters; // per shard
     std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
     vespalib::MonitoredRefCount                    _ref_count;
 
@@ -88,10 +91,14 @@ public:
     void removeDocuments(LidVector lids);
 
     FieldInverter *getInverter(uint32_t fieldId) const {
-        return _inverters[fieldId].get();
+        return _inverters[0][fieldId].get();
+    }
+
+    FieldInverter *getInverter(uint32_t fieldId, uint32_t shard) const {
+        return _inverters[shard][fieldId].get();
     }
 
-    uint32_t getNumFields() const { return _inverters.size(); }
+    uint32_t getNumFields() const { return _inverters[0].size(); }
     void wait_for_zero_ref_count() { _ref_count.waitForZeroRefCount(); }
     bool has_zero_ref_count() { return _ref_count.has_zero_ref_count(); }
     vespalib::MonitoredRefCount& get_ref_count() noexcept { return _ref_count; }
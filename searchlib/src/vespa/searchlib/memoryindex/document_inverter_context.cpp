@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_inverter_context.h"
+#include <algorithm>
 #include <cassert>
 #include <optional>
 
@@ -11,18 +12,24 @@ using index::SchemaIndexFields;
 
 namespace {
 
-template <typename Context>
-void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, std::vector<Context>& contexts)
+using ExecutorId = ISequencedTaskExecutor::ExecutorId;
+using IdMapping = std::vector<std::tuple<ExecutorId, bool, uint32_t>>;
+
+void add_text_fields(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, uint32_t shard, IdMapping& map)
 {
-    using ExecutorId = ISequencedTaskExecutor::ExecutorId;
-    using IdMapping = std::vector<std::tuple<ExecutorId, bool, uint32_t>>;
-    IdMapping map;
     for (uint32_t field_id : schema_index_fields._textFields) {
         // TODO: Add bias when sharing sequenced task executor between document types
         auto& name = schema.getIndexField(field_id).getName();
         auto id = executor.getExecutorIdFromName(name);
+        if (shard != 0) {
+            id = executor.get_alternate_executor_id(id, shard);
+        }
         map.emplace_back(id, false, field_id);
     }
+}
+
+void add_uri_fields(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, IdMapping& map)
+{
     uint32_t uri_field_id = 0;
     for (auto& uri_field : schema_index_fields._uriFields) {
         // TODO: Add bias when sharing sequenced task executor between document types
@@ -31,6 +38,11 @@ void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_
         map.emplace_back(id, true, uri_field_id);
         ++uri_field_id;
     }
+}
+
+template <typename Context>
+void make_contexts(IdMapping& map, std::vector<Context>& contexts)
+{
     std::sort(map.begin(), map.end());
     std::optional<ExecutorId> prev_id;
     for (auto& entry : map) {
@@ -46,6 +58,36 @@ void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_
     }
 }
 
+template <typename Context>
+void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, std::vector<Context>& contexts)
+{
+    IdMapping map;
+    add_text_fields(schema, schema_index_fields, executor, 0, map);
+    add_uri_fields(schema, schema_index_fields, executor, map);
+    make_contexts(map, contexts);
+}
+
+/*
+ * Make invert contexts where each shard of the text fields is handled
+ * by separate contexts, using alternate executor ids for all but the
+ * first shard. Uri fields are not sharded.
+ */
+void make_sharded_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, uint32_t field_shards, std::vector<InvertContext>& contexts)
+{
+    for (uint32_t shard = 0; shard < field_shards; ++shard) {
+        IdMapping map;
+        add_text_fields(schema, schema_index_fields, executor, shard, map);
+        size_t first = contexts.size();
+        make_contexts(map, contexts);
+        for (size_t i = first; i < contexts.size(); ++i) {
+            contexts[i].set_shard(shard, field_shards);
+        }
+    }
+    IdMapping map;
+    add_uri_fields(schema, schema_index_fields, executor, map);
+    make_contexts(map, contexts);
+}
+
 void switch_to_alternate_ids(ISequencedTaskExecutor& executor, std::vector<PushContext>& contexts, uint32_t bias)
 {
     for (auto& context : contexts) {
@@ -126,17 +168,23 @@ void connect_contexts(std::vector<InvertContext>& invert_contexts,
 DocumentInverterContext::DocumentInverterContext(const index::Schema& schema,
                                                  ISequencedTaskExecutor &invert_threads,
                                                  ISequencedTaskExecutor &push_threads,
-                                                 IFieldIndexCollection& field_indexes)
+                                                 IFieldIndexCollection& field_indexes,
+                                                 uint32_t field_shards)
     : _schema(schema),
       _schema_index_fields(),
       _invert_threads(invert_threads),
       _push_threads(push_threads),
       _field_indexes(field_indexes),
+      _field_shards(std::max(field_shards, 1u)),
       _invert_contexts(),
-      _push_contexts()
+      _push_contexts(),
+      _invert_latency(),
+      _push_latency()
 {
     _schema_index_fields.setup(schema);
     setup_contexts();
+    _invert_latency = std::vector<LatencyHistogram>(_invert_contexts.size());
+    _push_latency = std::vector<LatencyHistogram>(_push_contexts.size());
 }
 
 DocumentInverterContext::~DocumentInverterContext() = default;
@@ -144,7 +192,11 @@ DocumentInverterContext::~DocumentInverterContext() = default;
 void
 DocumentInverterContext::setup_contexts()
 {
-    make_contexts(_schema, _schema_index_fields, _invert_threads, _invert_contexts);
+    if (_field_shards > 1) {
+        make_sharded_contexts(_schema, _schema_index_fields, _invert_threads, _field_shards, _invert_contexts);
+    } else {
+        make_contexts(_schema, _schema_index_fields, _invert_threads, _invert_contexts);
+    }
     make_contexts(_schema, _schema_index_fields, _push_threads, _push_contexts);
     if (&_invert_threads == &_push_threads) {
         uint32_t bias = _schema_index_fields._textFields.size() + _schema_index_fields._uriFields.size();
@@ -153,4 +205,50 @@ DocumentInverterContext::setup_contexts()
     connect_contexts(_invert_contexts, _push_contexts, _schema.getNumIndexFields(), _schema_index_fields._uriFields.size());
 }
 
+bool
+DocumentInverterContext::handles_field(const BundledFieldsContext& context, uint32_t field_id) const noexcept
+{
+    auto& fields = context.get_fields();
+    if (std::find(fields.begin(), fields.end(), field_id) != fields.end()) {
+        return true;
+    }
+    auto& uri_fields = _schema_index_fields._uriFields;
+    for (auto uri_field_id : context.get_uri_fields()) {
+        if (uri_fields[uri_field_id]._all == field_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+FieldLatencyStats
+DocumentInverterContext::get_field_latency_stats(uint32_t field_id) const
+{
+    FieldLatencyStats result;
+    for (uint32_t i = 0; i < _invert_contexts.size(); ++i) {
+        if (handles_field(_invert_contexts[i], field_id)) {
+            result.invert.merge(_invert_latency[i].get_snapshot());
+        }
+    }
+    for (uint32_t i = 0; i < _push_contexts.size(); ++i) {
+        if (handles_field(_push_contexts[i], field_id)) {
+            result.push.merge(_push_latency[i].get_snapshot());
+        }
+    }
+    return result;
+}
+
+FieldLatencyStats
+DocumentInverterContext::get_latency_stats() const
+{
+    FieldLatencyStats result;
+    for (auto& latency : _invert_latency) {
+        result.invert.merge(latency.get_snapshot());
+    }
+    for (auto& latency : _push_latency) {
+        result.push.merge(latency.get_snapshot());
+    }
+    return result;
+}
+
 }
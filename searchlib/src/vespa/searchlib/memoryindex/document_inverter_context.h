@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/index/schema_index_fields.h>
+#include "field_latency_stats.h"
 #include "invert_context.h"
 #include "push_context.h"
 #include <memory>
@@ -15,6 +16,10 @@ class IFieldIndexCollection;
 /*
  * Class containing shared context for document inverters that changes
  * rarely (type dependent data, wiring).
+ *
+ * With more than one field shard, the documents for each text field are
+ * inverted by field_shards field inverters (using lid modulo field_shards),
+ * allowing a large field to be inverted by multiple invert threads.
  */
 class DocumentInverterContext {
     const index::Schema&              _schema;
@@ -22,22 +27,37 @@ class DocumentInverterContext {
     vespalib::ISequencedTaskExecutor& _invert_threads;
     vespalib::ISequencedTaskExecutor& _push_threads;
     IFieldIndexCollection&            _field_indexes;
+    uint32_t                          _field_shards;
     std::vector<InvertContext>        _invert_contexts;
     std::vector<PushContext>          _push_contexts;
+    // Updated by invert and push tasks, one histogram per context
+    mutable std::vector<LatencyHistogram> _invert_latency;
+    mutable std::vector<LatencyHistogram> _push_latency;
     void setup_contexts();
+    bool handles_field(const BundledFieldsContext& context, uint32_t field_id) const noexcept;
 public:
     DocumentInverterContext(const index::Schema &schema,
                             vespalib::ISequencedTaskExecutor &invert_threads,
                             vespalib::ISequencedTaskExecutor &push_threads,
-                            IFieldIndexCollection& field_indexes);
+                            IFieldIndexCollection& field_indexes,
+                            uint32_t field_shards = 1);
     ~DocumentInverterContext();
     const index::Schema& get_schema() const noexcept { return _schema; }
     const index::SchemaIndexFields& get_schema_index_fields() const noexcept { return _schema_index_fields; }
     vespalib::ISequencedTaskExecutor& get_invert_threads() noexcept { return _invert_threads; }
     vespalib::ISequencedTaskExecutor& get_push_threads() noexcept { return _push_threads; }
     IFieldIndexCollection& get_field_indexes() noexcept { return _field_indexes; }
+    uint32_t get_field_shards() const noexcept { return _field_shards; }
     const std::vector<InvertContext>& get_invert_contexts() const noexcept { return _invert_contexts; }
     const std::vector<PushContext>& get_push_contexts() const noexcept { return _push_contexts; }
+    LatencyHistogram& get_invert_latency(const InvertContext& context) const noexcept {
+        return _invert_latency[&context - _invert_contexts.data()];
+    }
+    LatencyHistogram& get_push_latency(const PushContext& context) const noexcept {
+        return _push_latency[&context - _push_contexts.data()];
+    }
+    FieldLatencyStats get_field_latency_stats(uint32_t field_id) const;
+    FieldLatencyStats get_latency_stats() const;
 };
 
 }
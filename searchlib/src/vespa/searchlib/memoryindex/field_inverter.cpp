@@ -173,6 +173,7 @@ FieldInverter::reset()
     _abortedDocs.clear();
     _removeDocs.clear();
     _oldPosSize = 0u;
+    _pushPos = 0u;
 }
 
 struct WordRefRadix {
@@ -301,7 +302,7 @@ FieldInverter::endDoc()
             ++itr;
         }
     }
-    _calculator.add_field_length(field_length);
+    _fieldLengths.push_back(field_length);
     uint32_t newPosSize = static_cast<uint32_t>(_positions.size());
     _pendingDocs.insert({ _docId, { _oldPosSize, newPosSize - _oldPosSize } });
     _docId = 0;
@@ -366,6 +367,8 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs(),
+      _fieldLengths(),
+      _pushPos(0u),
       _remover(remover),
       _inserter(inserter),
       _calculator(calculator)
@@ -514,14 +517,20 @@ FieldInverter::applyRemoves()
     _removeDocs.clear();
 }
 
-void
-FieldInverter::pushDocuments()
+bool
+FieldInverter::preparePush()
 {
+    // Field lengths are applied here since the calculator is shared by all inverters for the field.
+    for (auto field_length : _fieldLengths) {
+        _calculator.add_field_length(field_length);
+    }
+    _fieldLengths.clear();
+
     trimAbortedDocs();
 
     if (_positions.empty()) {
         reset();
-        return;             // All documents with words aborted
+        return false;       // All documents with words aborted
     }
 
     sortWords();
@@ -529,45 +538,34 @@ FieldInverter::pushDocuments()
     // Sort for terms.
     ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
         radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+    _pushPos = 0u;
+    return true;
+}
 
+void
+FieldInverter::pushWordDoc(IOrderedFieldIndexInserter &inserter)
+{
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
-    uint32_t lastWordNum = 0;
-    uint32_t lastElemId = 0;
-    uint32_t lastWordPos = 0;
-    uint32_t numWordIds = _wordRefs.size() - 1;
-    uint32_t lastDocId = 0;
-    vespalib::stringref word;
+    const uint32_t wordNum = _positions[_pushPos]._wordNum;
+    const uint32_t docId = _positions[_pushPos]._docId;
+    uint32_t lastElemId = NO_ELEMENT_ID;
+    uint32_t lastWordPos = NO_WORD_POS;
     bool emptyFeatures = true;
 
-    _inserter.rewind();
-
-    for (auto &i : _positions) {
-        assert(i._wordNum <= numWordIds);
-        (void) numWordIds;
-        if (lastWordNum != i._wordNum || lastDocId != i._docId) {
-            if (!emptyFeatures) {
-                _features.set_num_occs(_features.word_positions().size());
-                _inserter.add(lastDocId, _features);
-                emptyFeatures = true;
-            }
-            if (lastWordNum != i._wordNum) {
-                lastWordNum = i._wordNum;
-                word = getWordFromNum(lastWordNum);
-                _inserter.setNextWord(word);
-            }
-            lastDocId = i._docId;
-            if (i.removed()) {
-                _inserter.remove(lastDocId);
-                continue;
-            }
+    if (_positions[_pushPos].removed()) {
+        inserter.remove(docId);
+        ++_pushPos;
+    }
+    for (; _pushPos < _positions.size(); ++_pushPos) {
+        const PosInfo &i = _positions[_pushPos];
+        if (i._wordNum != wordNum || i._docId != docId) {
+            break;
         }
         if (emptyFeatures) {
             if (!i.removed()) {
                 emptyFeatures = false;
-                _features.clear(lastDocId);
-                lastElemId = NO_ELEMENT_ID;
-                lastWordPos = NO_WORD_POS;
+                _features.clear(docId);
                 const ElemInfo &elem = _elems[i._elemRef];
                 _features.set_field_length(elem.get_field_length());
             } else {
@@ -590,12 +588,62 @@ FieldInverter::pushDocuments()
 
     if (!emptyFeatures) {
         _features.set_num_occs(_features.word_positions().size());
-        _inserter.add(lastDocId, _features);
+        inserter.add(docId, _features);
     }
-    _inserter.flush();
-    _inserter.commit();
-    reset();
 }
 
+void
+FieldInverter::pushDocuments()
+{
+    pushDocuments(std::vector<FieldInverter *>{this});
 }
 
+void
+FieldInverter::pushDocuments(const std::vector<FieldInverter *> &inverters)
+{
+    std::vector<FieldInverter *> active;
+    for (auto inverter : inverters) {
+        if (inverter->preparePush()) {
+            active.push_back(inverter);
+        }
+    }
+    if (active.empty()) {
+        return;
+    }
+    // All inverters for a field share the same inserter.
+    IOrderedFieldIndexInserter &inserter = active.front()->_inserter;
+    auto prepared = active;
+    const char *lastWord = nullptr;
+
+    inserter.rewind();
+
+    while (!active.empty()) {
+        // Select the inverter with the lowest {word, docId} tuple.
+        size_t best = 0;
+        for (size_t i = 1; i < active.size(); ++i) {
+            int cmpres = strcmp(active[i]->pushWord(), active[best]->pushWord());
+            if (cmpres < 0 || (cmpres == 0 && active[i]->pushDocId() < active[best]->pushDocId())) {
+                best = i;
+            }
+        }
+        FieldInverter &next = *active[best];
+        const char *word = next.pushWord();
+        // Words are unique within a single inverter, thus pointer equality implies same word.
+        if (word != lastWord && (lastWord == nullptr || strcmp(word, lastWord) != 0)) {
+            inserter.setNextWord(word);
+            lastWord = word;
+        }
+        next.pushWordDoc(inserter);
+        if (next.pushDone()) {
+            active.erase(active.begin() + best);
+        }
+    }
+    inserter.flush();
+    inserter.commit();
+    // Reset after all tuples are pushed, since lastWord points into the word buffer of an inverter.
+    for (auto inverter : prepared) {
+        inverter->reset();
+    }
+}
+
+}
@@ -188,6 +188,8 @@ private:
     std::vector<PositionRange>                  _abortedDocs;
     vespalib::hash_map<uint32_t, PositionRange> _pendingDocs;
     UInt32Vector                                _removeDocs;
+    UInt32Vector                                _fieldLengths;  // applied to calculator when pushing
+    uint32_t                                    _pushPos;       // next position to push
 
     FieldIndexRemover                &_remover;
     IOrderedFieldIndexInserter       &_inserter;
@@ -279,6 +281,22 @@ private:
      */
     void abortPendingDoc(uint32_t docId);
 
+    /**
+     * Sort the current batch of inverted documents before pushing.
+     * Returns false if there is nothing to push.
+     */
+    bool preparePush();
+
+    bool pushDone() const { return _pushPos == _positions.size(); }
+    const char *pushWord() const { return getWordFromNum(_positions[_pushPos]._wordNum); }
+    uint32_t pushDocId() const { return _positions[_pushPos]._docId; }
+
+    /**
+     * Push the {word, docId} tuple at the current push position to the
+     * given inserter and step to the next tuple.
+     */
+    void pushWordDoc(IOrderedFieldIndexInserter &inserter);
+
 public:
     /**
      * Create a new field inverter for the given fieldId, using the given schema.
@@ -301,6 +319,15 @@ public:
      */
     void pushDocuments();
 
+    /**
+     * Push the current batch of inverted documents from a set of field
+     * inverters for the same field, merging their sorted {word, docId}
+     * tuples into a single pass over the FieldIndex.
+     *
+     * A document must only be inverted by one of the field inverters.
+     */
+    static void pushDocuments(const std::vector<FieldInverter *> &inverters);
+
     /**
      * Invert a normal text field, based on annotations.
      */
@@ -0,0 +1,119 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_latency_stats.h"
+#include <bit>
+
+namespace search::memoryindex {
+
+LatencyHistogram::Snapshot::Snapshot() noexcept
+    : count(0),
+      total(vespalib::duration::zero()),
+      buckets()
+{
+}
+
+LatencyHistogram::Snapshot&
+LatencyHistogram::Snapshot::merge(const Snapshot& rhs) noexcept
+{
+    count += rhs.count;
+    total += rhs.total;
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        buckets[i] += rhs.buckets[i];
+    }
+    return *this;
+}
+
+LatencyHistogram::Snapshot&
+LatencyHistogram::Snapshot::subtract(const Snapshot& older) noexcept
+{
+    // Clamp at zero, the counters are sampled individually
+    count = (count > older.count) ? (count - older.count) : 0;
+    total = (total > older.total) ? (total - older.total) : vespalib::duration::zero();
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        buckets[i] = (buckets[i] > older.buckets[i]) ? (buckets[i] - older.buckets[i]) : 0;
+    }
+    return *this;
+}
+
+vespalib::duration
+LatencyHistogram::Snapshot::quantile_limit(double quantile) const noexcept
+{
+    // Buckets are sampled individually and might not add up to count.
+    uint64_t bucket_count = 0;
+    for (auto bucket_size : buckets) {
+        bucket_count += bucket_size;
+    }
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        seen += buckets[i];
+        if (seen > 0 && seen >= quantile * bucket_count) {
+            return bucket_limit(i);
+        }
+    }
+    return vespalib::duration::zero();
+}
+
+LatencyHistogram::LatencyHistogram() noexcept
+    : _count(0),
+      _total_ns(0),
+      _buckets()
+{
+    for (auto& bucket : _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+uint32_t
+LatencyHistogram::bucket(vespalib::duration latency) noexcept
+{
+    int64_t us = vespalib::count_us(latency);
+    if (us <= 0) {
+        return 0;
+    }
+    uint32_t result = std::bit_width(static_cast<uint64_t>(us));
+    return (result < num_buckets) ? result : (num_buckets - 1);
+}
+
+vespalib::duration
+LatencyHistogram::bucket_limit(uint32_t bucket) noexcept
+{
+    return std::chrono::microseconds(uint64_t(1) << bucket);
+}
+
+void
+LatencyHistogram::add(vespalib::duration latency) noexcept
+{
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _total_ns.fetch_add(vespalib::count_ns(latency), std::memory_order_relaxed);
+    _buckets[bucket(latency)].fetch_add(1, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot
+LatencyHistogram::get_snapshot() const noexcept
+{
+    Snapshot result;
+    result.count = _count.load(std::memory_order_relaxed);
+    result.total = vespalib::duration(_total_ns.load(std::memory_order_relaxed));
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        result.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+FieldLatencyStats::FieldLatencyStats() noexcept
+    : invert(),
+      push()
+{
+}
+
+FieldLatencyStats&
+FieldLatencyStats::merge(const FieldLatencyStats& rhs) noexcept
+{
+    invert.merge(rhs.invert);
+    push.merge(rhs.push);
+    return *this;
+}
+
+}
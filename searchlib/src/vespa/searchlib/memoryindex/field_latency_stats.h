@@ -0,0 +1,73 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace search::memoryindex {
+
+/*
+ * Histogram of latencies with power of 2 microsecond buckets.
+ * Bucket 0 counts latencies below 1us, bucket i counts latencies
+ * in the range [2^(i-1), 2^i) us and the last bucket also counts
+ * all larger latencies.
+ *
+ * Can be updated by multiple threads while being sampled.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t num_buckets = 24;
+
+    struct Snapshot {
+        uint64_t                           count;
+        vespalib::duration                 total;
+        std::array<uint64_t, num_buckets>  buckets;
+
+        Snapshot() noexcept;
+        Snapshot& merge(const Snapshot& rhs) noexcept;
+        /*
+         * Removes the samples in an older snapshot of the same histogram,
+         * giving the samples added since then.
+         */
+        Snapshot& subtract(const Snapshot& older) noexcept;
+        /*
+         * Returns the upper latency limit of the bucket containing the given
+         * quantile, e.g. 0.99 for the 99th percentile.
+         */
+        vespalib::duration quantile_limit(double quantile) const noexcept;
+    };
+
+private:
+    std::atomic<uint64_t>                           _count;
+    std::atomic<uint64_t>                           _total_ns;
+    std::array<std::atomic<uint64_t>, num_buckets>  _buckets;
+
+public:
+    LatencyHistogram() noexcept;
+    ~LatencyHistogram();
+    static uint32_t bucket(vespalib::duration latency) noexcept;
+    static vespalib::duration bucket_limit(uint32_t bucket) noexcept;
+    void add(vespalib::duration latency) noexcept;
+    Snapshot get_snapshot() const noexcept;
+};
+
+/*
+ * Latencies for inverting and pushing a field in a memory index.
+ *
+ * Latencies are sampled once per invert task (one document) and once
+ * per push task (a batch of documents). A task handles all fields
+ * bundled in the same invert or push context, thus the latency of a
+ * field includes the time spent on the other fields in its context.
+ */
+struct FieldLatencyStats {
+    LatencyHistogram::Snapshot invert;
+    LatencyHistogram::Snapshot push;
+
+    FieldLatencyStats() noexcept;
+    FieldLatencyStats& merge(const FieldLatencyStats& rhs) noexcept;
+};
+
+}
@@ -39,6 +39,8 @@ get_field(const DocumentType& doc_type, const vespalib::string& name)
 InvertContext::InvertContext(vespalib::ISequencedTaskExecutor::ExecutorId id)
     : BundledFieldsContext(id),
       _pushers(),
+      _shard(0),
+      _num_shards(1),
       _document_fields(),
       _document_uri_fields(),
       _data_type(nullptr)
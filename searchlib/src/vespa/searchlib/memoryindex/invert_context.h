@@ -27,11 +27,16 @@ class DocumentInverterContext;
  * It is also used by DocumentInverter::pushDocuments() to execute
  * PushTask at the proper time (i.e. when all related InvertTask /
  * RemoveTask operations have completed).
+ *
+ * A sharded context only handles the documents belonging to its shard,
+ * using the field inverters for that shard.
  */
 class InvertContext : public BundledFieldsContext
 {
     using IndexedFields = std::vector<std::unique_ptr<const document::Field>>;
     std::vector<uint32_t> _pushers;
+    uint32_t              _shard;
+    uint32_t              _num_shards;
     vespalib::string      _document_field_names;
     mutable IndexedFields _document_fields;
     mutable IndexedFields _document_uri_fields;
@@ -42,6 +47,13 @@ public:
     ~InvertContext();
     InvertContext(InvertContext&&);
     const std::vector<uint32_t>& get_pushers() const noexcept { return _pushers; }
+    void set_shard(uint32_t shard, uint32_t num_shards) noexcept {
+        _shard = shard;
+        _num_shards = num_shards;
+    }
+    uint32_t get_shard() const noexcept { return _shard; }
+    bool is_sharded() const noexcept { return _num_shards > 1; }
+    bool owns(uint32_t lid) const noexcept { return _num_shards <= 1 || (lid % _num_shards) == _shard; }
     void set_data_type(const DocumentInverterContext& doc_inv_context, const document::Document& doc) const;
     const IndexedFields& get_document_fields() const noexcept { return _document_fields; }
     const IndexedFields& get_document_uri_fields() const noexcept { return _document_uri_fields; }
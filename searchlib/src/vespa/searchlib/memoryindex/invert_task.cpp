@@ -41,6 +41,7 @@ InvertTask::~InvertTask() = default;
 void
 InvertTask::run()
 {
+    auto start = vespalib::steady_clock::now();
     _context.set_data_type(_inv_context, _doc);
     auto document_field_itr = _context.get_document_fields().begin();
     for (auto field_id : _context.get_fields()) {
@@ -52,6 +53,7 @@ InvertTask::run()
         _uri_inverters[uri_field_id]->invertField(_lid, get_field_value(_doc, *document_uri_field_itr));
         ++document_uri_field_itr;
     }
+    _inv_context.get_invert_latency(_context).add(vespalib::steady_clock::now() - start);
 }
 
 }
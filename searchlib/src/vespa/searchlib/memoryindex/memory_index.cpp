@@ -55,12 +55,13 @@ namespace search::memoryindex {
 MemoryIndex::MemoryIndex(const Schema& schema,
                          const IFieldLengthInspector& inspector,
                          ISequencedTaskExecutor& invertThreads,
-                         ISequencedTaskExecutor& pushThreads)
+                         ISequencedTaskExecutor& pushThreads,
+                         uint32_t fieldInverterShards)
     : _schema(schema),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads),
       _fieldIndexes(std::make_unique<FieldIndexCollection>(_schema, inspector)),
-      _inverter_context(std::make_unique<DocumentInverterContext>(_schema, _invertThreads, _pushThreads, *_fieldIndexes)),
+      _inverter_context(std::make_unique<DocumentInverterContext>(_schema, _invertThreads, _pushThreads, *_fieldIndexes, fieldInverterShards)),
       _inverters(std::make_unique<DocumentInverterCollection>(*_inverter_context, 4)),
       _frozen(false),
       _maxDocId(0), // docId 0 is reserved
@@ -251,4 +252,20 @@ MemoryIndex::get_field_length_info(const vespalib::string& field_name) const
     return FieldLengthInfo();
 }
 
+FieldLatencyStats
+MemoryIndex::get_field_latency_stats(const vespalib::string& field_name) const
+{
+    uint32_t field_id = _schema.getIndexFieldId(field_name);
+    if (field_id != Schema::UNKNOWN_FIELD_ID) {
+        return _inverter_context->get_field_latency_stats(field_id);
+    }
+    return FieldLatencyStats();
+}
+
+FieldLatencyStats
+MemoryIndex::get_latency_stats() const
+{
+    return _inverter_context->get_latency_stats();
+}
+
 }
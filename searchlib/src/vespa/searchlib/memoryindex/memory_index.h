@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "field_latency_stats.h"
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/searchlib/index/field_length_info.h>
@@ -89,11 +90,14 @@ public:
      * @param invertThreads the executor with threads for doing document inverting.
      * @param pushThreads   the executor with threads for doing pushing of changes (inverted documents)
      *                      to corresponding field indexes.
+     * @param fieldInverterShards the number of field inverters used to invert each text field,
+     *                      allowing a single large field to be inverted by multiple threads.
      */
     MemoryIndex(const index::Schema& schema,
                 const index::IFieldLengthInspector& inspector,
                 ISequencedTaskExecutor& invertThreads,
-                ISequencedTaskExecutor& pushThreads);
+                ISequencedTaskExecutor& pushThreads,
+                uint32_t fieldInverterShards = 1);
 
     MemoryIndex(const MemoryIndex &) = delete;
     MemoryIndex(MemoryIndex &&) = delete;
@@ -175,6 +179,16 @@ public:
     uint64_t getStaticMemoryFootprint() const { return _staticMemoryFootprint; }
 
     index::FieldLengthInfo get_field_length_info(const vespalib::string& field_name) const;
+
+    /**
+     * Gets the latencies of the invert and push tasks handling the given field.
+     */
+    FieldLatencyStats get_field_latency_stats(const vespalib::string& field_name) const;
+
+    /**
+     * Gets the latencies of all invert and push tasks.
+     */
+    FieldLatencyStats get_latency_stats() const;
 };
 
 }
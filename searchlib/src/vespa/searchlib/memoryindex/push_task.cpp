@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "push_task.h"
+#include "document_inverter_context.h"
 #include "push_context.h"
 #include "field_inverter.h"
 #include "url_field_inverter.h"
@@ -16,11 +17,23 @@ void push_inverter(Inverter& inverter)
     inverter.pushDocuments();
 }
 
+void push_sharded_inverters(const std::vector<std::vector<std::unique_ptr<FieldInverter>>>& inverters, uint32_t field_id)
+{
+    std::vector<FieldInverter*> shards;
+    for (auto& shard_inverters : inverters) {
+        auto& inverter = *shard_inverters[field_id];
+        inverter.applyRemoves();
+        shards.emplace_back(&inverter);
+    }
+    FieldInverter::pushDocuments(shards);
+}
+
 }
 
 
-PushTask::PushTask(const PushContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, OnWriteDoneType on_write_done, std::shared_ptr<vespalib::RetainGuard> retain)
-    : _context(context),
+PushTask::PushTask(const DocumentInverterContext& inv_context, const PushContext& context, const std::vector<FieldInverters>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, OnWriteDoneType on_write_done, std::shared_ptr<vespalib::RetainGuard> retain)
+    : _inv_context(inv_context),
+      _context(context),
       _inverters(inverters),
       _uri_inverters(uri_inverters),
       _on_write_done(on_write_done),
@@ -33,12 +46,18 @@ PushTask::~PushTask() = default;
 void
 PushTask::run()
 {
+    auto start = vespalib::steady_clock::now();
     for (auto field_id : _context.get_fields()) {
-        push_inverter(*_inverters[field_id]);
+        if (_inverters.size() > 1) {
+            push_sharded_inverters(_inverters, field_id);
+        } else {
+            push_inverter(*_inverters[0][field_id]);
+        }
     }
     for (auto uri_field_id : _context.get_uri_fields()) {
         push_inverter(*_uri_inverters[uri_field_id]);
     }
+    _inv_context.get_push_latency(_context).add(vespalib::steady_clock::now() - start);
 }
 
 }
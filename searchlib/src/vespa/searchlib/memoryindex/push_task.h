@@ -12,24 +12,28 @@ class RetainGuard;
 
 namespace search::memoryindex {
 
+class DocumentInverterContext;
 class FieldInverter;
 class PushContext;
 class UrlFieldInverter;
 
 /*
  * Task to push inverted data from a set of field inverters and uri
- * field inverters to to memory index structure.
+ * field inverters to to memory index structure. The field inverters
+ * for all shards of a text field are pushed in a single merged pass.
  */
 class PushTask : public vespalib::Executor::Task
 {
     using OnWriteDoneType = const std::shared_ptr<vespalib::IDestructorCallback> &;
+    using FieldInverters = std::vector<std::unique_ptr<FieldInverter>>;
+    const DocumentInverterContext&                        _inv_context;
     const PushContext&                                    _context;
-    const std::vector<std::unique_ptr<FieldInverter>>&    _inverters;
+    const std::vector<FieldInverters>&                    _inverters;
     const std::vector<std::unique_ptr<UrlFieldInverter>>& _uri_inverters;
     std::remove_reference_t<OnWriteDoneType>              _on_write_done;
     std::shared_ptr<vespalib::RetainGuard>                _retain;
 public:
-    PushTask(const PushContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, OnWriteDoneType on_write_done, std::shared_ptr<vespalib::RetainGuard> retain);
+    PushTask(const DocumentInverterContext& inv_context, const PushContext& context, const std::vector<FieldInverters>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, OnWriteDoneType on_write_done, std::shared_ptr<vespalib::RetainGuard> retain);
     ~PushTask() override;
     void run() override;
 };
@@ -87,6 +87,7 @@ Blueprint::sat_sum(const std::vector<HitEstimate> &data, uint32_t docid_limit)
 Blueprint::State::State(const FieldSpecBaseList &fields_in)
     : _fields(fields_in),
       _estimate(),
+      _cost(1.0),
       _cost_tier(COST_TIER_NORMAL),
       _tree_size(1),
       _allow_termwise_eval(true),
@@ -232,6 +233,7 @@ Blueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
     visitor.openStruct("estimate", "HitEstimate");
     visitor.visitBool("empty", state.estimate().empty);
     visitor.visitInt("estHits", state.estimate().estHits);
+    visitor.visitFloat("cost", state.cost());
     visitor.visitInt("cost_tier", state.cost_tier());
     visitor.visitInt("tree_size", state.tree_size());
     visitor.visitInt("allow_termwise_eval", state.allow_termwise_eval());
@@ -291,6 +293,19 @@ IntermediateBlueprint::calculateEstimate() const
     return combine(estimates);
 }
 
+double
+IntermediateBlueprint::calculate_cost() const
+{
+    if (_children.empty()) {
+        return 1.0;
+    }
+    double cost = 0.0;
+    for (const Blueprint * child : _children) {
+        cost = std::max(cost, child->getState().cost());
+    }
+    return cost;
+}
+
 uint32_t
 IntermediateBlueprint::calculate_cost_tier() const
 {
@@ -398,6 +413,7 @@ IntermediateBlueprint::calculateState() const
 {
     State state(exposeFields());
     state.estimate(calculateEstimate());
+    state.cost(calculate_cost());
     state.cost_tier(calculate_cost_tier());
     state.allow_termwise_eval(infer_allow_termwise_eval());
     state.want_global_filter(infer_want_global_filter());
@@ -638,6 +654,13 @@ LeafBlueprint::setEstimate(HitEstimate est)
     notifyChange();
 }
 
+void
+LeafBlueprint::set_cost(double value)
+{
+    _state.cost(value);
+    notifyChange();
+}
+
 void
 LeafBlueprint::set_cost_tier(uint32_t value)
 {
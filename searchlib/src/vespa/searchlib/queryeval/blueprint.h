@@ -65,6 +65,7 @@ public:
     private:
         FieldSpecBaseList _fields;
         HitEstimate       _estimate;
+        double            _cost;
         uint32_t          _cost_tier;
         uint32_t          _tree_size;
         bool              _allow_termwise_eval;
@@ -103,6 +104,10 @@ public:
             uint32_t total_docs = std::max(total_hits, docid_limit);
             return (total_docs == 0) ? 0.0 : double(total_hits) / double(total_docs);
         }
+        // relative cost of matching compared to blueprints with the same estimate
+        void cost(double value) { _cost = value; }
+        double cost() const { return _cost; }
+        double estimated_cost() const { return (double(_estimate.estHits) * _cost); }
         void tree_size(uint32_t value) { _tree_size = value; }
         uint32_t tree_size() const { return _tree_size; }
         void allow_termwise_eval(bool value) { _allow_termwise_eval = value; }
@@ -137,6 +142,21 @@ public:
         }
     };
 
+    // utility to get the lesser estimated cost to sort first, higher tiers last
+    struct TieredLessEstimatedCost {
+        bool operator () (Blueprint * const &a, const Blueprint * const &b) const {
+            const auto &lhs = a->getState();
+            const auto &rhs = b->getState();
+            if (lhs.cost_tier() != rhs.cost_tier()) {
+                return (lhs.cost_tier() < rhs.cost_tier());
+            }
+            if (lhs.estimate().empty != rhs.estimate().empty) {
+                return lhs.estimate().empty;
+            }
+            return (lhs.estimated_cost() < rhs.estimated_cost());
+        }
+    };
+
     // utility to get the lesser estimate to sort first, higher tiers last
     struct TieredLessEstimate {
         bool operator () (Blueprint * const &a, const Blueprint * const &b) const {
@@ -283,6 +303,7 @@ public:
 private:
     Children _children;
     HitEstimate calculateEstimate() const;
+    double calculate_cost() const;
     uint32_t calculate_cost_tier() const;
     uint32_t calculate_tree_size() const;
     bool infer_allow_termwise_eval() const;
@@ -358,6 +379,8 @@ public:
     ~LeafBlueprint() override;
     const State &getState() const final { return _state; }
     void setDocIdLimit(uint32_t limit) final { Blueprint::setDocIdLimit(limit); }
+    // used to adjust the ordering of this blueprint based on measured statistics
+    void set_cost(double value);
     void fetchPostings(const ExecuteInfo &execInfo) override;
     void freeze() final;
     SearchIteratorUP createSearch(fef::MatchData &md, bool strict) const override;
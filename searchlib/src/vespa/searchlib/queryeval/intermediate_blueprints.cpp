@@ -10,6 +10,7 @@
 #include "termwise_blueprint_helper.h"
 #include "isourceselector.h"
 #include "field_spec.hpp"
+#include <vespa/searchlib/queryeval/wand/bm25_pruning_or_search.h>
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
 
 namespace search::queryeval {
@@ -250,7 +251,7 @@ AndBlueprint::get_replacement()
 void
 AndBlueprint::sort(std::vector<Blueprint*> &children) const
 {
-    std::sort(children.begin(), children.end(), TieredLessEstimate());
+    std::sort(children.begin(), children.end(), TieredLessEstimatedCost());
 }
 
 bool
@@ -296,6 +297,12 @@ AndBlueprint::computeNextHitRate(const Blueprint & child, double hitRate) const
 
 //-----------------------------------------------------------------------------
 
+OrBlueprint::OrBlueprint()
+    : IntermediateBlueprint(),
+      _bm25_pruning()
+{
+}
+
 OrBlueprint::~OrBlueprint() = default;
 
 Blueprint::HitEstimate
@@ -350,10 +357,52 @@ OrBlueprint::inheritStrict(size_t) const
     return true;
 }
 
+bool
+OrBlueprint::can_use_bm25_pruning(bool strict) const
+{
+    if (!_bm25_pruning || !strict) {
+        return false;
+    }
+    for (const auto &term_field : _bm25_pruning->get_term_fields()) {
+        bool found = false;
+        for (size_t i = 0; !found && (i < childCnt()); ++i) {
+            const State &child_state = getChild(i).getState();
+            for (size_t j = 0; !found && (j < child_state.numFields()); ++j) {
+                found = (child_state.field(j).getHandle() == term_field.handle);
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SearchIterator::UP
+OrBlueprint::create_bm25_pruning_search(MultiSearch::Children sub_searches, fef::MatchData &md) const
+{
+    Bm25PruningOrSearch::Children children;
+    children.reserve(sub_searches.size());
+    for (size_t i = 0; i < sub_searches.size(); ++i) {
+        const State &child_state = getChild(i).getState();
+        children.emplace_back(std::move(sub_searches[i]), child_state.estimate().estHits);
+        for (size_t j = 0; j < child_state.numFields(); ++j) {
+            const auto *params = _bm25_pruning->lookup(child_state.field(j).getHandle());
+            if (params != nullptr) {
+                children.back().fields.push_back({params, child_state.field(j).resolve(md)});
+            }
+        }
+    }
+    return Bm25PruningOrSearch::create(std::move(children), *_bm25_pruning, get_docid_limit());
+}
+
 SearchIterator::UP
 OrBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                       bool strict, search::fef::MatchData & md) const
 {
+    if (can_use_bm25_pruning(strict)) {
+        return create_bm25_pruning_search(std::move(sub_searches), md);
+    }
     UnpackInfo unpack_info(calculateUnpackInfo(md));
     if (should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
         TermwiseBlueprintHelper helper(*this, std::move(sub_searches), unpack_info);
@@ -383,6 +432,13 @@ OrBlueprint::createFilterSearch(bool strict, FilterConstraint constraint) const
     return OrSearch::create(std::move(sub_searches), strict, unpack_info);
 }
 
+bool
+OrBlueprint::set_bm25_pruning(std::shared_ptr<const Bm25PruningParams> params)
+{
+    _bm25_pruning = std::move(params);
+    return can_use_bm25_pruning(true);
+}
+
 //-----------------------------------------------------------------------------
 WeakAndBlueprint::~WeakAndBlueprint() = default;
 
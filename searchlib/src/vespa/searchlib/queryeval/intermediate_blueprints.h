@@ -7,6 +7,7 @@
 
 namespace search::queryeval {
 
+class Bm25PruningParams;
 class ISourceSelector;
 
 //-----------------------------------------------------------------------------
@@ -59,7 +60,13 @@ private:
 /** normal OR operator */
 class OrBlueprint : public IntermediateBlueprint
 {
+private:
+    std::shared_ptr<const Bm25PruningParams> _bm25_pruning;
+
+    bool can_use_bm25_pruning(bool strict) const;
+    SearchIterator::UP create_bm25_pruning_search(MultiSearch::Children sub_searches, fef::MatchData &md) const;
 public:
+    OrBlueprint();
     ~OrBlueprint() override;
     bool supports_termwise_children() const override { return true; }
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
@@ -74,6 +81,13 @@ public:
                              bool strict, fef::MatchData &md) const override;
     SearchIterator::UP
     createFilterSearch(bool strict, FilterConstraint constraint) const override;
+
+    /**
+     * Prune documents that cannot get a bm25 score high enough to be
+     * among the best hits. Only used when all the given term fields are
+     * searched by the children and the search is strict.
+     **/
+    bool set_bm25_pruning(std::shared_ptr<const Bm25PruningParams> params);
 };
 
 //-----------------------------------------------------------------------------
@@ -45,6 +45,13 @@ public:
         return _childMatch[ref]->getWeight();
     }
 
+    // Generic search iterators (including disk index posting lists)
+    // have no per block weights; see wand/weak_and_search.h.
+    static constexpr bool has_block_max() { return false; }
+    int32_t get_block_max_weight(uint32_t) const { return 0; }
+    int32_t get_block_min_weight(uint32_t) const { return 0; }
+    uint32_t get_block_last_docid(uint32_t) const { return endDocId; }
+
     void unpack(uint32_t ref, uint32_t docid) {
         _children[ref]->doUnpack(docid);
     }
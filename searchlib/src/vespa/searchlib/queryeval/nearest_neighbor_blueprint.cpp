@@ -8,6 +8,8 @@
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
 #include <vespa/vespalib/objects/objectvisitor.h>
+#include <algorithm>
+#include <cmath>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.queryeval.nearest_neighbor_blueprint");
@@ -27,10 +29,17 @@ to_string(NearestNeighborBlueprint::Algorithm algorithm)
         case NNBA::EXACT_FALLBACK: return "exact fallback";
         case NNBA::INDEX_TOP_K: return "index top k";
         case NNBA::INDEX_TOP_K_WITH_FILTER: return "index top k using filter";
+        case NNBA::INDEX_TOP_K_WITH_POST_FILTER: return "index top k with post filter";
     }
     return "unknown";
 }
 
+// Estimated number of distance calculations per document explored when searching the index.
+constexpr double index_distance_calcs_per_explored_doc = 16.0;
+
+// Max number of index searches when post-filtering, doubling the number of documents explored each time.
+constexpr uint32_t max_post_filter_rounds = 3;
+
 } // namespace <unnamed>
 
 NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& field,
@@ -58,7 +67,9 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _global_filter(GlobalFilter::create()),
       _global_filter_set(false),
       _global_filter_hits(),
-      _global_filter_hit_ratio()
+      _global_filter_hit_ratio(),
+      _filter_plan(),
+      _post_filter_rounds(0)
 {
     if (distance_threshold < std::numeric_limits<double>::max()) {
         _distance_threshold = _distance_calc->function().convert_threshold(distance_threshold);
@@ -72,6 +83,25 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
 
 NearestNeighborBlueprint::~NearestNeighborBlueprint() = default;
 
+NearestNeighborBlueprint::FilterPlan
+NearestNeighborBlueprint::plan_with_filter(uint32_t num_docs, uint32_t filter_hits, uint32_t explore_k,
+                                           double lower_limit, double upper_limit)
+{
+    double hit_ratio = (num_docs > 0) ? (static_cast<double>(filter_hits) / num_docs) : 0.0;
+    double exact_cost = filter_hits;
+    double index_cost = std::numeric_limits<double>::max();
+    if (hit_ratio > 0.0) {
+        index_cost = explore_k * std::log2(num_docs + 1.0) * index_distance_calcs_per_explored_doc / hit_ratio;
+    }
+    Algorithm algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
+    if (hit_ratio < lower_limit || exact_cost <= index_cost) {
+        algorithm = Algorithm::EXACT_FALLBACK;
+    } else if (hit_ratio > upper_limit) {
+        algorithm = Algorithm::INDEX_TOP_K_WITH_POST_FILTER;
+    }
+    return {algorithm, exact_cost, index_cost};
+}
+
 void
 NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio)
 {
@@ -83,9 +113,11 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, d
         if (_global_filter->is_active()) { // pre-filtering case
             _global_filter_hits = _global_filter->count();
             _global_filter_hit_ratio = static_cast<double>(_global_filter_hits.value()) / est_hits;
-            if (_global_filter_hit_ratio.value() < _global_filter_lower_limit) {
-                _algorithm = Algorithm::EXACT_FALLBACK;
-            } else {
+            _filter_plan = plan_with_filter(est_hits, _global_filter_hits.value(),
+                                            _adjusted_target_hits + _explore_additional_hits,
+                                            _global_filter_lower_limit, _global_filter_upper_limit);
+            _algorithm = _filter_plan->algorithm;
+            if (_algorithm != Algorithm::EXACT_FALLBACK) {
                 est_hits = std::min(est_hits, _global_filter_hits.value());
             }
         } else { // post-filtering case
@@ -108,7 +140,9 @@ NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborInd
 {
     auto lhs = _query_tensor.cells();
     uint32_t k = _adjusted_target_hits;
-    if (_global_filter->is_active()) {
+    if (_algorithm == Algorithm::INDEX_TOP_K_WITH_POST_FILTER) {
+        perform_top_k_with_post_filter(nns_index);
+    } else if (_global_filter->is_active()) {
         _found_hits = nns_index->find_top_k_with_filter(k, lhs, *_global_filter, k + _explore_additional_hits, _distance_threshold);
         _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
     } else {
@@ -117,6 +151,47 @@ NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborInd
     }
 }
 
+void
+NearestNeighborBlueprint::perform_top_k_with_post_filter(const search::tensor::NearestNeighborIndex* nns_index)
+{
+    using Neighbor = search::tensor::NearestNeighborIndex::Neighbor;
+    auto lhs = _query_tensor.cells();
+    uint32_t target_k = _adjusted_target_hits;
+    uint32_t num_docs = _attr_tensor.get_num_docs();
+    // Explore enough documents to expect 'target_k' hits after applying the filter,
+    // and explore more if the filtered documents were unevenly distributed.
+    uint32_t k = std::min(num_docs, static_cast<uint32_t>(std::ceil(target_k / _global_filter_hit_ratio.value())));
+    while (true) {
+        ++_post_filter_rounds;
+        auto hits = nns_index->find_top_k(k, lhs, k + _explore_additional_hits, _distance_threshold);
+        _found_hits.clear();
+        for (const auto& hit : hits) {
+            if (hit.docid < _global_filter->size() && _global_filter->check(hit.docid)) {
+                _found_hits.push_back(hit);
+            }
+        }
+        if (_found_hits.size() >= target_k || hits.size() < k || k >= num_docs) {
+            break;
+        }
+        if (_post_filter_rounds >= max_post_filter_rounds) {
+            // Too many documents are filtered away close to the query point.
+            _found_hits = nns_index->find_top_k_with_filter(target_k, lhs, *_global_filter,
+                                                            target_k + _explore_additional_hits, _distance_threshold);
+            _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
+            return;
+        }
+        k = std::min(num_docs, 2 * k);
+    }
+    if (_found_hits.size() > target_k) {
+        // Keep the closest hits, sorted by docid
+        std::nth_element(_found_hits.begin(), _found_hits.begin() + target_k, _found_hits.end(),
+                         [](const Neighbor& lhs, const Neighbor& rhs) { return lhs.distance < rhs.distance; });
+        _found_hits.resize(target_k);
+        std::sort(_found_hits.begin(), _found_hits.end(),
+                  [](const Neighbor& lhs, const Neighbor& rhs) { return lhs.docid < rhs.docid; });
+    }
+}
+
 std::unique_ptr<SearchIterator>
 NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda, bool strict) const
 {
@@ -124,6 +199,7 @@ NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchData
     fef::TermFieldMatchData &tfmd = *tfmda[0]; // always search in only one field
     switch (_algorithm) {
     case Algorithm::INDEX_TOP_K_WITH_FILTER:
+    case Algorithm::INDEX_TOP_K_WITH_POST_FILTER:
     case Algorithm::INDEX_TOP_K:
         return NnsIndexIterator::create(tfmd, _found_hits, _distance_calc->function());
     default:
@@ -159,6 +235,14 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     if (_global_filter_hit_ratio.has_value()) {
         visitor.visitFloat("hit_ratio", _global_filter_hit_ratio.value());
     }
+    if (_filter_plan.has_value()) {
+        visitor.visitString("planned_algorithm", to_string(_filter_plan->algorithm));
+        visitor.visitFloat("exact_cost", _filter_plan->exact_cost);
+        visitor.visitFloat("index_cost", _filter_plan->index_cost);
+    }
+    if (_post_filter_rounds > 0) {
+        visitor.visitInt("post_filter_rounds", _post_filter_rounds);
+    }
     visitor.closeStruct();
 }
 
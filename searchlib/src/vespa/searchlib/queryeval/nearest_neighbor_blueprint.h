@@ -25,7 +25,17 @@ public:
         EXACT,
         EXACT_FALLBACK,
         INDEX_TOP_K,
-        INDEX_TOP_K_WITH_FILTER
+        INDEX_TOP_K_WITH_FILTER,
+        INDEX_TOP_K_WITH_POST_FILTER
+    };
+    /**
+     * Estimated costs (in number of distance calculations) used to select
+     * the algorithm when a global filter is present.
+     */
+    struct FilterPlan {
+        Algorithm algorithm;
+        double exact_cost;
+        double index_cost;
     };
 private:
     std::unique_ptr<search::tensor::DistanceCalculator> _distance_calc;
@@ -45,8 +55,11 @@ private:
     bool _global_filter_set;
     std::optional<uint32_t> _global_filter_hits;
     std::optional<double> _global_filter_hit_ratio;
+    std::optional<FilterPlan> _filter_plan;
+    uint32_t _post_filter_rounds;
 
     void perform_top_k(const search::tensor::NearestNeighborIndex* nns_index);
+    void perform_top_k_with_post_filter(const search::tensor::NearestNeighborIndex* nns_index);
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                              std::unique_ptr<search::tensor::DistanceCalculator> distance_calc,
@@ -65,6 +78,17 @@ public:
     Algorithm get_algorithm() const { return _algorithm; }
     double get_distance_threshold() const { return _distance_threshold; }
 
+    /**
+     * Selects how to search when a global filter matching 'filter_hits' of 'num_docs' documents is present.
+     *
+     * Exact search calculates the distance to all documents matching the filter, while the cost
+     * of searching the index grows with the number of documents explored and the inverse of the
+     * filter hit ratio. When the hit ratio is above 'upper_limit' the index is searched without
+     * the filter, and the results are post-filtered.
+     */
+    static FilterPlan plan_with_filter(uint32_t num_docs, uint32_t filter_hits, uint32_t explore_k,
+                                       double lower_limit, double upper_limit);
+
     std::unique_ptr<SearchIterator> createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda,
                                                      bool strict) const override;
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
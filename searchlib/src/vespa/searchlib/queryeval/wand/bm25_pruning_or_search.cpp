@@ -0,0 +1,209 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm25_pruning_or_search.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/vespalib/objects/visit.h>
+#include <vespa/vespalib/util/left_right_heap.h>
+
+namespace search::queryeval {
+
+Bm25PruningParams::TermField::TermField(fef::TermFieldHandle handle_in, double idf, double k1, double b, double avg_field_length)
+    : handle(handle_in),
+      idf_mul_k1_plus_one(idf * (k1 + 1)),
+      k1_mul_one_minus_b(k1 * (1 - b)),
+      k1_mul_b_div_avg_field_length(k1 * b / avg_field_length)
+{
+}
+
+Bm25PruningParams::score_t
+Bm25PruningParams::TermField::score(const fef::TermFieldMatchData &tfmd) const
+{
+    double num_occs = tfmd.getNumOccs();
+    double numerator = num_occs * idf_mul_k1_plus_one;
+    double denominator = num_occs + (k1_mul_one_minus_b + k1_mul_b_div_avg_field_length * tfmd.getFieldLength());
+    return score_t((numerator / denominator) * score_factor);
+}
+
+Bm25PruningParams::Bm25PruningParams(uint32_t scores_to_track, uint32_t scores_adjust_frequency)
+    : _scores(scores_to_track),
+      _term_fields(),
+      _scores_adjust_frequency(scores_adjust_frequency)
+{
+}
+
+Bm25PruningParams::~Bm25PruningParams() = default;
+
+void
+Bm25PruningParams::add_term_field(fef::TermFieldHandle handle, double idf, double k1, double b, double avg_field_length)
+{
+    _term_fields.emplace_back(handle, idf, k1, b, avg_field_length);
+}
+
+const Bm25PruningParams::TermField *
+Bm25PruningParams::lookup(fef::TermFieldHandle handle) const
+{
+    for (const auto &term_field : _term_fields) {
+        if (term_field.handle == handle) {
+            return &term_field;
+        }
+    }
+    return nullptr;
+}
+
+Bm25PruningOrSearch::Child::Child(SearchIterator::UP search_in, uint32_t est_hits_in) noexcept
+    : search(std::move(search_in)),
+      est_hits(est_hits_in),
+      fields()
+{
+}
+
+Bm25PruningOrSearch::Child::Child(Child &&) noexcept = default;
+Bm25PruningOrSearch::Child::~Child() = default;
+
+namespace wand {
+
+namespace {
+
+using Children = Bm25PruningOrSearch::Children;
+using ChildFields = std::vector<Bm25PruningOrSearch::ChildField>;
+
+score_t calculate_max_score(const ChildFields &fields) {
+    score_t result = 1;
+    for (const auto &field : fields) {
+        result += field.params->max_score();
+    }
+    return result;
+}
+
+struct Bm25Input {
+    const Children &children;
+    Bm25Input(const Children &children_in) : children(children_in) {}
+    size_t size() const { return children.size(); }
+    int32_t get_weight(ref_t) const { return 1; }
+    uint32_t get_est_hits(ref_t ref) const { return children[ref].est_hits; }
+    score_t get_max_score(ref_t ref) const { return calculate_max_score(children[ref].fields); }
+    docid_t get_initial_docid(ref_t ref) const { return children[ref].search->getDocId(); }
+};
+
+class VectorizedBm25Terms : public VectorizedState<SearchIteratorPack>
+{
+private:
+    std::vector<ChildFields> _fields;
+
+public:
+    template <typename Scorer>
+    VectorizedBm25Terms(Children &children, const Scorer &, uint32_t docIdLimit)
+        : _fields()
+    {
+        std::vector<ref_t> order = init_state<Scorer>(Bm25Input(children), docIdLimit);
+        _fields = assemble([&children](ref_t ref){ return children[ref].fields; }, order);
+        iteratorPack() = SearchIteratorPack(assemble([&children](ref_t ref){ return children[ref].search.release(); }, order),
+                                            fef::MatchData::UP());
+    }
+    score_t get_score(ref_t ref, docid_t docid) {
+        iteratorPack().unpack(ref, docid);
+        score_t score = 1;
+        for (const auto &field : _fields[ref]) {
+            if (field.tfmd->getDocId() == docid) {
+                score += field.params->score(*field.tfmd);
+            }
+        }
+        return score;
+    }
+};
+
+struct Bm25Scorer
+{
+    template <typename Input>
+    static score_t calculate_max_score(const Input &input, ref_t ref) {
+        return input.get_max_score(ref);
+    }
+
+    static score_t calculateScore(VectorizedBm25Terms &terms, ref_t ref, docid_t docId) {
+        return terms.get_score(ref, docId);
+    }
+};
+
+template <typename FutureHeap, typename PastHeap>
+class Bm25PruningOrSearchImpl : public Bm25PruningOrSearch
+{
+private:
+    VectorizedBm25Terms             _terms;
+    DualHeap<FutureHeap, PastHeap>  _heaps;
+    Algorithm                       _algo;
+    score_t                         _threshold;
+    const Bm25PruningParams        &_params;
+    std::vector<score_t>            _localScores;
+    uint32_t                        _num_candidates;
+    uint32_t                        _num_pruned;
+
+    void updateThreshold(score_t newThreshold) {
+        if (newThreshold > _threshold) {
+            _threshold = newThreshold;
+        }
+    }
+
+public:
+    Bm25PruningOrSearchImpl(Children &children, const Bm25PruningParams &params, uint32_t docid_limit)
+        : _terms(children, Bm25Scorer(), docid_limit),
+          _heaps(DocIdOrder(_terms.docId()), _terms.size()),
+          _algo(),
+          _threshold(params.get_scores().getMinScore()),
+          _params(params),
+          _localScores(),
+          _num_candidates(0),
+          _num_pruned(0)
+    {
+    }
+    uint32_t get_num_candidates() const override { return _num_candidates; }
+    uint32_t get_num_pruned() const override { return _num_pruned; }
+
+    void doSeek(uint32_t docid) override {
+        updateThreshold(_params.get_scores().getMinScore());
+        _algo.set_candidate(_terms, _heaps, docid);
+        while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_threshold))) {
+            ++_num_candidates;
+            if (_algo.check_score(_terms, _heaps, Bm25Scorer(), GreaterThan(_threshold))) {
+                setDocId(_algo.get_candidate());
+                return;
+            }
+            ++_num_pruned;
+            _algo.set_candidate(_terms, _heaps, _algo.get_candidate() + 1);
+        }
+        setAtEnd();
+    }
+    void doUnpack(uint32_t) override {
+        score_t score = _algo.get_full_score(_terms, _heaps, Bm25Scorer());
+        _localScores.push_back(score);
+        if (_localScores.size() == _params.get_scores_adjust_frequency()) {
+            _params.get_scores().adjust(&_localScores[0], &_localScores[0] + _localScores.size());
+            _localScores.clear();
+        }
+    }
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override {
+        visit(visitor, "threshold", _threshold);
+        visit(visitor, "num_candidates", _num_candidates);
+        visit(visitor, "num_pruned", _num_pruned);
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        Bm25PruningOrSearch::initRange(begin, end);
+        _algo.init_range(_terms, _heaps, begin, end);
+    }
+    Trinary is_strict() const override { return Trinary::True; }
+};
+
+} // namespace search::queryeval::wand::<unnamed>
+
+} // namespace search::queryeval::wand
+
+SearchIterator::UP
+Bm25PruningOrSearch::create(Children children, const Bm25PruningParams &params, uint32_t docid_limit)
+{
+    if (children.size() < 128) {
+        return std::make_unique<wand::Bm25PruningOrSearchImpl<vespalib::LeftArrayHeap, vespalib::RightArrayHeap>>(children, params, docid_limit);
+    } else {
+        return std::make_unique<wand::Bm25PruningOrSearchImpl<vespalib::LeftHeap, vespalib::RightHeap>>(children, params, docid_limit);
+    }
+}
+
+}
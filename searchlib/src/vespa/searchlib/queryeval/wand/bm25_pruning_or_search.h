@@ -0,0 +1,84 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "wand_parts.h"
+#include "weak_and_heap.h"
+#include <vespa/searchlib/fef/handle.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vector>
+
+namespace search::fef { class TermFieldMatchData; }
+
+namespace search::queryeval {
+
+/**
+ * Parameters used to calculate the bm25 score of the terms below an
+ * OR when pruning documents that cannot get a score high enough to be
+ * among the best hits. The heap with the best scores is shared by the
+ * search iterators of all match threads.
+ *
+ * Scores are fixed point. Each matching child of the OR adds 1 to the
+ * score to keep the score of all matching documents above 0, which is
+ * the threshold used before the heap is full.
+ */
+class Bm25PruningParams
+{
+public:
+    using score_t = wand::score_t;
+    static constexpr double score_factor = 1000000.0;
+
+    struct TermField {
+        fef::TermFieldHandle handle;
+        double               idf_mul_k1_plus_one;
+        double               k1_mul_one_minus_b;
+        double               k1_mul_b_div_avg_field_length;
+
+        TermField(fef::TermFieldHandle handle_in, double idf, double k1, double b, double avg_field_length);
+        // bm25 term score approaches idf * (k1 + 1) as the number of occurrences grows
+        score_t max_score() const { return score_t(idf_mul_k1_plus_one * score_factor) + 1; }
+        score_t score(const fef::TermFieldMatchData &tfmd) const;
+    };
+
+private:
+    mutable SharedWeakAndPriorityQueue _scores;
+    std::vector<TermField>             _term_fields;
+    const uint32_t                     _scores_adjust_frequency;
+
+public:
+    Bm25PruningParams(uint32_t scores_to_track, uint32_t scores_adjust_frequency);
+    ~Bm25PruningParams();
+    void add_term_field(fef::TermFieldHandle handle, double idf, double k1, double b, double avg_field_length);
+    const TermField *lookup(fef::TermFieldHandle handle) const;
+    const std::vector<TermField> &get_term_fields() const { return _term_fields; }
+    WeakAndHeap &get_scores() const { return _scores; }
+    uint32_t get_scores_adjust_frequency() const { return _scores_adjust_frequency; }
+};
+
+/**
+ * OR of terms that skips documents whose bm25 score cannot exceed the
+ * lowest of the best scores seen so far, using the wand algorithm with
+ * a max score per term. Only strict iteration is supported.
+ */
+struct Bm25PruningOrSearch : SearchIterator
+{
+    struct ChildField {
+        const Bm25PruningParams::TermField *params;
+        fef::TermFieldMatchData            *tfmd;
+    };
+    struct Child {
+        SearchIterator::UP      search;
+        uint32_t                est_hits;
+        std::vector<ChildField> fields;
+        Child(SearchIterator::UP search_in, uint32_t est_hits_in) noexcept;
+        Child(Child &&) noexcept;
+        ~Child();
+    };
+    using Children = std::vector<Child>;
+
+    virtual uint32_t get_num_candidates() const = 0;
+    virtual uint32_t get_num_pruned() const = 0;
+    static SearchIterator::UP create(Children children, const Bm25PruningParams &params, uint32_t docid_limit);
+};
+
+}
@@ -44,12 +44,16 @@ private:
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-            if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
-                setDocId(_algo.get_candidate());
-                return;
-            } else {
-                _algo.set_candidate(_terms, _heaps, _algo.get_candidate() + 1);
+            uint32_t candidate = _algo.get_candidate();
+            uint32_t next = _algo.check_block_max(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold));
+            if (next == candidate) {
+                if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+                    setDocId(candidate);
+                    return;
+                }
+                next = candidate + 1;
             }
+            _algo.set_candidate(_terms, _heaps, next);
         }
         setAtEnd();
     }
@@ -57,7 +61,9 @@ private:
     void seek_unstrict(uint32_t docid) {
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
-            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold)) &&
+                (_algo.check_block_max(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold)) == _algo.get_candidate()))
+            {
                 if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                     setDocId(_algo.get_candidate());
                 }
@@ -180,7 +180,13 @@ public:
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
-    
+
+    // weight bounds for the block containing the current position of the term
+    static constexpr bool has_block_max() { return IteratorPack::has_block_max(); }
+    int32_t get_block_max_weight(uint16_t ref) const { return _iteratorPack.get_block_max_weight(ref); }
+    int32_t get_block_min_weight(uint16_t ref) const { return _iteratorPack.get_block_min_weight(ref); }
+    uint32_t get_block_last_docid(uint16_t ref) const { return _iteratorPack.get_block_last_docid(ref); }
+
     vespalib::string stringify_docid() const;
 };
 
@@ -448,6 +454,13 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    template <typename VectorizedTerms>
+    static score_t calculate_block_max_score(const VectorizedTerms &terms, ref_t ref) {
+        int32_t weight = terms.weight(ref);
+        int32_t block_weight = (weight >= 0) ? terms.get_block_max_weight(ref) : terms.get_block_min_weight(ref);
+        return std::min(weight * (score_t)block_weight, terms.maxScore(ref));
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -619,6 +632,31 @@ public:
         return true;
     }
 
+    /**
+     * Check the upper bound for the current candidate using the max
+     * score of the blocks the present terms are positioned in. Returns
+     * the candidate if it may be a hit. Otherwise, no document before
+     * the returned docid can be a hit.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    docid_t check_block_max(VectorizedTerms &terms, Heaps &heaps, Scorer &&, AboveThreshold &&aboveThreshold) {
+        if constexpr (VectorizedTerms::has_block_max()) {
+            score_t bound = _maxUpperBound - _upperBound;
+            docid_t skip_to = heaps.has_future() ? terms.docId(heaps.future()) : search::endDocId;
+            ref_t *end = heaps.present_end();
+            for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+                bound += Scorer::calculate_block_max_score(terms, *ref);
+                skip_to = std::min(skip_to, terms.get_block_last_docid(*ref) + 1);
+            }
+            return aboveThreshold(bound) ? _candidate : skip_to;
+        } else {
+            (void) terms;
+            (void) heaps;
+            (void) aboveThreshold;
+            return _candidate;
+        }
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
@@ -8,6 +8,13 @@
 namespace search {
 namespace queryeval {
 
+/**
+ * WAND over text terms. The score of a term is its weight scaled by
+ * idf (see TermFrequencyScorer), which is the same for every document
+ * in its posting list. A per block upper bound would therefore always
+ * equal the max score of the term, so block-max skipping is only done
+ * by ParallelWeakAndSearch, where each document has its own weight.
+ **/
 struct WeakAndSearch : SearchIterator {
     typedef wand::Terms Terms;
     virtual size_t get_num_terms() const = 0;
@@ -37,7 +37,8 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                           m,
                           params.neighbors_to_explore_at_insert(),
                           10000,
-                          true);
+                          true,
+                          params.quantize_vectors());
     return std::make_unique<HnswIndex>(vectors,
                                        make_distance_function(params.distance_metric(), cell_type),
                                        make_random_level_generator(m),
@@ -506,4 +506,15 @@ DenseTensorAttribute::get_vector(uint32_t docid) const
     return _denseTensorStore.get_typed_cells(ref);
 }
 
+void
+DenseTensorAttribute::prefetch_vectors(vespalib::ConstArrayRef<uint32_t> docids) const
+{
+    if (!_denseTensorStore.is_paged()) {
+        return;
+    }
+    for (uint32_t docid : docids) {
+        _denseTensorStore.prefetch_tensor(acquire_entry_ref(docid));
+    }
+}
+
 }
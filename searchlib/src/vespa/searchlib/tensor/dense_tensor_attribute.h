@@ -16,6 +16,9 @@ class NearestNeighborIndex;
 /**
  * Attribute vector class used to store dense tensors for all
  * documents in memory.
+ *
+ * When the attribute is paged the tensors are stored in a memory mapped file,
+ * while the nearest neighbor index is kept in memory.
  */
 class DenseTensorAttribute : public TensorAttribute, public DocVectorAccess {
 private:
@@ -55,6 +58,7 @@ public:
 
     // Implements DocVectorAccess
     vespalib::eval::TypedCells get_vector(uint32_t docid) const override;
+    void prefetch_vectors(vespalib::ConstArrayRef<uint32_t> docids) const override;
 
     const NearestNeighborIndex* nearest_neighbor_index() const override { return _index.get(); }
 };
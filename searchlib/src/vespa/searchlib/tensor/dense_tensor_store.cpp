@@ -4,6 +4,8 @@
 #include <vespa/eval/eval/value.h>
 #include <vespa/vespalib/datastore/datastore.hpp>
 #include <vespa/vespalib/util/memory_allocator.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using vespalib::datastore::Handle;
 using vespalib::eval::CellType;
@@ -25,6 +27,8 @@ size_t my_align(size_t size, size_t alignment) {
     return (size - (size % alignment));
 }
 
+const size_t page_size = getpagesize();
+
 }
 
 DenseTensorStore::TensorSizeCalc::TensorSizeCalc(const ValueType &type)
@@ -154,4 +158,17 @@ DenseTensorStore::setTensor(const vespalib::eval::Value &tensor)
     return setDenseTensor(tensor);
 }
 
+void
+DenseTensorStore::prefetch_tensor(EntryRef ref) const
+{
+    if (!ref.valid() || !is_paged()) {
+        return;
+    }
+    auto start = reinterpret_cast<uintptr_t>(getRawBuffer(ref));
+    auto end = start + getBufSize();
+    start -= (start % page_size);
+    // Failure is not fatal, as this is only a hint to the kernel.
+    (void) madvise(reinterpret_cast<void *>(start), end - start, MADV_WILLNEED);
+}
+
 }
@@ -73,6 +73,13 @@ public:
                                           _type.cell_type(), getNumCells());
     }
     EntryRef setTensor(const vespalib::eval::Value &tensor);
+    bool is_paged() const noexcept { return _bufferType.get_memory_allocator() != nullptr; }
+    /*
+     * Hint that the cells of the given tensor will soon be accessed.
+     * When the tensor store is paged this starts reading the pages
+     * holding the cells from disk without waiting for them.
+     */
+    void prefetch_tensor(EntryRef ref) const;
     // The following method is meant to be used only for unit tests.
     uint32_t getArraySize() const { return _bufferType.getArraySize(); }
 };
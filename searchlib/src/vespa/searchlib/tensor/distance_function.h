@@ -4,8 +4,7 @@
 
 #include <memory>
 #include <vespa/eval/eval/cell_type.h>
-
-namespace vespalib::eval { struct TypedCells; }
+#include <vespa/eval/eval/typed_cells.h>
 
 namespace search::tensor {
 
@@ -43,6 +42,16 @@ public:
     virtual double calc_with_limit(const vespalib::eval::TypedCells& lhs,
                                    const vespalib::eval::TypedCells& rhs,
                                    double limit) const = 0;
+
+    // calculate internal distance from lhs to each of the rhs vectors
+    virtual void calc_many(const vespalib::eval::TypedCells& lhs,
+                           vespalib::ConstArrayRef<vespalib::eval::TypedCells> rhs,
+                           double* distances) const
+    {
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            distances[i] = calc(lhs, rhs[i]);
+        }
+    }
 };
 
 }
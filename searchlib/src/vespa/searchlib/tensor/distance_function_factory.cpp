@@ -21,6 +21,7 @@ make_distance_function(DistanceMetric variant, CellType cell_type)
         switch (cell_type) {
         case CellType::FLOAT:  return std::make_unique<SquaredEuclideanDistanceHW<float>>();
         case CellType::DOUBLE: return std::make_unique<SquaredEuclideanDistanceHW<double>>();
+        case CellType::BFLOAT16: return std::make_unique<SquaredEuclideanDistanceHW<vespalib::BFloat16>>();
         case CellType::INT8: return std::make_unique<SquaredEuclideanDistanceHW<vespalib::eval::Int8Float>>();
         default:               return std::make_unique<SquaredEuclideanDistance>(CellType::FLOAT);
         } 
@@ -28,6 +29,7 @@ make_distance_function(DistanceMetric variant, CellType cell_type)
         switch (cell_type) {
         case CellType::FLOAT:  return std::make_unique<AngularDistanceHW<float>>();
         case CellType::DOUBLE: return std::make_unique<AngularDistanceHW<double>>();
+        case CellType::BFLOAT16: return std::make_unique<AngularDistanceHW<vespalib::BFloat16>>();
         default:               return std::make_unique<AngularDistance>(CellType::FLOAT);
         }
     case DistanceMetric::GeoDegrees:
@@ -36,6 +38,7 @@ make_distance_function(DistanceMetric variant, CellType cell_type)
         switch (cell_type) {
         case CellType::FLOAT:  return std::make_unique<InnerProductDistanceHW<float>>();
         case CellType::DOUBLE: return std::make_unique<InnerProductDistanceHW<double>>();
+        case CellType::BFLOAT16: return std::make_unique<InnerProductDistanceHW<vespalib::BFloat16>>();
         default:               return std::make_unique<InnerProductDistance>(CellType::FLOAT);
         }
     case DistanceMetric::Hamming:
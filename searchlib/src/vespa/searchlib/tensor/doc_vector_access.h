@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/eval/eval/typed_cells.h>
+#include <vespa/vespalib/util/arrayref.h>
 #include <cstdint>
 
 namespace search::tensor {
@@ -16,6 +17,12 @@ class DocVectorAccess {
 public:
     virtual ~DocVectorAccess() {}
     virtual vespalib::eval::TypedCells get_vector(uint32_t docid) const = 0;
+
+    /**
+     * Hint that the vectors for the given documents will soon be accessed.
+     * Used to batch the reads when the vectors are paged to disk.
+     */
+    virtual void prefetch_vectors(vespalib::ConstArrayRef<uint32_t> docids) const { (void) docids; }
 };
 
 }
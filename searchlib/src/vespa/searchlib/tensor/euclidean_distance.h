@@ -5,6 +5,8 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace search::tensor {
@@ -47,6 +49,7 @@ public:
     static const double *cast(const double * p) { return p; }
     static const float *cast(const float * p) { return p; }
     static const int8_t *cast(const vespalib::eval::Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    static const vespalib::BFloat16 *cast(const vespalib::BFloat16 * p) { return p; }
     double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override {
         constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
         assert(lhs.type == expected && rhs.type == expected);
@@ -74,6 +77,28 @@ public:
         }
         return sum;
     }
+
+    void calc_many(const vespalib::eval::TypedCells& lhs,
+                   vespalib::ConstArrayRef<vespalib::eval::TypedCells> rhs,
+                   double* distances) const override
+    {
+        constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
+        assert(lhs.type == expected);
+        auto lhs_vector = lhs.typify<FloatType>();
+        size_t sz = lhs_vector.size();
+        constexpr size_t batch_size = 32;
+        std::array<decltype(cast(lhs_vector.data())), batch_size> rhs_cells;
+        for (size_t i = 0; i < rhs.size(); i += batch_size) {
+            size_t count = std::min(batch_size, rhs.size() - i);
+            for (size_t j = 0; j < count; ++j) {
+                assert(rhs[i + j].type == expected);
+                auto rhs_vector = rhs[i + j].typify<FloatType>();
+                assert(sz == rhs_vector.size());
+                rhs_cells[j] = cast(rhs_vector.data());
+            }
+            _computer.squaredEuclideanDistance(cast(lhs_vector.data()), rhs_cells.data(), count, sz, distances + i);
+        }
+    }
 private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
@@ -1,7 +1,8 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "hamming_distance.h"
-#include <vespa/vespalib/util/binary_hamming_distance.h>
+#include <algorithm>
+#include <array>
 
 using vespalib::typify_invoke;
 using vespalib::eval::TypifyCellType;
@@ -37,12 +38,34 @@ HammingDistance::calc(const vespalib::eval::TypedCells& lhs,
     if (__builtin_expect((lhs.type == expected && rhs.type == expected), true)) {
         size_t sz = lhs.size;
         assert(sz == rhs.size);
-        return (double) vespalib::binary_hamming_distance(lhs.data, rhs.data, sz);
+        return (double) _computer.binaryHammingDistance(lhs.data, rhs.data, sz);
     } else {
         return typify_invoke<2,TypifyCellType,CalcHamming>(lhs.type, rhs.type, lhs, rhs);
     }
 }
 
+void
+HammingDistance::calc_many(const vespalib::eval::TypedCells& lhs,
+                           vespalib::ConstArrayRef<vespalib::eval::TypedCells> rhs,
+                           double* distances) const
+{
+    constexpr auto expected = vespalib::eval::CellType::INT8;
+    if (expected_cell_type() != expected || lhs.type != expected) {
+        DistanceFunction::calc_many(lhs, rhs, distances);
+        return;
+    }
+    constexpr size_t batch_size = 32;
+    std::array<const void *, batch_size> rhs_cells;
+    for (size_t i = 0; i < rhs.size(); i += batch_size) {
+        size_t count = std::min(batch_size, rhs.size() - i);
+        for (size_t j = 0; j < count; ++j) {
+            assert(rhs[i + j].type == expected && rhs[i + j].size == lhs.size);
+            rhs_cells[j] = rhs[i + j].data;
+        }
+        _computer.binaryHammingDistance(lhs.data, rhs_cells.data(), count, lhs.size, distances + i);
+    }
+}
+
 double
 HammingDistance::calc_with_limit(const vespalib::eval::TypedCells& lhs,
                                  const vespalib::eval::TypedCells& rhs,
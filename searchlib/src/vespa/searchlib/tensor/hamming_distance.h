@@ -4,6 +4,7 @@
 
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/util/typify.h>
 #include <cmath>
 
@@ -16,8 +17,13 @@ namespace search::tensor {
  * "number of bits that are different"
  */
 class HammingDistance final : public DistanceFunction {
+private:
+    const vespalib::hwaccelrated::IAccelrated & _computer;
 public:
-    HammingDistance(vespalib::eval::CellType expected) : DistanceFunction(expected) {}
+    HammingDistance(vespalib::eval::CellType expected)
+      : DistanceFunction(expected),
+        _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
+    {}
     double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override;
     double convert_threshold(double threshold) const override {
         return threshold;
@@ -27,6 +33,9 @@ public:
         return score;
     }
     double calc_with_limit(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs, double) const override;
+    void calc_many(const vespalib::eval::TypedCells& lhs,
+                   vespalib::ConstArrayRef<vespalib::eval::TypedCells> rhs,
+                   double* distances) const override;
 };
 
 }
@@ -1,12 +1,16 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "hnsw_index.h"
+#include "angular_distance.h"
 #include "bitvector_visited_tracker.h"
 #include "distance_function.h"
+#include "euclidean_distance.h"
 #include "hash_set_visited_tracker.h"
 #include "hnsw_index_loader.hpp"
 #include "hnsw_index_saver.h"
+#include "inner_product_distance.h"
 #include "random_level_generator.h"
+#include "reusable_set_visited_tracker.h"
 #include <vespa/searchlib/attribute/address_space_components.h>
 #include <vespa/searchlib/attribute/address_space_usage.h>
 #include <vespa/searchlib/queryeval/global_filter.h>
@@ -19,6 +23,7 @@
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <optional>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
@@ -43,6 +48,22 @@ constexpr size_t max_level_array_size = 16;
 constexpr size_t max_link_array_size = 193;
 constexpr vespalib::duration MAX_COUNT_DURATION(100ms);
 
+std::optional<QuantizedVectorStore::Metric>
+quantized_metric(const DistanceFunction& distance_func)
+{
+    using Metric = QuantizedVectorStore::Metric;
+    if (dynamic_cast<const SquaredEuclideanDistance*>(&distance_func) != nullptr) {
+        return Metric::SQUARED_EUCLIDEAN;
+    }
+    if (dynamic_cast<const InnerProductDistance*>(&distance_func) != nullptr) {
+        return Metric::INNER_PRODUCT;
+    }
+    if (dynamic_cast<const AngularDistance*>(&distance_func) != nullptr) {
+        return Metric::ANGULAR;
+    }
+    return std::nullopt;
+}
+
 bool has_link_to(vespalib::ConstArrayRef<uint32_t> links, uint32_t id) {
     for (uint32_t link : links) {
         if (link == id) return true;
@@ -62,6 +83,25 @@ bool operator< (const PairDist &a, const PairDist &b) {
     return (a.distance < b.distance);
 }
 
+/**
+ * Provides access to the vector of a document that is being added to the index,
+ * before it is stored in the enclosing tensor attribute.
+ */
+class PendingDocVectorAccess : public DocVectorAccess {
+    const DocVectorAccess&     _vectors;
+    uint32_t                   _pending_docid;
+    vespalib::eval::TypedCells _pending_vector;
+public:
+    PendingDocVectorAccess(const DocVectorAccess& vectors, uint32_t pending_docid, vespalib::eval::TypedCells pending_vector)
+        : _vectors(vectors),
+          _pending_docid(pending_docid),
+          _pending_vector(pending_vector)
+    {}
+    vespalib::eval::TypedCells get_vector(uint32_t docid) const override {
+        return (docid == _pending_docid) ? _pending_vector : _vectors.get_vector(docid);
+    }
+};
+
 }
 
 vespalib::datastore::ArrayStoreConfig
@@ -85,10 +125,10 @@ HnswIndex::max_links_for_level(uint32_t level) const
 }
 
 bool
-HnswIndex::have_closer_distance(HnswCandidate candidate, const HnswCandidateVector& result) const
+HnswIndex::have_closer_distance(const DocVectorAccess& vectors, HnswCandidate candidate, const HnswCandidateVector& result) const
 {
     for (const auto & neighbor : result) {
-        double dist = calc_distance(candidate.docid, neighbor.docid);
+        double dist = calc_distance(vectors, candidate.docid, neighbor.docid);
         if (dist < candidate.distance) {
             return true;
         }
@@ -113,7 +153,7 @@ HnswIndex::select_neighbors_simple(const HnswCandidateVector& neighbors, uint32_
 }
 
 HnswIndex::SelectResult
-HnswIndex::select_neighbors_heuristic(const HnswCandidateVector& neighbors, uint32_t max_links) const
+HnswIndex::select_neighbors_heuristic(const DocVectorAccess& vectors, const HnswCandidateVector& neighbors, uint32_t max_links) const
 {
     SelectResult result;
     NearestPriQ nearest;
@@ -123,7 +163,7 @@ HnswIndex::select_neighbors_heuristic(const HnswCandidateVector& neighbors, uint
     while (!nearest.empty()) {
         auto candidate = nearest.top();
         nearest.pop();
-        if (have_closer_distance(candidate, result.used)) {
+        if (have_closer_distance(vectors, candidate, result.used)) {
             result.unused.push_back(candidate.docid);
             continue;
         }
@@ -140,10 +180,10 @@ HnswIndex::select_neighbors_heuristic(const HnswCandidateVector& neighbors, uint
 }
 
 HnswIndex::SelectResult
-HnswIndex::select_neighbors(const HnswCandidateVector& neighbors, uint32_t max_links) const
+HnswIndex::select_neighbors(const DocVectorAccess& vectors, const HnswCandidateVector& neighbors, uint32_t max_links) const
 {
     if (_cfg.heuristic_select_neighbors()) {
-        return select_neighbors_heuristic(neighbors, max_links);
+        return select_neighbors_heuristic(vectors, neighbors, max_links);
     } else {
         return select_neighbors_simple(neighbors, max_links);
     }
@@ -174,15 +214,47 @@ HnswIndex::shrink_if_needed(uint32_t docid, uint32_t level)
     }
 }
 
+HnswIndex::PreparedLinkArray::~PreparedLinkArray() = default;
+
+bool
+HnswIndex::try_apply_prepared_link_array(uint32_t docid, uint32_t level, const PreparedLinkArray& prepared)
+{
+    auto levels = _graph.get_level_array(docid);
+    if (level >= levels.size() || levels[level].load_relaxed() != prepared.old_links_ref) {
+        // The link array has changed since the shrink was prepared.
+        return false;
+    }
+    _graph.set_link_array(docid, level, prepared.new_links);
+    for (uint32_t removed_docid : prepared.removed) {
+        remove_link_to(removed_docid, docid, level);
+    }
+    return true;
+}
+
 void
-HnswIndex::connect_new_node(uint32_t docid, const LinkArrayRef &neighbors, uint32_t level)
+HnswIndex::connect_new_node(uint32_t docid, const LinkArrayRef &neighbors, uint32_t level,
+                            const PreparedLinkArrays* prepared_shrinks)
 {
     _graph.set_link_array(docid, level, neighbors);
+    LinkArray need_shrink;
+    need_shrink.reserve(neighbors.size());
     for (uint32_t neighbor_docid : neighbors) {
-        auto old_links = _graph.get_link_array(neighbor_docid, level);
-        add_link_to(neighbor_docid, level, old_links, docid);
+        bool applied = false;
+        if (prepared_shrinks != nullptr) {
+            for (const auto& prepared : *prepared_shrinks) {
+                if (prepared.docid == neighbor_docid) {
+                    applied = try_apply_prepared_link_array(neighbor_docid, level, prepared);
+                    break;
+                }
+            }
+        }
+        if (!applied) {
+            auto old_links = _graph.get_link_array(neighbor_docid, level);
+            add_link_to(neighbor_docid, level, old_links, docid);
+            need_shrink.push_back(neighbor_docid);
+        }
     }
-    for (uint32_t neighbor_docid : neighbors) {
+    for (uint32_t neighbor_docid : need_shrink) {
         shrink_if_needed(neighbor_docid, level);
     }
 }
@@ -207,6 +279,14 @@ HnswIndex::calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const
     return calc_distance(lhs, rhs_docid);
 }
 
+double
+HnswIndex::calc_distance(const DocVectorAccess& vectors, uint32_t lhs_docid, uint32_t rhs_docid) const
+{
+    auto lhs = vectors.get_vector(lhs_docid);
+    auto rhs = vectors.get_vector(rhs_docid);
+    return _distance_func->calc(lhs, rhs);
+}
+
 double
 HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
 {
@@ -214,6 +294,112 @@ HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
     return _distance_func->calc(lhs, rhs);
 }
 
+HnswIndex::TraversalDistance::TraversalDistance(const HnswIndex& index, const TypedCells& input,
+                                                const QuantizedVectorStore* quantized)
+    : _index(index),
+      _input(input),
+      _quantized(quantized),
+      _input_codes(),
+      _codes(),
+      _vectors()
+{
+    if (_quantized != nullptr) {
+        _input_codes.resize(_quantized->dims());
+        _quantized->quantizer().encode(_input, _input_codes.data());
+    }
+}
+
+HnswIndex::TraversalDistance::~TraversalDistance() = default;
+
+double
+HnswIndex::TraversalDistance::calc(uint32_t docid)
+{
+    if (_quantized == nullptr) {
+        return _index.calc_distance(_input, docid);
+    }
+    return _quantized->calc(_input_codes.data(), docid);
+}
+
+void
+HnswIndex::TraversalDistance::calc(vespalib::ConstArrayRef<uint32_t> docids, double* distances)
+{
+    if (_quantized != nullptr) {
+        _quantized->calc_many(_input_codes.data(), docids, _codes, distances);
+        return;
+    }
+    _vectors.clear();
+    for (uint32_t docid : docids) {
+        _vectors.push_back(_index.get_vector(docid));
+    }
+    _index._distance_func->calc_many(_input, _vectors, distances);
+}
+
+void
+HnswIndex::set_quantized_vector(uint32_t docid)
+{
+    if (!_quantized_metric.has_value()) {
+        return;
+    }
+    auto vector = get_vector(docid);
+    _quantizer_max_abs_value = std::max(_quantizer_max_abs_value, ScalarQuantizer::max_abs_value(vector));
+    if (_quantized_vectors) {
+        _quantized_vectors->set_vector(docid, vector);
+    }
+    if (!_pending_quantized_vectors) {
+        consider_train_quantizer(vector.size);
+    }
+    if (_pending_quantized_vectors) {
+        _pending_quantized_vectors->set_vector(docid, vector);
+        reencode_quantized_vectors(reencoded_docids_per_put);
+    }
+}
+
+void
+HnswIndex::consider_train_quantizer(uint32_t dims)
+{
+    if (_quantized_vectors && !_quantized_vectors->needs_retraining()) {
+        return;
+    }
+    uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_relaxed);
+    if (doc_id_limit < min_size_before_quantization) {
+        return;
+    }
+    // Existing vectors are re-encoded a few at a time by later puts, see reencode_quantized_vectors().
+    ScalarQuantizer quantizer(dims, _quantizer_max_abs_value);
+    _pending_quantized_vectors = std::make_unique<QuantizedVectorStore>(std::move(quantizer), _quantized_metric.value());
+    _pending_reencode_docid = 1;
+    LOG(debug, "%s scalar quantizer for max abs value %g (doc_id_limit=%u)",
+        (_quantized_vectors ? "Retraining" : "Training"), _quantizer_max_abs_value, doc_id_limit);
+}
+
+void
+HnswIndex::reencode_quantized_vectors(uint32_t max_docids)
+{
+    uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_relaxed);
+    uint32_t end = std::min(doc_id_limit, _pending_reencode_docid + max_docids);
+    for (uint32_t docid = _pending_reencode_docid; docid < end; ++docid) {
+        if (_graph.get_node_ref(docid).valid()) {
+            _pending_quantized_vectors->set_vector(docid, get_vector(docid));
+        }
+    }
+    _pending_reencode_docid = std::max(_pending_reencode_docid, end);
+}
+
+void
+HnswIndex::consider_publish_quantized_vectors(generation_t current_gen)
+{
+    if (!_pending_quantized_vectors ||
+        (_pending_reencode_docid < _graph.node_refs_size.load(std::memory_order_relaxed))) {
+        return;
+    }
+    if (_quantized_vectors) {
+        // Readers might still use the old store, so it is freed when the current generation is no longer used.
+        _retired_quantized_vectors.emplace_back(current_gen, std::move(_quantized_vectors));
+    }
+    _quantized_vectors = std::move(_pending_quantized_vectors);
+    _published_quantized_vectors.store(_quantized_vectors.get(), std::memory_order_release);
+}
+
 uint32_t
 HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const
 {
@@ -238,7 +424,7 @@ HnswIndex::estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_
 }
 
 HnswCandidate
-HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+HnswIndex::find_nearest_in_layer(TraversalDistance& distance, const HnswCandidate& entry_point, uint32_t level) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
@@ -246,7 +432,7 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
         keep_searching = false;
         for (uint32_t neighbor_docid : _graph.get_link_array(nearest.node_ref, level)) {
             auto neighbor_ref = _graph.acquire_node_ref(neighbor_docid);
-            double dist = calc_distance(input, neighbor_docid);
+            double dist = distance.calc(neighbor_docid);
             if (_graph.still_valid(neighbor_docid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -260,12 +446,14 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
 
 template <class VisitedTracker>
 void
-HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find,
+HnswIndex::search_layer_helper(TraversalDistance& distance, uint32_t neighbors_to_find,
                                FurthestPriQ& best_neighbors, uint32_t level, const GlobalFilter *filter,
-                               uint32_t doc_id_limit, uint32_t estimated_visited_nodes) const
+                               uint32_t doc_id_limit, VisitedTracker& visited) const
 {
     NearestPriQ candidates;
-    VisitedTracker visited(*this, doc_id_limit, estimated_visited_nodes);
+    std::vector<uint32_t> neighbor_docids;
+    std::vector<HnswGraph::NodeRef> neighbor_refs;
+    std::vector<double> neighbor_distances;
     for (const auto &entry : best_neighbors.peek()) {
         if (entry.docid >= doc_id_limit) {
             continue;
@@ -285,6 +473,8 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
             break;
         }
         candidates.pop();
+        neighbor_docids.clear();
+        neighbor_refs.clear();
         for (uint32_t neighbor_docid : _graph.get_link_array(cand.node_ref, level)) {
             if (neighbor_docid >= doc_id_limit) {
                 continue;
@@ -295,7 +485,15 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
             {
                 continue;
             }
-            double dist_to_input = calc_distance(input, neighbor_docid);
+            neighbor_docids.push_back(neighbor_docid);
+            neighbor_refs.push_back(neighbor_ref);
+        }
+        neighbor_distances.resize(neighbor_docids.size());
+        distance.calc(neighbor_docids, neighbor_distances.data());
+        for (size_t i = 0; i < neighbor_docids.size(); ++i) {
+            uint32_t neighbor_docid = neighbor_docids[i];
+            auto neighbor_ref = neighbor_refs[i];
+            double dist_to_input = neighbor_distances[i];
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_docid, neighbor_ref, dist_to_input);
                 if ((!filter) || filter->check(neighbor_docid)) {
@@ -311,7 +509,7 @@ HnswIndex::search_layer_helper(const TypedCells& input, uint32_t neighbors_to_fi
 }
 
 void
-HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
+HnswIndex::search_layer(TraversalDistance& distance, uint32_t neighbors_to_find,
                         FurthestPriQ& best_neighbors, uint32_t level, const GlobalFilter *filter) const
 {
     uint32_t doc_id_limit = _graph.node_refs_size.load(std::memory_order_acquire);
@@ -321,12 +519,15 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
     uint32_t estimated_visited_nodes = estimate_visited_nodes(level, doc_id_limit, neighbors_to_find, filter);
 #if ! USE_OLD_VISITED_TRACKER
     if (estimated_visited_nodes >= doc_id_limit / 128) {
-        search_layer_helper<BitVectorVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, estimated_visited_nodes);
+        BitVectorVisitedTracker visited(*this, doc_id_limit, estimated_visited_nodes);
+        search_layer_helper(distance, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, visited);
     } else {
-        search_layer_helper<HashSetVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, estimated_visited_nodes);
+        HashSetVisitedTracker visited(*this, doc_id_limit, estimated_visited_nodes);
+        search_layer_helper(distance, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, visited);
     }
 #else
-    search_layer_helper<ReusableSetVisitedTracker>(input, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, estimated_visited_nodes);
+    ReusableSetVisitedTracker visited(*this, doc_id_limit, estimated_visited_nodes);
+    search_layer_helper(distance, neighbors_to_find, best_neighbors, level, filter, doc_id_limit, visited);
 #endif
 }
 
@@ -338,9 +539,22 @@ HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distan
       _level_generator(std::move(level_generator)),
       _cfg(cfg),
       _visited_set_pool(),
-      _compaction_spec()
+      _compaction_spec(),
+      _quantized_metric(),
+      _quantizer_max_abs_value(0.0),
+      _quantized_vectors(),
+      _published_quantized_vectors(nullptr),
+      _pending_quantized_vectors(),
+      _pending_reencode_docid(0),
+      _retired_quantized_vectors()
 {
     assert(_distance_func);
+    auto cell_type = _distance_func->expected_cell_type();
+    if (_cfg.quantize_vectors() &&
+        ((cell_type == vespalib::eval::CellType::FLOAT) || (cell_type == vespalib::eval::CellType::DOUBLE)))
+    {
+        _quantized_metric = quantized_metric(*_distance_func);
+    }
 }
 
 HnswIndex::~HnswIndex() = default;
@@ -365,11 +579,13 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
         return op;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(input_vector, entry.docid);
+    // Graph construction always uses exact distances.
+    TraversalDistance distance(*this, input_vector, nullptr);
+    double entry_dist = distance.calc(entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > op.max_level) {
-        entry_point = find_nearest_in_layer(input_vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(distance, entry_point, search_level);
         --search_level;
     }
 
@@ -379,7 +595,7 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
 
     // Find neighbors of the added document in each level it should exist in.
     while (search_level >= 0) {
-        search_layer(input_vector, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
+        search_layer(distance, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
         auto neighbors = select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
         op.connections[search_level].reserve(neighbors.used.size());
         for (const auto & neighbor : neighbors.used) {
@@ -391,11 +607,46 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
                     docid, neighbor.docid, search_level, neighbor_levels.size());
             }
         }
+        prepare_shrinks(docid, input_vector, search_level, neighbors.used, op.shrinks[search_level]);
         --search_level;
     }
     return op;
 }
 
+void
+HnswIndex::prepare_shrinks(uint32_t docid, TypedCells input_vector, uint32_t level,
+                           const HnswCandidateVector& neighbors, PreparedLinkArrays& shrinks) const
+{
+    // Shrinking the link arrays of the neighbors is the costly part of completing an add,
+    // and is done here in the prepare step (which can run in any thread) when possible.
+    uint32_t max_links = max_links_for_level(level);
+    PendingDocVectorAccess vectors(_vectors, docid, input_vector);
+    for (const auto & neighbor : neighbors) {
+        auto neighbor_levels = _graph.get_level_array(neighbor.node_ref);
+        if (level >= neighbor_levels.size()) {
+            continue;
+        }
+        auto old_links_ref = neighbor_levels[level].load_acquire();
+        auto old_links = old_links_ref.valid() ? _graph.links.get(old_links_ref) : LinkArrayRef();
+        if (old_links.size() + 1 <= max_links) {
+            continue;
+        }
+        HnswCandidateVector candidates;
+        candidates.reserve(old_links.size() + 1);
+        for (uint32_t link : old_links) {
+            candidates.emplace_back(link, calc_distance(vectors, neighbor.docid, link));
+        }
+        candidates.emplace_back(docid, neighbor.distance);
+        auto split = select_neighbors(vectors, candidates, max_links);
+        auto& prepared = shrinks.emplace_back(neighbor.docid, old_links_ref);
+        prepared.new_links.reserve(split.used.size());
+        for (const auto & used : split.used) {
+            prepared.new_links.push_back(used.docid);
+        }
+        prepared.removed = std::move(split.unused);
+    }
+}
+
 HnswIndex::LinkArray 
 HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neighbors, uint32_t self_docid)
 {
@@ -418,10 +669,11 @@ HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neig
 void
 HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
 {
+    set_quantized_vector(docid);
     auto node_ref = _graph.make_node_for_document(docid, op.max_level + 1);
     for (int level = 0; level <= op.max_level; ++level) {
         auto neighbors = filter_valid_docids(level, op.connections[level], docid);
-        connect_new_node(docid, neighbors, level);
+        connect_new_node(docid, neighbors, level, &op.shrinks[level]);
     }
     if (op.max_level > get_entry_level()) {
         _graph.set_entry_node({docid, node_ref, op.max_level});
@@ -513,6 +765,13 @@ HnswIndex::remove_document(uint32_t docid)
 void
 HnswIndex::transfer_hold_lists(generation_t current_gen)
 {
+    consider_publish_quantized_vectors(current_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->transfer_hold_lists(current_gen);
+    }
+    if (_pending_quantized_vectors) {
+        _pending_quantized_vectors->transfer_hold_lists(current_gen);
+    }
     // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
     //       We need to set the next generation here, as it is incremented on a higher level right after this call.
     _graph.node_refs.setGeneration(current_gen + 1);
@@ -526,6 +785,15 @@ HnswIndex::trim_hold_lists(generation_t first_used_gen)
     _graph.node_refs.removeOldGenerations(first_used_gen);
     _graph.nodes.trimHoldLists(first_used_gen);
     _graph.links.trimHoldLists(first_used_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->trim_hold_lists(first_used_gen);
+    }
+    if (_pending_quantized_vectors) {
+        _pending_quantized_vectors->trim_hold_lists(first_used_gen);
+    }
+    while (!_retired_quantized_vectors.empty() && (_retired_quantized_vectors.front().first < first_used_gen)) {
+        _retired_quantized_vectors.erase(_retired_quantized_vectors.begin());
+    }
 }
 
 void
@@ -598,6 +866,15 @@ HnswIndex::update_stat(const CompactionStrategy& compaction_strategy)
                                                compaction_strategy.should_compact(link_arrays_memory_usage, link_arrays_address_space_usage));
     result.merge(link_arrays_memory_usage);
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
+    if (_pending_quantized_vectors) {
+        result.merge(_pending_quantized_vectors->memory_usage());
+    }
+    for (const auto& retired : _retired_quantized_vectors) {
+        result.mergeGenerationHeldBytes(retired.second->memory_usage().allocatedBytes());
+    }
     return result;
 }
 
@@ -609,6 +886,15 @@ HnswIndex::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
+    if (_pending_quantized_vectors) {
+        result.merge(_pending_quantized_vectors->memory_usage());
+    }
+    for (const auto& retired : _retired_quantized_vectors) {
+        result.mergeGenerationHeldBytes(retired.second->memory_usage().allocatedBytes());
+    }
     return result;
 }
 
@@ -629,6 +915,9 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     StateExplorerUtils::memory_usage_to_slime(_graph.nodes.getMemoryUsage(), memUsageObj.setObject("nodes"));
     StateExplorerUtils::memory_usage_to_slime(_graph.links.getMemoryUsage(), memUsageObj.setObject("links"));
     StateExplorerUtils::memory_usage_to_slime(_visited_set_pool.memory_usage(), memUsageObj.setObject("visited_set_pool"));
+    if (_quantized_vectors) {
+        StateExplorerUtils::memory_usage_to_slime(_quantized_vectors->memory_usage(), memUsageObj.setObject("quantized_vectors"));
+    }
     auto& visitedObj = object.setObject("visited_set");
     visitedObj.setLong("create_count", _visited_set_pool.create_count());
     visitedObj.setLong("reuse_count", _visited_set_pool.reuse_count());
@@ -660,6 +949,7 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    cfgObj.setBool("quantize_vectors", _cfg.quantize_vectors());
 }
 
 void
@@ -698,12 +988,9 @@ struct NeighborsByDocId {
 };
 
 std::vector<NearestNeighborIndex::Neighbor>
-HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
-                          const GlobalFilter *filter, uint32_t explore_k,
-                          double distance_threshold) const
+HnswIndex::top_k_by_docid(uint32_t k, FurthestPriQ candidates, double distance_threshold)
 {
     std::vector<Neighbor> result;
-    FurthestPriQ candidates = top_k_candidates(vector, std::max(k, explore_k), filter);
     while (candidates.size() > k) {
         candidates.pop();
     }
@@ -716,6 +1003,14 @@ HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
     return result;
 }
 
+std::vector<NearestNeighborIndex::Neighbor>
+HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
+                          const GlobalFilter *filter, uint32_t explore_k,
+                          double distance_threshold) const
+{
+    return top_k_by_docid(k, top_k_candidates(vector, std::max(k, explore_k), filter), distance_threshold);
+}
+
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex::find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k,
                       double distance_threshold) const
@@ -731,25 +1026,56 @@ HnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
     return top_k_by_docid(k, vector, &filter, explore_k, distance_threshold);
 }
 
-FurthestPriQ
-HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const
+bool
+HnswIndex::find_level_0_entry_point(TraversalDistance& distance, FurthestPriQ& best_neighbors) const
 {
-    FurthestPriQ best_neighbors;
     auto entry = _graph.get_entry_node();
     if (entry.docid == 0) {
         // graph has no entry point
-        return best_neighbors;
+        return false;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(vector, entry.docid);
+    double entry_dist = distance.calc(entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer(distance, entry_point, search_level);
         --search_level;
     }
     best_neighbors.push(entry_point);
-    search_layer(vector, k, best_neighbors, 0, filter);
+    return true;
+}
+
+FurthestPriQ
+HnswIndex::rerank_with_exact_distances(const TypedCells& vector, const FurthestPriQ& candidates) const
+{
+    // The full-precision vectors might be paged to disk, so they are prefetched as a batch first.
+    std::vector<uint32_t> docids;
+    docids.reserve(candidates.size());
+    for (const HnswCandidate & candidate : candidates.peek()) {
+        docids.push_back(candidate.docid);
+    }
+    _vectors.prefetch_vectors(docids);
+    FurthestPriQ reranked;
+    for (const HnswCandidate & candidate : candidates.peek()) {
+        reranked.emplace(candidate.docid, candidate.node_ref, calc_distance(vector, candidate.docid));
+    }
+    return reranked;
+}
+
+FurthestPriQ
+HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const
+{
+    FurthestPriQ best_neighbors;
+    TraversalDistance distance(*this, vector, get_quantized_vectors());
+    if (!find_level_0_entry_point(distance, best_neighbors)) {
+        return best_neighbors;
+    }
+    search_layer(distance, k, best_neighbors, 0, filter);
+    if (distance.approximate()) {
+        // Re-rank the candidates found using quantized vectors against the full-precision vectors.
+        return rerank_with_exact_distances(vector, best_neighbors);
+    }
     return best_neighbors;
 }
 
@@ -776,6 +1102,7 @@ HnswIndex::set_node(uint32_t docid, const HnswNode &node)
 {
     size_t num_levels = node.size();
     assert(num_levels > 0);
+    set_quantized_vector(docid);
     auto node_ref = _graph.make_node_for_document(docid, num_levels);
     for (size_t level = 0; level < num_levels; ++level) {
         connect_new_node(docid, node.level(level), level);
@@ -7,6 +7,7 @@
 #include "hnsw_index_utils.h"
 #include "hnsw_node.h"
 #include "nearest_neighbor_index.h"
+#include "quantized_vector_store.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
 #include <vespa/eval/eval/typed_cells.h>
@@ -17,6 +18,7 @@
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/util/reusable_set_pool.h>
 #include <vespa/vespalib/stllike/allocator.h>
+#include <optional>
 
 namespace search::tensor {
 
@@ -31,6 +33,12 @@ namespace search::tensor {
  * "Efficient and robust approximate nearest neighbor search using Hierarchical Navigable Small World graphs" (Yu. A. Malkov, D. A. Yashunin),
  * but some adjustments are made to support proper removes.
  *
+ * When enabled in the config, an int8 scalar quantized copy of each vector is used to calculate
+ * approximate distances when traversing the graph. This copy is stored in addition to the
+ * full-precision vectors, so memory usage increases. The quantizer is trained (and later retrained
+ * if too many cells are outside its range) in the write thread, by encoding the existing vectors a
+ * few at a time for each put into a new store that replaces the old one when it is complete.
+ *
  * TODO: Add details on how to handle removes.
  */
 class HnswIndex : public NearestNeighborIndex {
@@ -42,26 +50,35 @@ public:
         uint32_t _neighbors_to_explore_at_construction;
         uint32_t _min_size_before_two_phase;
         bool _heuristic_select_neighbors;
+        bool _quantize_vectors;
 
     public:
         Config(uint32_t max_links_at_level_0_in,
                uint32_t max_links_on_inserts_in,
                uint32_t neighbors_to_explore_at_construction_in,
                uint32_t min_size_before_two_phase_in,
-               bool heuristic_select_neighbors_in)
+               bool heuristic_select_neighbors_in,
+               bool quantize_vectors_in = false)
             : _max_links_at_level_0(max_links_at_level_0_in),
               _max_links_on_inserts(max_links_on_inserts_in),
               _neighbors_to_explore_at_construction(neighbors_to_explore_at_construction_in),
               _min_size_before_two_phase(min_size_before_two_phase_in),
-              _heuristic_select_neighbors(heuristic_select_neighbors_in)
+              _heuristic_select_neighbors(heuristic_select_neighbors_in),
+              _quantize_vectors(quantize_vectors_in)
         {}
         uint32_t max_links_at_level_0() const { return _max_links_at_level_0; }
         uint32_t max_links_on_inserts() const { return _max_links_on_inserts; }
         uint32_t neighbors_to_explore_at_construction() const { return _neighbors_to_explore_at_construction; }
         uint32_t min_size_before_two_phase() const { return _min_size_before_two_phase; }
         bool heuristic_select_neighbors() const { return _heuristic_select_neighbors; }
+        bool quantize_vectors() const { return _quantize_vectors; }
     };
 
+    // Number of documents needed in the graph before the scalar quantizer is trained.
+    static constexpr uint32_t min_size_before_quantization = 1024;
+    // Number of docids re-encoded with a newly trained scalar quantizer per put.
+    static constexpr uint32_t reencoded_docids_per_put = 32;
+
     class HnswIndexCompactionSpec {
         CompactionSpec _level_arrays;
         CompactionSpec _link_arrays;
@@ -100,6 +117,38 @@ protected:
     Config _cfg;
     mutable vespalib::ReusableSetPool _visited_set_pool;
     HnswIndexCompactionSpec _compaction_spec;
+    std::optional<QuantizedVectorStore::Metric> _quantized_metric;
+    // Largest absolute cell value seen in vectors put to the index, used to train the scalar quantizer.
+    float _quantizer_max_abs_value;
+    std::unique_ptr<QuantizedVectorStore> _quantized_vectors;
+    std::atomic<const QuantizedVectorStore*> _published_quantized_vectors;
+    // Quantized vector store using a newly trained quantizer, filled incrementally before it is published.
+    std::unique_ptr<QuantizedVectorStore> _pending_quantized_vectors;
+    uint32_t _pending_reencode_docid;
+    // Quantized vector stores replaced by retraining, kept until no readers can be using them.
+    std::vector<std::pair<generation_t, std::unique_ptr<QuantizedVectorStore>>> _retired_quantized_vectors;
+
+    /**
+     * Calculates the distance between an input vector and documents in the graph while traversing it.
+     * When quantized vectors are given the input vector is quantized once, and approximate
+     * distances are calculated directly on the int8 codes.
+     */
+    class TraversalDistance {
+    private:
+        const HnswIndex&            _index;
+        const TypedCells&           _input;
+        const QuantizedVectorStore* _quantized;
+        std::vector<int8_t>         _input_codes;
+        std::vector<const int8_t*>  _codes;
+        std::vector<TypedCells>     _vectors;
+    public:
+        TraversalDistance(const HnswIndex& index, const TypedCells& input, const QuantizedVectorStore* quantized);
+        ~TraversalDistance();
+        bool approximate() const noexcept { return _quantized != nullptr; }
+        double calc(uint32_t docid);
+        // Calculates the distances to a batch of documents, e.g. all unvisited neighbors of a node.
+        void calc(vespalib::ConstArrayRef<uint32_t> docids, double* distances);
+    };
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t docid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -115,17 +164,39 @@ protected:
      * where the candidate is located.
      * Used by select_neighbors_heuristic().
      */
-    bool have_closer_distance(HnswCandidate candidate, const HnswCandidateVector& curr_result) const;
+    bool have_closer_distance(const DocVectorAccess& vectors, HnswCandidate candidate, const HnswCandidateVector& curr_result) const;
     struct SelectResult {
         HnswCandidateVector used;
         LinkArray unused;
         ~SelectResult() {}
     };
-    SelectResult select_neighbors_heuristic(const HnswCandidateVector& neighbors, uint32_t max_links) const;
+    SelectResult select_neighbors_heuristic(const DocVectorAccess& vectors, const HnswCandidateVector& neighbors, uint32_t max_links) const;
     SelectResult select_neighbors_simple(const HnswCandidateVector& neighbors, uint32_t max_links) const;
-    SelectResult select_neighbors(const HnswCandidateVector& neighbors, uint32_t max_links) const;
+    SelectResult select_neighbors(const DocVectorAccess& vectors, const HnswCandidateVector& neighbors, uint32_t max_links) const;
+    SelectResult select_neighbors(const HnswCandidateVector& neighbors, uint32_t max_links) const {
+        return select_neighbors(_vectors, neighbors, max_links);
+    }
     void shrink_if_needed(uint32_t docid, uint32_t level);
-    void connect_new_node(uint32_t docid, const LinkArrayRef &neighbors, uint32_t level);
+
+    /**
+     * The shrunk link array of an existing node, calculated in the prepare step of adding a document.
+     * It is only applied in the complete step if the link array of the node is unchanged since then.
+     */
+    struct PreparedLinkArray {
+        uint32_t docid;
+        vespalib::datastore::EntryRef old_links_ref;
+        LinkArray new_links;
+        LinkArray removed;
+        PreparedLinkArray(uint32_t docid_in, vespalib::datastore::EntryRef old_links_ref_in)
+            : docid(docid_in), old_links_ref(old_links_ref_in), new_links(), removed()
+        {}
+        ~PreparedLinkArray();
+        PreparedLinkArray(PreparedLinkArray&& other) noexcept = default;
+    };
+    using PreparedLinkArrays = std::vector<PreparedLinkArray>;
+    void connect_new_node(uint32_t docid, const LinkArrayRef &neighbors, uint32_t level,
+                          const PreparedLinkArrays* prepared_shrinks = nullptr);
+    bool try_apply_prepared_link_array(uint32_t docid, uint32_t level, const PreparedLinkArray& prepared);
     void mutual_reconnect(const LinkArrayRef &cluster, uint32_t level);
     void remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level);
 
@@ -134,23 +205,35 @@ protected:
     }
 
     double calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const;
+    double calc_distance(const DocVectorAccess& vectors, uint32_t lhs_docid, uint32_t rhs_docid) const;
     double calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const;
+    void set_quantized_vector(uint32_t docid);
+    void consider_train_quantizer(uint32_t dims);
+    void reencode_quantized_vectors(uint32_t max_docids);
+    void consider_publish_quantized_vectors(generation_t current_gen);
     uint32_t estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const;
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const;
+    HnswCandidate find_nearest_in_layer(TraversalDistance& distance, const HnswCandidate& entry_point, uint32_t level) const;
     template <class VisitedTracker>
-    void search_layer_helper(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+    void search_layer_helper(TraversalDistance& distance, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
                              uint32_t level, const GlobalFilter *filter,
                              uint32_t doc_id_limit,
-                             uint32_t estimated_visited_nodes) const;
-    void search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+                             VisitedTracker& visited) const;
+    void search_layer(TraversalDistance& distance, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
                       uint32_t level, const GlobalFilter *filter = nullptr) const;
+    /**
+     * Finds the entry point for searching level 0 by greedy search in the levels above.
+     * Returns false if the graph is empty.
+     */
+    bool find_level_0_entry_point(TraversalDistance& distance, FurthestPriQ& best_neighbors) const;
+    FurthestPriQ rerank_with_exact_distances(const TypedCells& vector, const FurthestPriQ& candidates) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
                                          const GlobalFilter *filter, uint32_t explore_k,
                                          double distance_threshold) const;
+    static std::vector<Neighbor> top_k_by_docid(uint32_t k, FurthestPriQ candidates, double distance_threshold);
 
     struct PreparedFirstAddDoc : public PrepareResult {};
 
@@ -161,16 +244,21 @@ protected:
         ReadGuard read_guard;
         using Links = std::vector<std::pair<uint32_t, HnswGraph::NodeRef>>;
         std::vector<Links> connections;
+        // Per level: neighbors that must be shrunk when linked to the new document.
+        std::vector<PreparedLinkArrays> shrinks;
         PreparedAddDoc(uint32_t docid_in, int32_t max_level_in, ReadGuard read_guard_in)
           : docid(docid_in), max_level(max_level_in),
             read_guard(std::move(read_guard_in)),
-            connections(max_level+1)
+            connections(max_level+1),
+            shrinks(max_level+1)
         {}
         ~PreparedAddDoc() = default;
         PreparedAddDoc(PreparedAddDoc&& other) = default;
     };
     PreparedAddDoc internal_prepare_add(uint32_t docid, TypedCells input_vector,
                                         vespalib::GenerationHandler::Guard read_guard) const;
+    void prepare_shrinks(uint32_t docid, TypedCells input_vector, uint32_t level,
+                         const HnswCandidateVector& neighbors, PreparedLinkArrays& shrinks) const;
     LinkArray filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neighbors, uint32_t me);
     void internal_complete_add(uint32_t docid, PreparedAddDoc &op);
 public:
@@ -212,6 +300,10 @@ public:
 
     FurthestPriQ top_k_candidates(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const;
 
+    const QuantizedVectorStore* get_quantized_vectors() const noexcept {
+        return _published_quantized_vectors.load(std::memory_order_acquire);
+    }
+
     uint32_t get_entry_docid() const { return _graph.get_entry_node().docid; }
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
 
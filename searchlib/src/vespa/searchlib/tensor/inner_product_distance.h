@@ -5,6 +5,8 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace search::tensor {
@@ -57,6 +59,30 @@ public:
         double score = 1.0 - _computer.dotProduct(&lhs_vector[0], &rhs_vector[0], sz);
         return std::max(0.0, score);
     }
+    void calc_many(const vespalib::eval::TypedCells& lhs,
+                   vespalib::ConstArrayRef<vespalib::eval::TypedCells> rhs,
+                   double* distances) const override
+    {
+        constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
+        assert(lhs.type == expected);
+        auto lhs_vector = lhs.typify<FloatType>();
+        size_t sz = lhs_vector.size();
+        constexpr size_t batch_size = 32;
+        std::array<const FloatType *, batch_size> rhs_cells;
+        for (size_t i = 0; i < rhs.size(); i += batch_size) {
+            size_t count = std::min(batch_size, rhs.size() - i);
+            for (size_t j = 0; j < count; ++j) {
+                assert(rhs[i + j].type == expected);
+                auto rhs_vector = rhs[i + j].typify<FloatType>();
+                assert(sz == rhs_vector.size());
+                rhs_cells[j] = rhs_vector.data();
+            }
+            _computer.dotProduct(lhs_vector.data(), rhs_cells.data(), count, sz, distances + i);
+            for (size_t j = 0; j < count; ++j) {
+                distances[i + j] = std::max(0.0, 1.0 - distances[i + j]);
+            }
+        }
+    }
 private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
@@ -0,0 +1,80 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+#include <cmath>
+
+namespace search::tensor {
+
+QuantizedVectorStore::QuantizedVectorStore(ScalarQuantizer quantizer, Metric metric)
+    : _quantizer(std::move(quantizer)),
+      _metric(metric),
+      _scale_sq(double(_quantizer.scale()) * _quantizer.scale()),
+      _codes(vespalib::GrowStrategy(64_Ki, 0.5, 0, 0)),
+      _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator()),
+      _num_encoded(0),
+      _num_clamped(0)
+{
+}
+
+QuantizedVectorStore::~QuantizedVectorStore() = default;
+
+void
+QuantizedVectorStore::set_vector(uint32_t docid, const vespalib::eval::TypedCells& vector)
+{
+    size_t start = size_t(docid) * dims();
+    _codes.ensure_size(start + dims());
+    ++_num_encoded;
+    if (_quantizer.encode(vector, &_codes[start]) > 0) {
+        ++_num_clamped;
+    }
+}
+
+double
+QuantizedVectorStore::calc(const int8_t* lhs, uint32_t docid) const
+{
+    const int8_t* rhs = get_codes(docid);
+    size_t sz = dims();
+    switch (_metric) {
+    case Metric::SQUARED_EUCLIDEAN:
+        return _scale_sq * _computer.squaredEuclideanDistance(lhs, rhs, sz);
+    case Metric::INNER_PRODUCT:
+        return std::max(0.0, 1.0 - _scale_sq * _computer.dotProduct(lhs, rhs, sz));
+    case Metric::ANGULAR:
+        break;
+    }
+    // The scale cancels out when calculating the cosine similarity.
+    double squared_norms = double(_computer.dotProduct(lhs, lhs, sz)) * _computer.dotProduct(rhs, rhs, sz);
+    double div = (squared_norms > 0) ? std::sqrt(squared_norms) : 1.0;
+    return 1.0 - (_computer.dotProduct(lhs, rhs, sz) / div);
+}
+
+void
+QuantizedVectorStore::calc_many(const int8_t* lhs, vespalib::ConstArrayRef<uint32_t> docids,
+                                std::vector<const int8_t*>& rhs_buf, double* distances) const
+{
+    if (_metric == Metric::ANGULAR) {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            distances[i] = calc(lhs, docids[i]);
+        }
+        return;
+    }
+    rhs_buf.clear();
+    for (uint32_t docid : docids) {
+        rhs_buf.push_back(get_codes(docid));
+    }
+    if (_metric == Metric::SQUARED_EUCLIDEAN) {
+        _computer.squaredEuclideanDistance(lhs, rhs_buf.data(), rhs_buf.size(), dims(), distances);
+        for (size_t i = 0; i < docids.size(); ++i) {
+            distances[i] *= _scale_sq;
+        }
+    } else {
+        _computer.dotProduct(lhs, rhs_buf.data(), rhs_buf.size(), dims(), distances);
+        for (size_t i = 0; i < docids.size(); ++i) {
+            distances[i] = std::max(0.0, 1.0 - _scale_sq * distances[i]);
+        }
+    }
+}
+
+}
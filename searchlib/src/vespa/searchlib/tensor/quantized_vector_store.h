@@ -0,0 +1,89 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "scalar_quantizer.h"
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+
+namespace search::tensor {
+
+/**
+ * Stores an int8 scalar quantized copy of the vector for each document.
+ *
+ * The quantized vectors are used to calculate approximate distances directly on the
+ * int8 codes when traversing the hnsw graph, while the full-precision vectors are only
+ * used when re-ranking the best candidates. Note that the full-precision vectors are still
+ * kept in the tensor store, so the codes add 1 byte per dimension to the memory footprint
+ * of the attribute (25% for float vectors and 12.5% for double vectors).
+ *
+ * The store keeps track of how many encoded vectors were outside the range the quantizer
+ * was trained on, which is used to decide when the quantizer should be retrained. A retrained
+ * quantizer gets a new store, which is filled incrementally and then replaces this one.
+ *
+ * The store supports 1 write thread and multiple reader threads, where readers
+ * must hold a generation guard and only access vectors of documents present in the graph.
+ */
+class QuantizedVectorStore {
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+    /**
+     * The distance metrics that can be calculated on the int8 codes.
+     * The distances match those of the corresponding distance functions.
+     */
+    enum class Metric { SQUARED_EUCLIDEAN, INNER_PRODUCT, ANGULAR };
+
+    // Number of vectors encoded after training before considering retraining of the quantizer.
+    static constexpr uint32_t min_encoded_before_retraining = 1024;
+    // Fraction of encoded vectors with clamped cells that triggers retraining of the quantizer.
+    static constexpr double max_clamped_ratio = 0.01;
+
+private:
+    ScalarQuantizer              _quantizer;
+    Metric                       _metric;
+    double                       _scale_sq;
+    vespalib::RcuVector<int8_t>  _codes;
+    const vespalib::hwaccelrated::IAccelrated& _computer;
+    uint32_t                     _num_encoded;
+    uint32_t                     _num_clamped;
+
+public:
+    QuantizedVectorStore(ScalarQuantizer quantizer, Metric metric);
+    ~QuantizedVectorStore();
+
+    const ScalarQuantizer& quantizer() const noexcept { return _quantizer; }
+    uint32_t dims() const noexcept { return _quantizer.dims(); }
+
+    // Called by writer only
+    void set_vector(uint32_t docid, const vespalib::eval::TypedCells& vector);
+    bool needs_retraining() const noexcept {
+        return (_num_encoded >= min_encoded_before_retraining) &&
+               (_num_clamped > _num_encoded * max_clamped_ratio);
+    }
+
+    const int8_t* get_codes(uint32_t docid) const noexcept {
+        return &_codes.acquire_elem_ref(size_t(docid) * dims());
+    }
+
+    /**
+     * Calculates the approximate distance between the given query codes and the document.
+     */
+    double calc(const int8_t* lhs, uint32_t docid) const;
+
+    /**
+     * Calculates the approximate distances between the given query codes and a batch of documents,
+     * using 'rhs_buf' to hold pointers to the codes of the documents.
+     */
+    void calc_many(const int8_t* lhs, vespalib::ConstArrayRef<uint32_t> docids,
+                   std::vector<const int8_t*>& rhs_buf, double* distances) const;
+
+    void transfer_hold_lists(generation_t current_gen) { _codes.setGeneration(current_gen + 1); }
+    void trim_hold_lists(generation_t first_used_gen) { _codes.removeOldGenerations(first_used_gen); }
+    vespalib::MemoryUsage memory_usage() const { return _codes.getMemoryUsage(); }
+};
+
+}
@@ -0,0 +1,74 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "scalar_quantizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using vespalib::eval::CellType;
+using vespalib::eval::TypedCells;
+
+namespace search::tensor {
+
+ScalarQuantizer::ScalarQuantizer(uint32_t dims, float max_abs_value)
+    : _dims(dims),
+      _scale((max_abs_value > 0.0) ? (max_abs_value / max_code) : 1.0)
+{
+}
+
+ScalarQuantizer::~ScalarQuantizer() = default;
+
+namespace {
+
+template <typename FloatType>
+float
+max_abs_value_helper(vespalib::ConstArrayRef<FloatType> vector)
+{
+    float result = 0.0;
+    for (FloatType value : vector) {
+        result = std::max(result, std::abs(float(value)));
+    }
+    return result;
+}
+
+}
+
+float
+ScalarQuantizer::max_abs_value(const TypedCells& vector)
+{
+    if (vector.type == CellType::DOUBLE) {
+        return max_abs_value_helper(vector.typify<double>());
+    } else {
+        return max_abs_value_helper(vector.typify<float>());
+    }
+}
+
+template <typename FloatType>
+uint32_t
+ScalarQuantizer::encode_helper(vespalib::ConstArrayRef<FloatType> vector, int8_t* dst) const
+{
+    assert(vector.size() == _dims);
+    constexpr float max = max_code;
+    uint32_t clamped = 0;
+    for (uint32_t i = 0; i < _dims; ++i) {
+        float code = std::nearbyint(float(vector[i]) / _scale);
+        if (code > max || code < -max) {
+            code = std::clamp(code, -max, max);
+            ++clamped;
+        }
+        dst[i] = int32_t(code);
+    }
+    return clamped;
+}
+
+uint32_t
+ScalarQuantizer::encode(const TypedCells& vector, int8_t* dst) const
+{
+    if (vector.type == CellType::DOUBLE) {
+        return encode_helper(vector.typify<double>(), dst);
+    } else {
+        return encode_helper(vector.typify<float>(), dst);
+    }
+}
+
+}
@@ -0,0 +1,51 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/typed_cells.h>
+#include <cstdint>
+
+namespace search::tensor {
+
+/**
+ * Symmetric scalar quantizer mapping each cell of a float or double vector to an int8 code.
+ *
+ * All dimensions share a single scale given by the largest absolute cell value the quantizer
+ * is trained for, so that a cell value is approximated by 'scale * code'. This makes it
+ * possible to calculate distances directly on the int8 codes. Values outside the trained
+ * range are clamped to the nearest code.
+ */
+class ScalarQuantizer {
+private:
+    uint32_t _dims;
+    float    _scale;
+
+    template <typename FloatType>
+    uint32_t encode_helper(vespalib::ConstArrayRef<FloatType> vector, int8_t* dst) const;
+
+public:
+    static constexpr int32_t max_code = 127;
+
+    /**
+     * Creates a quantizer for vectors with 'dims' cells of type float or double,
+     * where the absolute cell values are expected to be at most 'max_abs_value'.
+     */
+    ScalarQuantizer(uint32_t dims, float max_abs_value);
+    ~ScalarQuantizer();
+
+    /**
+     * Returns the largest absolute cell value of the given float or double vector.
+     */
+    static float max_abs_value(const vespalib::eval::TypedCells& vector);
+
+    uint32_t dims() const noexcept { return _dims; }
+    float scale() const noexcept { return _scale; }
+
+    /**
+     * Encodes the given vector into 'dims' codes.
+     * Returns the number of cells that were outside the trained range and had to be clamped.
+     */
+    uint32_t encode(const vespalib::eval::TypedCells& vector, int8_t* dst) const;
+};
+
+}
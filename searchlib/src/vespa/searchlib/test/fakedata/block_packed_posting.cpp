@@ -0,0 +1,185 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_packed_posting.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace search::fakedata {
+
+namespace {
+
+constexpr uint32_t block_size = BlockPackedPosting::block_size;
+constexpr uint32_t lanes = BlockPackedPosting::lanes;
+constexpr uint32_t rows = block_size / lanes;
+constexpr uint32_t max_offset = 1u << 26;
+
+/*
+ * Unpack a block with a compile time bit width. The inner loop over
+ * lanes is independent per lane and is vectorized by the compiler.
+ */
+template <uint32_t bits>
+void
+unpack_block_bits(const uint32_t * __restrict__ src, uint32_t * __restrict__ dst)
+{
+    if constexpr (bits == 0) {
+        (void) src;
+        memset(dst, 0, block_size * sizeof(uint32_t));
+    } else {
+        constexpr uint32_t mask = (bits == 32) ? ~0u : ((1u << bits) - 1);
+#pragma GCC unroll 32
+        for (uint32_t row = 0; row < rows; ++row) {
+            const uint32_t pos = row * bits;
+            const uint32_t word = pos / 32;
+            const uint32_t shift = pos % 32;
+            for (uint32_t lane = 0; lane < lanes; ++lane) {
+                uint32_t val = src[word * lanes + lane] >> shift;
+                if (shift + bits > 32) {
+                    val |= src[(word + 1) * lanes + lane] << (32 - shift);
+                }
+                dst[row * lanes + lane] = val & mask;
+            }
+        }
+    }
+}
+
+using UnpackFunc = void (*)(const uint32_t *, uint32_t *);
+
+template <size_t... Bits>
+constexpr auto
+make_unpack_funcs(std::index_sequence<Bits...>)
+{
+    return std::array<UnpackFunc, sizeof...(Bits)>{ &unpack_block_bits<Bits>... };
+}
+
+constexpr auto unpack_funcs = make_unpack_funcs(std::make_index_sequence<33>());
+
+uint32_t
+packed_offset(uint32_t offset_bits) noexcept
+{
+    return offset_bits >> 6;
+}
+
+uint32_t
+packed_bits(uint32_t offset_bits) noexcept
+{
+    return offset_bits & 63;
+}
+
+}
+
+void
+BlockPackedPosting::pack_block(const uint32_t *src, uint32_t bits, uint32_t *dst)
+{
+    assert(bits <= 32);
+    memset(dst, 0, packed_block_words(bits) * sizeof(uint32_t));
+    if (bits == 0) {
+        return;
+    }
+    for (uint32_t row = 0; row < rows; ++row) {
+        const uint32_t pos = row * bits;
+        const uint32_t word = pos / 32;
+        const uint32_t shift = pos % 32;
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            uint32_t val = src[row * lanes + lane];
+            dst[word * lanes + lane] |= val << shift;
+            if (shift + bits > 32) {
+                dst[(word + 1) * lanes + lane] |= val >> (32 - shift);
+            }
+        }
+    }
+}
+
+void
+BlockPackedPosting::unpack_block(const uint32_t *src, uint32_t bits, uint32_t *dst)
+{
+    assert(bits <= 32);
+    unpack_funcs[bits](src, dst);
+}
+
+BlockPackedPostingWriter::BlockPackedPostingWriter()
+    : _skip(),
+      _blocks(),
+      _deltas(),
+      _num_deltas(0),
+      _num_docs(0),
+      _prev_doc_id(0)
+{
+}
+
+BlockPackedPostingWriter::~BlockPackedPostingWriter() = default;
+
+void
+BlockPackedPostingWriter::flush_block()
+{
+    if (_num_deltas == 0) {
+        return;
+    }
+    std::fill(_deltas + _num_deltas, _deltas + block_size, 0u);
+    uint32_t max_delta = *std::max_element(_deltas, _deltas + _num_deltas);
+    uint32_t bits = (max_delta == 0) ? 0 : (32 - __builtin_clz(max_delta));
+    uint32_t offset = _blocks.size();
+    assert(offset < max_offset);
+    _skip.push_back(_prev_doc_id);
+    _skip.push_back((offset << 6) | bits);
+    _blocks.resize(offset + BlockPackedPosting::packed_block_words(bits));
+    BlockPackedPosting::pack_block(_deltas, bits, _blocks.data() + offset);
+    _num_deltas = 0;
+}
+
+void
+BlockPackedPostingWriter::add(uint32_t doc_id)
+{
+    assert(doc_id > _prev_doc_id);
+    _deltas[_num_deltas++] = doc_id - _prev_doc_id - 1;
+    _prev_doc_id = doc_id;
+    ++_num_docs;
+    if (_num_deltas == block_size) {
+        flush_block();
+    }
+}
+
+std::vector<uint32_t>
+BlockPackedPostingWriter::finish()
+{
+    flush_block();
+    std::vector<uint32_t> result;
+    result.reserve(BlockPackedPosting::header_words + _skip.size() + _blocks.size());
+    result.push_back(_num_docs);
+    result.push_back(_skip.size() / BlockPackedPosting::skip_entry_words);
+    result.insert(result.end(), _skip.begin(), _skip.end());
+    result.insert(result.end(), _blocks.begin(), _blocks.end());
+    _skip.clear();
+    _blocks.clear();
+    _num_docs = 0;
+    _prev_doc_id = 0;
+    return result;
+}
+
+void
+BlockPackedPostingView::decode_block(uint32_t block, uint32_t *dst) const
+{
+    uint32_t offset_bits = _data[BlockPackedPosting::header_words + block * BlockPackedPosting::skip_entry_words + 1];
+    BlockPackedPosting::unpack_block(_blocks + packed_offset(offset_bits), packed_bits(offset_bits), dst);
+    uint32_t doc_id = (block > 0) ? last_doc_id(block - 1) : 0;
+    uint32_t docs = block_docs(block);
+    for (uint32_t i = 0; i < docs; ++i) {
+        doc_id += dst[i] + 1;
+        dst[i] = doc_id;
+    }
+}
+
+size_t
+BlockPackedPostingView::words() const noexcept
+{
+    size_t result = _blocks - _data;
+    if (num_blocks() > 0) {
+        uint32_t offset_bits = _data[BlockPackedPosting::header_words + (num_blocks() - 1) * BlockPackedPosting::skip_entry_words + 1];
+        result += packed_offset(offset_bits) + BlockPackedPosting::packed_block_words(packed_bits(offset_bits));
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,105 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace search::fakedata {
+
+/*
+ * Layout of a posting list (docids only) stored as blocks of 128 docid
+ * deltas, each block bit packed using the width of its largest delta.
+ * This is a reference for the posting list benchmark and test, used
+ * through the BlockPackedFilterOcc fake posting type, to compare block
+ * decoding with the Zc formats. It is not a disk index file format: it
+ * stores no features, and it has no posting file reader or writer, no
+ * index config switch and no fusion or memory index support.
+ * Values are interleaved across 4 lanes of 32 bit words, allowing a
+ * block to be unpacked using SIMD instructions. A skip entry per block
+ * with the last docid in the block allows whole blocks to be skipped
+ * without unpacking them.
+ *
+ * All values are 32 bit words:
+ *
+ *   num_docs, num_blocks,
+ *   num_blocks skip entries: last_doc_id, (offset << 6) | bits
+ *   packed blocks: 4 * bits words each
+ *
+ * where offset is relative to the start of the packed blocks.
+ */
+class BlockPackedPosting
+{
+public:
+    static constexpr uint32_t block_size = 128;
+    static constexpr uint32_t lanes = 4;
+    static constexpr uint32_t header_words = 2;
+    static constexpr uint32_t skip_entry_words = 2;
+
+    static uint32_t packed_block_words(uint32_t bits) noexcept { return lanes * bits; }
+
+    /*
+     * Pack block_size values using the given bit width.
+     * dst must have room for packed_block_words(bits) words.
+     */
+    static void pack_block(const uint32_t *src, uint32_t bits, uint32_t *dst);
+
+    /*
+     * Unpack block_size values packed using the given bit width.
+     */
+    static void unpack_block(const uint32_t *src, uint32_t bits, uint32_t *dst);
+};
+
+/*
+ * Class used to build a block packed posting list.
+ */
+class BlockPackedPostingWriter
+{
+    std::vector<uint32_t> _skip;
+    std::vector<uint32_t> _blocks;
+    uint32_t              _deltas[BlockPackedPosting::block_size];
+    uint32_t              _num_deltas;
+    uint32_t              _num_docs;
+    uint32_t              _prev_doc_id;
+
+    void flush_block();
+public:
+    BlockPackedPostingWriter();
+    ~BlockPackedPostingWriter();
+    void add(uint32_t doc_id);  // doc ids must be added in increasing order
+    std::vector<uint32_t> finish();
+};
+
+/*
+ * Read only view of a block packed posting list.
+ */
+class BlockPackedPostingView
+{
+    const uint32_t *_data;
+    const uint32_t *_blocks;
+public:
+    BlockPackedPostingView(const uint32_t *data) noexcept
+        : _data(data),
+          _blocks(data + BlockPackedPosting::header_words + num_blocks() * BlockPackedPosting::skip_entry_words)
+    {
+    }
+    uint32_t num_docs() const noexcept { return _data[0]; }
+    uint32_t num_blocks() const noexcept { return _data[1]; }
+    uint32_t last_doc_id(uint32_t block) const noexcept {
+        return _data[BlockPackedPosting::header_words + block * BlockPackedPosting::skip_entry_words];
+    }
+    uint32_t block_docs(uint32_t block) const noexcept {
+        uint32_t start = block * BlockPackedPosting::block_size;
+        uint32_t left = num_docs() - start;
+        return (left < BlockPackedPosting::block_size) ? left : BlockPackedPosting::block_size;
+    }
+    /*
+     * Decode docids for the given block. dst must have room for
+     * block_size docids.
+     */
+    void decode_block(uint32_t block, uint32_t *dst) const;
+    size_t words() const noexcept;
+};
+
+}
@@ -0,0 +1,85 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_packed_posting_iterator.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <cassert>
+
+namespace search::fakedata {
+
+BlockPackedPostingIterator::BlockPackedPostingIterator(fef::TermFieldMatchDataArray match_data, const uint32_t *data)
+    : RankedSearchIteratorBase(std::move(match_data)),
+      _view(data),
+      _block(_view.num_blocks()),
+      _pos(0),
+      _block_docs(0),
+      _docids()
+{
+    clearUnpacked();
+}
+
+BlockPackedPostingIterator::~BlockPackedPostingIterator() = default;
+
+bool
+BlockPackedPostingIterator::seek_block(uint32_t doc_id)
+{
+    uint32_t num_blocks = _view.num_blocks();
+    uint32_t block = (_block < num_blocks) ? _block + 1 : 0;
+    while (block < num_blocks && _view.last_doc_id(block) < doc_id) {
+        ++block;
+    }
+    _block = block;
+    if (block >= num_blocks) {
+        _block_docs = 0;
+        return false;
+    }
+    _view.decode_block(block, _docids);
+    _block_docs = _view.block_docs(block);
+    _pos = 0;
+    return true;
+}
+
+void
+BlockPackedPostingIterator::initRange(uint32_t begin_id, uint32_t end_id)
+{
+    RankedSearchIteratorBase::initRange(begin_id, end_id);
+    _block = _view.num_blocks();
+    _pos = 0;
+    _block_docs = 0;
+    seek(begin_id);
+}
+
+void
+BlockPackedPostingIterator::doSeek(uint32_t doc_id)
+{
+    if (getUnpacked()) {
+        clearUnpacked();
+    }
+    if (_pos >= _block_docs || _docids[_block_docs - 1] < doc_id) {
+        if (!seek_block(doc_id)) {
+            setAtEnd();
+            return;
+        }
+    }
+    // Last docid in block is at least doc_id
+    while (_docids[_pos] < doc_id) {
+        ++_pos;
+    }
+    if (_docids[_pos] >= getEndId()) {
+        setAtEnd();
+    } else {
+        setDocId(_docids[_pos]);
+    }
+}
+
+void
+BlockPackedPostingIterator::doUnpack(uint32_t doc_id)
+{
+    if (_matchData.size() != 1 || getUnpacked()) {
+        return;
+    }
+    assert(doc_id == getDocId());
+    _matchData[0]->reset(doc_id);
+    setUnpacked();
+}
+
+}
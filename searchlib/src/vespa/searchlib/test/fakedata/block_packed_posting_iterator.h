@@ -0,0 +1,33 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "block_packed_posting.h"
+#include <vespa/searchlib/queryeval/iterators.h>
+
+namespace search::fakedata {
+
+/*
+ * Search iterator over a block packed posting list. Blocks are located
+ * using the skip entries and unpacked a whole block at a time.
+ * Only docids are stored, unpacking only resets the match data.
+ */
+class BlockPackedPostingIterator : public queryeval::RankedSearchIteratorBase
+{
+    BlockPackedPostingView _view;
+    uint32_t               _block;      // Currently decoded block
+    uint32_t               _pos;        // Position in decoded block
+    uint32_t               _block_docs; // Number of docids in decoded block
+    uint32_t               _docids[BlockPackedPosting::block_size];
+
+    bool seek_block(uint32_t doc_id);
+public:
+    BlockPackedPostingIterator(fef::TermFieldMatchDataArray match_data, const uint32_t *data);
+    ~BlockPackedPostingIterator() override;
+    void initRange(uint32_t begin_id, uint32_t end_id) override;
+    void doSeek(uint32_t doc_id) override;
+    void doUnpack(uint32_t doc_id) override;
+    Trinary is_strict() const override { return Trinary::True; }
+};
+
+}
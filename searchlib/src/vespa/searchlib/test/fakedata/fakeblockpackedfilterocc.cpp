@@ -0,0 +1,84 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fakeblockpackedfilterocc.h"
+#include "fpfactory.h"
+#include "block_packed_posting_iterator.h"
+
+namespace search::fakedata {
+
+static FPFactoryInit
+init(std::make_pair("BlockPackedFilterOcc",
+                    makeFPFactory<FPFactoryT<FakeBlockPackedFilterOcc> >));
+
+FakeBlockPackedFilterOcc::FakeBlockPackedFilterOcc(const FakeWord &fw)
+    : FakePosting(fw.getName() + ".blockpackedfilterocc"),
+      _compressed(),
+      _docIdLimit(fw._docIdLimit),
+      _hitDocs(fw._postings.size())
+{
+    BlockPackedPostingWriter writer;
+    for (const auto &posting : fw._postings) {
+        writer.add(posting._docId);
+    }
+    _compressed = writer.finish();
+}
+
+FakeBlockPackedFilterOcc::~FakeBlockPackedFilterOcc() = default;
+
+void
+FakeBlockPackedFilterOcc::forceLink()
+{
+}
+
+size_t
+FakeBlockPackedFilterOcc::bitSize() const
+{
+    return 32 * _compressed.size() - skipBitSize();
+}
+
+size_t
+FakeBlockPackedFilterOcc::skipBitSize() const
+{
+    BlockPackedPostingView view(_compressed.data());
+    return 32 * view.num_blocks() * BlockPackedPosting::skip_entry_words;
+}
+
+bool
+FakeBlockPackedFilterOcc::hasWordPositions() const
+{
+    return false;
+}
+
+int
+FakeBlockPackedFilterOcc::lowLevelSinglePostingScan() const
+{
+    return 0;
+}
+
+int
+FakeBlockPackedFilterOcc::lowLevelSinglePostingScanUnpack() const
+{
+    return 0;
+}
+
+int
+FakeBlockPackedFilterOcc::lowLevelAndPairPostingScan(const FakePosting &rhs) const
+{
+    (void) rhs;
+    return 0;
+}
+
+int
+FakeBlockPackedFilterOcc::lowLevelAndPairPostingScanUnpack(const FakePosting &rhs) const
+{
+    (void) rhs;
+    return 0;
+}
+
+search::queryeval::SearchIterator *
+FakeBlockPackedFilterOcc::createIterator(const fef::TermFieldMatchDataArray &matchData) const
+{
+    return new BlockPackedPostingIterator(matchData, _compressed.data());
+}
+
+}
@@ -0,0 +1,35 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "fakeword.h"
+#include "fakeposting.h"
+
+namespace search::fakedata {
+
+/*
+ * Block packed docid list, 128 bit packed docid deltas per block
+ * with skip entries per block.
+ */
+class FakeBlockPackedFilterOcc : public FakePosting
+{
+private:
+    std::vector<uint32_t> _compressed;
+    unsigned int _docIdLimit;
+    unsigned int _hitDocs;
+public:
+    FakeBlockPackedFilterOcc(const FakeWord &fw);
+    ~FakeBlockPackedFilterOcc() override;
+
+    static void forceLink();
+
+    size_t bitSize() const override;
+    size_t skipBitSize() const override;
+    bool hasWordPositions() const override;
+    int lowLevelSinglePostingScan() const override;
+    int lowLevelSinglePostingScanUnpack() const override;
+    int lowLevelAndPairPostingScan(const FakePosting &rhs) const override;
+    int lowLevelAndPairPostingScanUnpack(const FakePosting &rhs) const override;
+    queryeval::SearchIterator *createIterator(const fef::TermFieldMatchDataArray &matchData) const override;
+};
+
+}
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "fpfactory.h"
+#include "fakeblockpackedfilterocc.h"
 #include "fakeegcompr64filterocc.h"
 #include "fakefilterocc.h"
 #include "fakezcbfilterocc.h"
@@ -96,6 +97,7 @@ FPFactoryInit::~FPFactoryInit()
 void
 FPFactoryInit::forceLink()
 {
+    FakeBlockPackedFilterOcc::forceLink();
     FakeEGCompr64FilterOcc::forceLink();
     FakeFilterOcc::forceLink();
     FakeZcbFilterOcc::forceLink();
@@ -53,7 +53,13 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
       _maxSessionRunTime(),
       _baseDir(baseDir),
       _fileHeaderContext(fileHeaderContext),
-      _markedDeleted(false)
+      _markedDeleted(false),
+      _unsyncedChunks(),
+      _unsyncedBytes(0),
+      _firstUnsyncedTime(),
+      _queuedCommits(0),
+      _syncStatsMutex(),
+      _syncStats()
 {
     assert(_config.getEncoding().getCompression() != Encoding::Compression::none);
     int retval = makeDirectory(_baseDir.c_str());
@@ -128,6 +134,8 @@ Domain::getDomainInfo() const
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
     }
+    std::lock_guard statsGuard(_syncStatsMutex);
+    info.syncStats = _syncStats;
     return info;
 }
 
@@ -216,7 +224,7 @@ Domain::triggerSyncNow(std::unique_ptr<vespalib::IDestructorCallback> after_sync
     }
     _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() {
         (void) after_sync;
-        getActivePart()->sync();
+        syncAndReleaseCommits(*getActivePart());
     }));
 }
 
@@ -298,7 +306,7 @@ DomainPart::SP
 Domain::optionallyRotateFile(SerialNum serialNum) {
     DomainPart::SP dp = getActivePart();
     if (dp->byteSize() > _config.getPartSizeLimit()) {
-        dp->sync();
+        syncAndReleaseCommits(*dp);
         dp->close();
         dp = std::make_shared<DomainPart>(_name, dir(), serialNum, _fileHeaderContext, false);
         {
@@ -366,11 +374,13 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
     chunk->shrinkPayloadToFit();
     std::promise<SerializedChunk> promise;
     std::future<SerializedChunk> future = promise.get_future();
+    _queuedCommits.fetch_add(1, std::memory_order_relaxed);
     _executor.execute(makeLambdaTask([promise=std::move(promise), chunk = std::move(chunk),
                                       encoding=_config.getEncoding(), compressionLevel=_config.getCompressionlevel()]() mutable {
         promise.set_value(SerializedChunk(std::move(chunk), encoding, compressionLevel));
     }));
     _singleCommitter->execute( makeLambdaTask([this, future = std::move(future)]() mutable {
+        syncIfDeadlineExpiresBefore(future);
         doCommit(future.get());
     }));
 }
@@ -378,17 +388,83 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
 
 
 void
-Domain::doCommit(const SerializedChunk & serialized) {
+Domain::doCommit(SerializedChunk serialized) {
 
     SerialNumRange range = serialized.range();
     DomainPart::SP dp = optionallyRotateFile(range.from());
     dp->commit(serialized);
+    _queuedCommits.fetch_sub(1, std::memory_order_relaxed);
+    LOG(debug, "Committed %zu acks and %zu entries and %zu bytes.",
+        serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
     if (_config.getFSyncOnCommit()) {
-        dp->sync();
+        // Acks are held until the chunk is synced.
+        if (_unsyncedChunks.empty()) {
+            _firstUnsyncedTime = vespalib::steady_clock::now();
+        }
+        _unsyncedBytes += serialized.getData().size();
+        _unsyncedChunks.push_back(std::move(serialized));
+        if (shouldSyncNow()) {
+            syncAndReleaseCommits(*dp);
+        }
+    } else if ( ! _unsyncedChunks.empty()) {
+        // fsync was disabled by reconfig while commits were waiting for it.
+        syncAndReleaseCommits(*dp);
     }
     cleanSessions();
-    LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
-        serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
+}
+
+void
+Domain::syncIfDeadlineExpiresBefore(const std::future<SerializedChunk> & future) {
+    // Commits waiting for an fsync are not held longer than their delay
+    // budget while the next commit is being serialized.
+    if (_unsyncedChunks.empty()) {
+        return;
+    }
+    if (future.wait_until(syncDeadline()) == std::future_status::timeout) {
+        syncAndReleaseCommits(*getActivePart());
+    }
+}
+
+vespalib::steady_time
+Domain::syncDeadline() const {
+    vespalib::duration syncLatency;
+    {
+        std::lock_guard guard(_syncStatsMutex);
+        syncLatency = _syncStats.latency;
+    }
+    return _firstUnsyncedTime + _config.getGroupCommitMaxDelay() - syncLatency;
+}
+
+bool
+Domain::shouldSyncNow() const {
+    vespalib::duration maxDelay = _config.getGroupCommitMaxDelay();
+    if ((maxDelay == vespalib::duration::zero()) || (_queuedCommits.load(std::memory_order_relaxed) == 0)) {
+        return true;
+    }
+    size_t maxBytes = _config.getGroupCommitMaxBytes();
+    if ((maxBytes > 0) && (_unsyncedBytes >= maxBytes)) {
+        return true;
+    }
+    // Group with the next queued commit unless the oldest commit would then miss its latency budget.
+    return vespalib::steady_clock::now() >= syncDeadline();
+}
+
+void
+Domain::syncAndReleaseCommits(DomainPart & dp) {
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    dp.sync();
+    vespalib::duration latency = vespalib::steady_clock::now() - start;
+    {
+        std::lock_guard guard(_syncStatsMutex);
+        _syncStats.syncs++;
+        _syncStats.chunks += _unsyncedChunks.size();
+        _syncStats.bytes += _unsyncedBytes;
+        _syncStats.latency = (_syncStats.syncs == 1) ? latency : (_syncStats.latency * 7 + latency) / 8;
+    }
+    LOG(debug, "Synced %zu chunks and %zu bytes in %1.6f seconds.",
+        _unsyncedChunks.size(), _unsyncedBytes, vespalib::to_s(latency));
+    _unsyncedChunks.clear();
+    _unsyncedBytes = 0;
 }
 
 bool
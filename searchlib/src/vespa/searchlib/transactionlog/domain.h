@@ -6,6 +6,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <future>
 
 namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
@@ -63,7 +64,11 @@ private:
 
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
-    void doCommit(const SerializedChunk & serialized);
+    void doCommit(SerializedChunk serialized);
+    bool shouldSyncNow() const;
+    vespalib::steady_time syncDeadline() const;
+    void syncIfDeadlineExpiresBefore(const std::future<SerializedChunk> & future);
+    void syncAndReleaseCommits(DomainPart & dp);
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -98,6 +103,13 @@ private:
     vespalib::string             _baseDir;
     const FileHeaderContext     &_fileHeaderContext;
     bool                         _markedDeleted;
+    // Commits written but not yet synced, only accessed by the single committer.
+    std::vector<SerializedChunk> _unsyncedChunks;
+    size_t                       _unsyncedBytes;
+    vespalib::steady_time        _firstUnsyncedTime;
+    std::atomic<size_t>          _queuedCommits;
+    mutable std::mutex           _syncStatsMutex;
+    SyncStats                    _syncStats;
 };
 
 }
@@ -16,17 +16,28 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupCommitMaxDelay(duration v) { _groupCommitMaxDelay = v; return *this; }
+    DomainConfig & setGroupCommitMaxBytes(size_t v) { _groupCommitMaxBytes = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    /**
+     * Max time a commit waits for fsync when several commits are grouped in one fsync.
+     * Zero gives one fsync per commit.
+     */
+    duration getGroupCommitMaxDelay() const { return _groupCommitMaxDelay; }
+    /// Max bytes written by the commits grouped in one fsync. Zero means no limit.
+    size_t   getGroupCommitMaxBytes() const { return _groupCommitMaxBytes; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
+    duration     _groupCommitMaxDelay;
+    size_t       _groupCommitMaxBytes;
 };
 
 struct PartInfo {
@@ -42,17 +53,29 @@ struct PartInfo {
     {}
 };
 
+/**
+ * Accumulated counts of fsyncs done after commits, and the chunks and bytes they made durable.
+ */
+struct SyncStats {
+    uint64_t syncs;
+    uint64_t chunks;
+    uint64_t bytes;
+    vespalib::duration latency; // Recent average latency of one fsync
+    SyncStats() : syncs(0), chunks(0), bytes(0), latency() {}
+};
+
 struct DomainInfo {
     using DurationSeconds = std::chrono::duration<double>;
     SerialNumRange range;
     size_t numEntries;
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
+    SyncStats syncStats;
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), syncStats(), parts() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), syncStats(), parts() {}
 };
 
 using DomainStats = std::map<vespalib::string, DomainInfo>;
@@ -3,9 +3,11 @@
 #include "domainpart.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/exceptions.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <cassert>
+#include <filesystem>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".transactionlog.domainpart");
@@ -26,6 +28,8 @@ namespace search::transactionlog {
 namespace {
 
 constexpr size_t TARGET_PACKET_SIZE = 0x3f000;
+constexpr uint32_t SKIP_INDEX_MAGIC = 0x534b4950; // "SKIP"
+constexpr uint32_t SKIP_INDEX_VERSION = 1;
 
 string
 handleWriteError(const char *text, FastOS_FileInterface &file, int64_t lastKnownGoodPos,
@@ -248,6 +252,90 @@ DomainPart::buildPacketMapping(bool allowTruncate)
     return currPos;
 }
 
+bool
+DomainPart::readSkipIndex(int64_t fileSize)
+{
+    FastOS_File indexFile(skipIndexFileName(_fileName).c_str());
+    if ( ! indexFile.OpenReadOnly()) {
+        return false;
+    }
+    int64_t indexSize = indexFile.GetSize();
+    if (indexSize < int64_t(sizeof(int32_t))) {
+        return false;
+    }
+    std::vector<char> buf(indexSize);
+    indexFile.ReadBuf(buf.data(), buf.size(), 0);
+    nbostream is(buf.data(), buf.size() - sizeof(int32_t));
+    nbostream crcStream(buf.data() + is.size(), sizeof(int32_t));
+    int32_t crc(0);
+    crcStream >> crc;
+    if (crc != Encoding::calcCrc(Encoding::Crc::xxh64, is.data(), is.size())) {
+        LOG(warning, "Ignoring skip index '%s' with bad checksum", indexFile.GetFileName());
+        return false;
+    }
+    try {
+        uint32_t magic(0), version(0), headerLen(0);
+        int64_t indexedFileSize(0);
+        SerialNum from(0), to(0);
+        uint64_t numEntries(0), numSkips(0);
+        is >> magic >> version >> headerLen >> indexedFileSize >> from >> to >> numEntries >> numSkips;
+        if ((magic != SKIP_INDEX_MAGIC) || (version != SKIP_INDEX_VERSION) || (indexedFileSize != fileSize) ||
+            (numSkips * 2 * sizeof(uint64_t) != is.size()))
+        {
+            return false;
+        }
+        std::vector<SkipInfo> skipList;
+        skipList.reserve(numSkips);
+        for (uint64_t i = 0; i < numSkips; ++i) {
+            SerialNum id(0);
+            uint64_t pos(0);
+            is >> id >> pos;
+            skipList.emplace_back(id, pos);
+        }
+        _headerLen = headerLen;
+        set_range_from(from);
+        set_range_to(to);
+        set_size(numEntries);
+        // Called only from constructor so no need to hold lock
+        _skipList = std::move(skipList);
+    } catch (const vespalib::IllegalStateException &) {
+        return false;
+    }
+    return true;
+}
+
+void
+DomainPart::writeSkipIndex(int64_t fileSize)
+{
+    nbostream os;
+    {
+        std::lock_guard guard(_lock);
+        os << SKIP_INDEX_MAGIC << SKIP_INDEX_VERSION << _headerLen << fileSize
+           << get_range_from() << get_range_to() << uint64_t(size()) << uint64_t(_skipList.size());
+        for (const auto & skipInfo : _skipList) {
+            os << skipInfo.id() << uint64_t(skipInfo.filePos());
+        }
+    }
+    os << Encoding::calcCrc(Encoding::Crc::xxh64, os.data(), os.size());
+    string indexName = skipIndexFileName(_fileName);
+    string tmpName = indexName + ".tmp";
+    FastOS_File indexFile(tmpName.c_str());
+    if ( ! indexFile.OpenWriteOnlyTruncate() || ! indexFile.CheckedWrite(os.data(), os.size()) ||
+         ! indexFile.Sync() || ! indexFile.Close())
+    {
+        // The skip index is only an optimization, the part file is scanned when it is missing.
+        LOG(warning, "Failed writing skip index '%s': %s", tmpName.c_str(), getLastErrorString().c_str());
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(std::filesystem::path(tmpName), std::filesystem::path(indexName), ec);
+    if (ec) {
+        LOG(warning, "Failed renaming skip index '%s': %s", tmpName.c_str(), ec.message().c_str());
+        return;
+    }
+    _hasSkipIndex = true;
+}
+
 DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
                        const FileHeaderContext &fileHeaderContext, bool allowTruncate)
     : _lock(),
@@ -260,12 +348,15 @@ DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
       _transLog(std::make_unique<FastOS_File>(_fileName.c_str())),
       _skipList(),
       _headerLen(0),
+      _hasSkipIndex(false),
       _writeLock(),
       _writtenSerial(0),
       _syncedSerial(0)
 {
     if (_transLog->OpenReadOnly()) {
-        int64_t currPos = buildPacketMapping(allowTruncate);
+        // Only closed parts have a valid skip index, the last part might have been appended to since.
+        _hasSkipIndex = ! allowTruncate && readSkipIndex(_transLog->GetSize());
+        int64_t currPos = _hasSkipIndex ? _transLog->GetSize() : buildPacketMapping(allowTruncate);
         if ( ! _transLog->Close() ) {
             throw runtime_error(fmt("Failed closing file '%s' after reading.", _transLog->GetFileName()));
         }
@@ -322,6 +413,16 @@ DomainPart::writeHeader(const FileHeaderContext &fileHeaderContext)
 
 bool
 DomainPart::close()
+{
+    bool retval = closeFile();
+    if ( ! _hasSkipIndex && (size() > 0)) {
+        writeSkipIndex(byteSize());
+    }
+    return retval;
+}
+
+bool
+DomainPart::closeFile()
 {
     bool retval(false);
     {
@@ -370,8 +471,11 @@ DomainPart::erase(SerialNum to)
 {
     bool retval(true);
     if (to > get_range_to()) {
-        close();
+        // no skip index is written for a part that is about to be deleted
+        closeFile();
         _transLog->Delete();
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::path(skipIndexFileName(_fileName)), ec);
     } else {
         auto range_from = get_range_from();
         if (to > range_from) {
@@ -42,10 +42,15 @@ public:
         return _byteSize.load(std::memory_order_acquire);
     }
     bool        isClosed() const;
+    /// Name of the file persisting the skip list of a closed part, so it can be opened without reading it all.
+    static vespalib::string skipIndexFileName(const vespalib::string &fileName) { return fileName + ".skip"; }
 private:
     using Alloc = vespalib::alloc::Alloc;
+    bool closeFile();
     bool openAndFind(FastOS_FileInterface &file, const SerialNum &from);
     int64_t buildPacketMapping(bool allowTruncate);
+    bool readSkipIndex(int64_t fileSize);
+    void writeSkipIndex(int64_t fileSize);
     static Packet readPacket(FastOS_FileInterface & file, SerialNumRange wanted, size_t targetSize, bool allowTruncate);
     static bool read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc &buf, bool allowTruncate);
 
@@ -84,6 +89,7 @@ private:
     std::unique_ptr<FastOS_FileInterface> _transLog;
     std::vector<SkipInfo> _skipList;
     uint32_t              _headerLen;
+    bool                  _hasSkipIndex;
     mutable std::mutex    _writeLock;
     // Protected by _writeLock
     SerialNum             _writtenSerial;
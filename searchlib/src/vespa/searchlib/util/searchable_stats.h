@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/searchlib/memoryindex/field_latency_stats.h>
 #include <vespa/vespalib/util/memoryusage.h>
 
 namespace search {
@@ -17,9 +18,10 @@ private:
     size_t _docsInMemory;
     size_t _sizeOnDisk; // in bytes
     size_t _fusion_size_on_disk; // in bytes
+    memoryindex::FieldLatencyStats _memory_index_latency;
 
 public:
-    SearchableStats() : _memoryUsage(), _docsInMemory(0), _sizeOnDisk(0), _fusion_size_on_disk(0) {}
+    SearchableStats() : _memoryUsage(), _docsInMemory(0), _sizeOnDisk(0), _fusion_size_on_disk(0), _memory_index_latency() {}
     SearchableStats &memoryUsage(const vespalib::MemoryUsage &usage) {
         _memoryUsage = usage;
         return *this;
@@ -40,12 +42,18 @@ public:
         return *this;
     }
     size_t fusion_size_on_disk() const { return _fusion_size_on_disk; }
+    SearchableStats& memory_index_latency(const memoryindex::FieldLatencyStats& value) {
+        _memory_index_latency = value;
+        return *this;
+    }
+    const memoryindex::FieldLatencyStats& memory_index_latency() const { return _memory_index_latency; }
 
     SearchableStats &merge(const SearchableStats &rhs) {
         _memoryUsage.merge(rhs._memoryUsage);
         _docsInMemory += rhs._docsInMemory;
         _sizeOnDisk += rhs._sizeOnDisk;
         _fusion_size_on_disk += rhs._fusion_size_on_disk;
+        _memory_index_latency.merge(rhs._memory_index_latency);
         return *this;
     }
 };
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -67,6 +69,52 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+vespalib::string
+make_sample(uint32_t i) {
+    return make_string(R"({"title":"document number %u","category":"cat-%u","price":%u,"in_stock":%s})",
+                       i, i % 7, (i * 37) % 1000, (i % 2) ? "true" : "false");
+}
+
+TEST("require that zstd dictionary compresses small buffers better than plain zstd") {
+    std::vector<vespalib::string> samples;
+    std::vector<ConstBufferRef> refs;
+    for (uint32_t i = 0; i < 1000; i++) {
+        samples.push_back(make_sample(i));
+    }
+    for (const auto & sample : samples) {
+        refs.emplace_back(sample.data(), sample.size());
+    }
+    auto dictionary = ZStdDictionary::train(refs, 4096, 3);
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->id());
+    EXPECT_LESS_EQUAL(dictionary->content().size(), 4096u);
+
+    vespalib::string text = make_sample(5000);
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD);
+    DataBuffer plain;
+    DataBuffer withDictionary;
+    EXPECT_EQUAL(CompressionConfig::NONE, compress(cfg, ConstBufferRef(text.data(), text.size()), plain, false));
+    EXPECT_EQUAL(CompressionConfig::ZSTD, compress(*dictionary, cfg, ConstBufferRef(text.data(), text.size()), withDictionary));
+    EXPECT_LESS(withDictionary.getDataLen(), text.size() / 2);
+    EXPECT_EQUAL(dictionary->id(), ZStdDictionary::getDictionaryId(withDictionary.getData(), withDictionary.getDataLen()));
+
+    DataBuffer decompressed;
+    decompress(*dictionary, text.size(), ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()), decompressed, false);
+    EXPECT_EQUAL(text, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+
+    ZStdDictionary reloaded(dictionary->content(), 3);
+    EXPECT_EQUAL(dictionary->id(), reloaded.id());
+    DataBuffer decompressed2;
+    decompress(reloaded, text.size(), ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()), decompressed2, false);
+    EXPECT_EQUAL(text, vespalib::string(decompressed2.getData(), decompressed2.getDataLen()));
+}
+
+TEST("require that zstd dictionary training fails gracefully without enough samples") {
+    vespalib::string text = make_sample(1);
+    std::vector<ConstBufferRef> refs = {ConstBufferRef(text.data(), text.size())};
+    EXPECT_FALSE(ZStdDictionary::train(refs, 4096, 3));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
@@ -3,6 +3,12 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#ifdef __x86_64__
+#include <vespa/vespalib/hwaccelrated/avx2.h>
+#include <vespa/vespalib/hwaccelrated/avx512.h>
+#include <vespa/vespalib/hwaccelrated/avx512vnni.h>
+#endif
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/log/log.h>
 LOG_SETUP("hwaccelrated_test");
 
@@ -47,4 +53,131 @@ TEST("test euclidean distance") {
     TEST_DO(verifyEuclideanDistance(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
 }
 
+template<typename T>
+void verifyOneToMany(const hwaccelrated::IAccelrated & accel, size_t testLength, double approxFactor) {
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<std::vector<T>> others;
+    std::vector<const T *> b;
+    for (size_t i(0); i < 5; i++) {
+        others.push_back(createAndFill<T>(testLength));
+    }
+    for (const auto & v : others) {
+        b.push_back(v.data());
+    }
+    std::vector<double> dot(b.size());
+    std::vector<double> dist(b.size());
+    accel.dotProduct(a.data(), b.data(), b.size(), testLength, dot.data());
+    accel.squaredEuclideanDistance(a.data(), b.data(), b.size(), testLength, dist.data());
+    for (size_t i(0); i < b.size(); i++) {
+        double expDot = accel.dotProduct(a.data(), b[i], testLength);
+        double expDist = accel.squaredEuclideanDistance(a.data(), b[i], testLength);
+        EXPECT_APPROX(expDot, dot[i], expDot*approxFactor);
+        EXPECT_APPROX(expDist, dist[i], expDist*approxFactor);
+    }
+}
+
+void
+verifyBFloat16(const hwaccelrated::IAccelrated & accelrator, size_t testLength) {
+    srand(1);
+    std::vector<float> af = createAndFill<float>(testLength);
+    std::vector<float> bf = createAndFill<float>(testLength);
+    std::vector<BFloat16> a(af.begin(), af.end());
+    std::vector<BFloat16> b(bf.begin(), bf.end());
+    double dot(0);
+    double dist(0);
+    for (size_t i(0); i < testLength; i++) {
+        dot += double(a[i]) * double(b[i]);
+        double d = double(a[i]) - double(b[i]);
+        dist += d * d;
+    }
+    EXPECT_APPROX(dot, accelrator.dotProduct(a.data(), b.data(), testLength), dot*0.0001);
+    EXPECT_APPROX(dist, accelrator.squaredEuclideanDistance(a.data(), b.data(), testLength), dist*0.0001);
+}
+
+void
+verifyInt8DotProduct(const hwaccelrated::IAccelrated & accelrator, size_t testLength) {
+    srand(1);
+    std::vector<int8_t> a = createAndFill<int8_t>(testLength);
+    std::vector<int8_t> b = createAndFill<int8_t>(testLength);
+    int64_t sum(0);
+    for (size_t i(0); i < testLength; i++) {
+        sum += int64_t(a[i]) * int64_t(b[i]);
+    }
+    EXPECT_EQUAL(sum, accelrator.dotProduct(a.data(), b.data(), testLength));
+}
+
+void
+verifyBinaryHammingDistance(const hwaccelrated::IAccelrated & accelrator, size_t testLength) {
+    srand(1);
+    std::vector<uint8_t> a = createAndFill<uint8_t>(testLength);
+    std::vector<uint8_t> b = createAndFill<uint8_t>(testLength);
+    for (size_t j(0); j < 0x10; j++) {
+        size_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += __builtin_popcount(a[i] ^ b[i]);
+        }
+        EXPECT_EQUAL(sum, accelrator.binaryHammingDistance(&a[j], &b[j], testLength - j));
+        const void * others[2] = { &b[j], &a[j] };
+        double result[2];
+        accelrator.binaryHammingDistance(&a[j], others, 2, testLength - j, result);
+        EXPECT_EQUAL(double(sum), result[0]);
+        EXPECT_EQUAL(0.0, result[1]);
+    }
+}
+
+TEST("test bfloat16 dot product and euclidean distance") {
+    TEST_DO(verifyBFloat16(hwaccelrated::GenericAccelrator(), 1001));
+    TEST_DO(verifyBFloat16(hwaccelrated::IAccelrated::getAccelerator(), 1001));
+}
+
+TEST("test int8 dot product") {
+    constexpr size_t TEST_LENGTH = 140000; // must be longer than 64k
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
+TEST("test binary hamming distance") {
+    TEST_DO(verifyBinaryHammingDistance(hwaccelrated::GenericAccelrator(), 1003));
+    TEST_DO(verifyBinaryHammingDistance(hwaccelrated::IAccelrated::getAccelerator(), 1003));
+}
+
+void
+verifyOneToMany(const hwaccelrated::IAccelrated & accelrator) {
+    TEST_DO(verifyOneToMany<float>(accelrator, 1001, 0.0));
+    TEST_DO(verifyOneToMany<double>(accelrator, 1001, 0.0));
+    TEST_DO(verifyOneToMany<int8_t>(accelrator, 1001, 0.0));
+    TEST_DO(verifyOneToMany<BFloat16>(accelrator, 1001, 0.0));
+}
+
+TEST("test one to many gives same result as pairwise") {
+    TEST_DO(verifyOneToMany(hwaccelrated::GenericAccelrator()));
+    TEST_DO(verifyOneToMany(hwaccelrated::IAccelrated::getAccelerator()));
+}
+
+void
+verifyAll(const hwaccelrated::IAccelrated & accelrator) {
+    constexpr size_t TEST_LENGTH = 140000; // must be longer than 64k
+    TEST_DO(verifyEuclideanDistance(accelrator, TEST_LENGTH));
+    TEST_DO(verifyBFloat16(accelrator, 1001));
+    TEST_DO(verifyInt8DotProduct(accelrator, TEST_LENGTH));
+    TEST_DO(verifyBinaryHammingDistance(accelrator, 1003));
+    TEST_DO(verifyOneToMany(accelrator));
+}
+
+TEST("test all accelerators supported by this cpu") {
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        TEST_DO(verifyAll(hwaccelrated::Avx2Accelrator()));
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        TEST_DO(verifyAll(hwaccelrated::Avx512Accelrator()));
+    }
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vnni")) {
+        TEST_DO(verifyAll(hwaccelrated::Avx512VnniAccelrator()));
+    }
+#endif
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -12,7 +12,7 @@ Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const {
 
 double
 Avx2Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
-    return helper::squaredEuclideanDistance(a, b, sz);
+    return avx::squaredEuclideanDistanceInt8<32>(a, b, sz);
 }
 
 double
@@ -25,6 +25,51 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+int64_t
+Avx2Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::dotProductInt8<32>(a, b, sz);
+}
+
+float
+Avx2Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return avx::dotProductBFloat16<32>(a, b, sz);
+}
+
+double
+Avx2Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return avx::squaredEuclideanDistanceBFloat16<32>(a, b, sz);
+}
+
+void
+Avx2Accelrator::dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::dotProductInt8<32>, a, b, count, sz, result);
+}
+
+void
+Avx2Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::dotProductBFloat16<32>, a, b, count, sz, result);
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const float * a, const float * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::euclideanDistanceSelectAlignment<float, 32>, a, b, count, sz, result);
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::euclideanDistanceSelectAlignment<double, 32>, a, b, count, sz, result);
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::squaredEuclideanDistanceInt8<32>, a, b, count, sz, result);
+}
+
+void
+Avx2Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::squaredEuclideanDistanceBFloat16<32>, a, b, count, sz, result);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
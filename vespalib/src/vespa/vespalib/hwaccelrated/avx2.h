@@ -12,10 +12,19 @@ namespace vespalib::hwaccelrated {
 class Avx2Accelrator : public GenericAccelrator
 {
 public:
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+    float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
     size_t populationCount(const uint64_t *a, size_t sz) const override;
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
+    void dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const override;
+    void dotProduct(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const float * a, const float * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const double * a, const double * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
 };
@@ -24,7 +24,7 @@ Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const {
 
 double
 Avx512Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
-    return helper::squaredEuclideanDistance(a, b, sz);
+    return avx::squaredEuclideanDistanceInt8<64>(a, b, sz);
 }
 
 double
@@ -37,6 +37,61 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+int64_t
+Avx512Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::dotProductInt8<64>(a, b, sz);
+}
+
+float
+Avx512Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return avx::dotProductBFloat16<64>(a, b, sz);
+}
+
+double
+Avx512Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return avx::squaredEuclideanDistanceBFloat16<64>(a, b, sz);
+}
+
+void
+Avx512Accelrator::dotProduct(const float * a, const float * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::dotProductSelectAlignment<float, 64>, a, b, count, sz, result);
+}
+
+void
+Avx512Accelrator::dotProduct(const double * a, const double * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::dotProductSelectAlignment<double, 64>, a, b, count, sz, result);
+}
+
+void
+Avx512Accelrator::dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::dotProductInt8<64>, a, b, count, sz, result);
+}
+
+void
+Avx512Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::dotProductBFloat16<64>, a, b, count, sz, result);
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const float * a, const float * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::euclideanDistanceSelectAlignment<float, 64>, a, b, count, sz, result);
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::euclideanDistanceSelectAlignment<double, 64>, a, b, count, sz, result);
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::squaredEuclideanDistanceInt8<64>, a, b, count, sz, result);
+}
+
+void
+Avx512Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(avx::squaredEuclideanDistanceBFloat16<64>, a, b, count, sz, result);
+}
+
 void
 Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<64, 1>(offset, src, dest);
@@ -0,0 +1,105 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "avx512vnni.h"
+#include "private_helpers.hpp"
+#include <immintrin.h>
+
+namespace vespalib::hwaccelrated {
+
+namespace {
+
+// Int8 values are sign extended to int16 and multiplied pairwise into
+// int32 lanes with vpdpwssd. Blocks are small enough that the lanes
+// cannot overflow, but the sum of all lanes may, so lanes are added
+// together as int64.
+template <bool Euclidean>
+int64_t
+int8Block(const int8_t * a, const int8_t * b, size_t sz) __attribute__((noinline));
+
+template <bool Euclidean>
+int64_t
+int8Block(const int8_t * a, const int8_t * b, size_t sz)
+{
+    constexpr size_t ChunkSize = 64;
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        const int8_t * ap = a + ChunkSize*i;
+        const int8_t * bp = b + ChunkSize*i;
+        __m512i a0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ap)));
+        __m512i a1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ap + 32)));
+        __m512i b0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp)));
+        __m512i b1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp + 32)));
+        if constexpr (Euclidean) {
+            __m512i d0 = _mm512_sub_epi16(a0, b0);
+            __m512i d1 = _mm512_sub_epi16(a1, b1);
+            acc0 = _mm512_dpwssd_epi32(acc0, d0, d0);
+            acc1 = _mm512_dpwssd_epi32(acc1, d1, d1);
+        } else {
+            acc0 = _mm512_dpwssd_epi32(acc0, a0, b0);
+            acc1 = _mm512_dpwssd_epi32(acc1, a1, b1);
+        }
+    }
+    int64_t sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        int32_t x = a[i];
+        int32_t y = b[i];
+        sum += Euclidean ? (x - y) * (x - y) : x * y;
+    }
+    alignas(64) int32_t lanes[32];
+    _mm512_store_si512(lanes, acc0);
+    _mm512_store_si512(lanes + 16, acc1);
+    for (int32_t lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+template <bool Euclidean>
+int64_t
+int8T(const int8_t * a, const int8_t * b, size_t sz)
+{
+    constexpr size_t LOOP_COUNT = 0x10000;
+    int64_t sum(0);
+    size_t i=0;
+    for (; i + LOOP_COUNT <= sz; i += LOOP_COUNT) {
+        sum += int8Block<Euclidean>(a + i, b + i, LOOP_COUNT);
+    }
+    sum += int8Block<Euclidean>(a + i, b + i, sz - i);
+    return sum;
+}
+
+int64_t
+dotProductInt8(const int8_t * a, const int8_t * b, size_t sz) {
+    return int8T<false>(a, b, sz);
+}
+
+double
+squaredEuclideanDistanceInt8(const int8_t * a, const int8_t * b, size_t sz) {
+    return int8T<true>(a, b, sz);
+}
+
+}
+
+int64_t
+Avx512VnniAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const {
+    return dotProductInt8(a, b, sz);
+}
+
+double
+Avx512VnniAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return squaredEuclideanDistanceInt8(a, b, sz);
+}
+
+void
+Avx512VnniAccelrator::dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(dotProductInt8, a, b, count, sz, result);
+}
+
+void
+Avx512VnniAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(squaredEuclideanDistanceInt8, a, b, count, sz, result);
+}
+
+}
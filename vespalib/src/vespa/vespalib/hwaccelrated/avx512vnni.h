@@ -0,0 +1,22 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "avx512.h"
+
+namespace vespalib::hwaccelrated {
+
+/**
+ * Avx-512 implementation using the vector neural network instructions
+ * for int8 dot products and euclidean distances.
+ */
+class Avx512VnniAccelrator : public Avx512Accelrator
+{
+public:
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+    double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
+    void dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const override;
+};
+
+}
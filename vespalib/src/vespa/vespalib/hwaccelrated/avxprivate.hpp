@@ -134,4 +134,160 @@ double euclideanDistanceSelectAlignment(const T * af, const T * bf, size_t sz)
     }
 }
 
+// Vector types used by the bfloat16 and int8 kernels, one
+// specialization per vector length.
+template <unsigned VLEN> struct VectorTypes;
+
+template <> struct VectorTypes<32> {
+    typedef float F __attribute__ ((vector_size (32)));
+    typedef uint32_t U __attribute__ ((vector_size (32)));
+    typedef int32_t I __attribute__ ((vector_size (32)));
+};
+
+template <> struct VectorTypes<64> {
+    typedef float F __attribute__ ((vector_size (64)));
+    typedef uint32_t U __attribute__ ((vector_size (64)));
+    typedef int32_t I __attribute__ ((vector_size (64)));
+};
+
+// A bfloat16 value is the upper half of a float. A vector of uint32
+// covering 2*N bfloat16 values is split into N floats from the lower
+// halves and N floats from the upper halves. The order of the values
+// does not matter for dot products and distances.
+template <unsigned VLEN>
+float
+dotProductBFloat16(const BFloat16 * a, const BFloat16 * b, size_t sz)
+{
+    constexpr unsigned VectorsPerChunk = 2;
+    constexpr size_t N = VLEN/sizeof(BFloat16);
+    constexpr size_t ChunkSize = N*VectorsPerChunk;
+    using U = typename VectorTypes<VLEN>::U;
+    using F = typename VectorTypes<VLEN>::F;
+    F partial[2*VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            U x, y;
+            memcpy(&x, a + ChunkSize*i + N*j, sizeof(x));
+            memcpy(&y, b + ChunkSize*i + N*j, sizeof(y));
+            partial[2*j] += (F)(x << 16) * (F)(y << 16);
+            partial[2*j+1] += (F)(x & 0xffff0000u) * (F)(y & 0xffff0000u);
+        }
+    }
+    float sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        sum += a[i].to_float() * b[i].to_float();
+    }
+    partial[0] = sumR<F, 2*VectorsPerChunk>(partial);
+    return sum + sumT<float, F>(partial[0]);
+}
+
+template <unsigned VLEN>
+double
+squaredEuclideanDistanceBFloat16(const BFloat16 * a, const BFloat16 * b, size_t sz)
+{
+    constexpr unsigned VectorsPerChunk = 2;
+    constexpr size_t N = VLEN/sizeof(BFloat16);
+    constexpr size_t ChunkSize = N*VectorsPerChunk;
+    using U = typename VectorTypes<VLEN>::U;
+    using F = typename VectorTypes<VLEN>::F;
+    F partial[2*VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            U x, y;
+            memcpy(&x, a + ChunkSize*i + N*j, sizeof(x));
+            memcpy(&y, b + ChunkSize*i + N*j, sizeof(y));
+            F lo = (F)(x << 16) - (F)(y << 16);
+            F hi = (F)(x & 0xffff0000u) - (F)(y & 0xffff0000u);
+            partial[2*j] += lo * lo;
+            partial[2*j+1] += hi * hi;
+        }
+    }
+    double sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        float d = a[i].to_float() - b[i].to_float();
+        sum += d * d;
+    }
+    partial[0] = sumR<F, 2*VectorsPerChunk>(partial);
+    return sum + sumT<float, F>(partial[0]);
+}
+
+// A vector of int32 covering 4*N int8 values is split into 4 vectors of
+// N sign extended values using shifts, which are then multiplied into
+// int32 lanes. Blocks are small enough that the lanes cannot overflow,
+// but the sum of all lanes may, so lanes are added together as int64.
+template <unsigned VLEN, bool Euclidean>
+int64_t
+int8BlockT(const int8_t * a, const int8_t * b, size_t sz) __attribute__((noinline));
+
+template <unsigned VLEN, bool Euclidean>
+int64_t
+int8BlockT(const int8_t * a, const int8_t * b, size_t sz)
+{
+    constexpr size_t N = VLEN/sizeof(int32_t);
+    constexpr size_t ChunkSize = VLEN;
+    using I = typename VectorTypes<VLEN>::I;
+    I partial[4];
+    memset(partial, 0, sizeof(partial));
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        I x, y;
+        memcpy(&x, a + ChunkSize*i, sizeof(x));
+        memcpy(&y, b + ChunkSize*i, sizeof(y));
+        for (size_t j(0); j < 4; j++) {
+            I xj = (x << (24 - 8*j)) >> 24;
+            I yj = (y << (24 - 8*j)) >> 24;
+            if constexpr (Euclidean) {
+                I d = xj - yj;
+                partial[j] += d * d;
+            } else {
+                partial[j] += xj * yj;
+            }
+        }
+    }
+    int64_t sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        int32_t x = a[i];
+        int32_t y = b[i];
+        sum += Euclidean ? (x - y) * (x - y) : x * y;
+    }
+    for (size_t j(0); j < 4; j++) {
+        for (size_t i(0); i < N; i++) {
+            sum += partial[j][i];
+        }
+    }
+    return sum;
+}
+
+template <unsigned VLEN, bool Euclidean>
+int64_t
+int8T(const int8_t * a, const int8_t * b, size_t sz)
+{
+    constexpr size_t LOOP_COUNT = 0x10000;
+    int64_t sum(0);
+    size_t i=0;
+    for (; i + LOOP_COUNT <= sz; i += LOOP_COUNT) {
+        sum += int8BlockT<VLEN, Euclidean>(a + i, b + i, LOOP_COUNT);
+    }
+    sum += int8BlockT<VLEN, Euclidean>(a + i, b + i, sz - i);
+    return sum;
+}
+
+template <unsigned VLEN>
+int64_t
+dotProductInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    return int8T<VLEN, false>(a, b, sz);
+}
+
+template <unsigned VLEN>
+double
+squaredEuclideanDistanceInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    return int8T<VLEN, true>(a, b, sz);
+}
+
 }
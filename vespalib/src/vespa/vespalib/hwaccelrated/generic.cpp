@@ -2,6 +2,7 @@
 
 #include "generic.h"
 #include "private_helpers.hpp"
+#include <vespa/vespalib/util/binary_hamming_distance.h>
 #include <cblas.h>
 
 namespace vespalib::hwaccelrated {
@@ -121,6 +122,12 @@ GenericAccelrator::dotProduct(const int64_t * a, const int64_t * b, size_t sz) c
     return multiplyAdd<long long, int64_t, 8>(a, b, sz);
 }
 
+float
+GenericAccelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const
+{
+    return helper::dotProduct(a, b, sz);
+}
+
 void
 GenericAccelrator::orBit(void * aOrg, const void * bOrg, size_t bytes) const
 {
@@ -172,6 +179,66 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return squaredEuclideanDistanceT<double, 2>(a, b, sz);
 }
 
+double
+GenericAccelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return helper::squaredEuclideanDistance(a, b, sz);
+}
+
+size_t
+GenericAccelrator::binaryHammingDistance(const void * a, const void * b, size_t bytes) const {
+    return binary_hamming_distance(a, b, bytes);
+}
+
+void
+GenericAccelrator::dotProduct(const float * a, const float * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany([](const float * x, const float * y, size_t n) { return cblas_sdot(n, x, 1, y, 1); },
+                      a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::dotProduct(const double * a, const double * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany([](const double * x, const double * y, size_t n) { return cblas_ddot(n, x, 1, y, 1); },
+                      a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(multiplyAdd<int64_t, int8_t, 8>, a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::dotProduct(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany([](const BFloat16 * x, const BFloat16 * y, size_t n) { return helper::dotProduct(x, y, n); },
+                      a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const float * a, const float * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(squaredEuclideanDistanceT<float, 2>, a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const double * a, const double * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany(squaredEuclideanDistanceT<double, 2>, a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany([](const int8_t * x, const int8_t * y, size_t n) { return helper::squaredEuclideanDistance(x, y, n); },
+                      a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const {
+    helper::oneToMany([](const BFloat16 * x, const BFloat16 * y, size_t n) { return helper::squaredEuclideanDistance(x, y, n); },
+                      a, b, count, sz, result);
+}
+
+void
+GenericAccelrator::binaryHammingDistance(const void * a, const void * const * b, size_t count, size_t bytes, double * result) const {
+    helper::oneToMany(binary_hamming_distance, a, b, count, bytes, result);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
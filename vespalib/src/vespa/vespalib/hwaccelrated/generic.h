@@ -18,6 +18,7 @@ public:
     int64_t dotProduct(const int16_t * a, const int16_t * b, size_t sz) const override;
     int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const override;
     long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const override;
+    float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
     void orBit(void * a, const void * b, size_t bytes) const override;
     void andBit(void * a, const void * b, size_t bytes) const override;
     void andNotBit(void * a, const void * b, size_t bytes) const override;
@@ -26,6 +27,17 @@ public:
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
+    size_t binaryHammingDistance(const void * a, const void * b, size_t bytes) const override;
+    void dotProduct(const float * a, const float * const * b, size_t count, size_t sz, double * result) const override;
+    void dotProduct(const double * a, const double * const * b, size_t count, size_t sz, double * result) const override;
+    void dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const override;
+    void dotProduct(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const float * a, const float * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const double * a, const double * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const override;
+    void squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const override;
+    void binaryHammingDistance(const void * a, const void * const * b, size_t count, size_t bytes, double * result) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
 };
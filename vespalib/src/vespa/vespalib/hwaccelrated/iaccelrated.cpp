@@ -5,6 +5,7 @@
 #ifdef __x86_64__
 #include "avx2.h"
 #include "avx512.h"
+#include "avx512vnni.h"
 #endif
 #include <vespa/vespalib/util/memory.h>
 #include <cstdio>
@@ -21,6 +22,9 @@ IAccelrated::UP create_accelerator() {
 #ifdef __x86_64__
     __builtin_cpu_init();
     if (__builtin_cpu_supports("avx512f")) {
+        if (__builtin_cpu_supports("avx512vnni")) {
+            return std::make_unique<Avx512VnniAccelrator>();
+        }
         return std::make_unique<Avx512Accelrator>();
     }
     if (__builtin_cpu_supports("avx2")) {
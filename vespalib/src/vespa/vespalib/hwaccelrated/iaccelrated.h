@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <vector>
 
+namespace vespalib { class BFloat16; }
+
 namespace vespalib::hwaccelrated {
 
 /**
@@ -23,6 +25,7 @@ public:
     virtual int64_t dotProduct(const int16_t * a, const int16_t * b, size_t sz) const = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const = 0;
     virtual long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const = 0;
+    virtual float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const = 0;
     virtual void orBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
@@ -31,6 +34,20 @@ public:
     virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    virtual double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const = 0;
+    // Number of differing bits in two binary vectors of the given number of bytes
+    virtual size_t binaryHammingDistance(const void * a, const void * b, size_t bytes) const = 0;
+    // One-to-many versions, comparing vector a with each of the count vectors in b.
+    // All vectors have sz cells, and result must have room for count values.
+    virtual void dotProduct(const float * a, const float * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void dotProduct(const double * a, const double * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void dotProduct(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void dotProduct(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void squaredEuclideanDistance(const float * a, const float * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void squaredEuclideanDistance(const double * a, const double * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void squaredEuclideanDistance(const int8_t * a, const int8_t * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * const * b, size_t count, size_t sz, double * result) const = 0;
+    virtual void binaryHammingDistance(const void * a, const void * const * b, size_t count, size_t bytes, double * result) const = 0;
     // AND 64 bytes from multiple, optionally inverted sources
     virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
     // OR 64 bytes from multiple, optionally inverted sources
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/optimized.h>
 #include <cstring>
 
@@ -102,5 +103,85 @@ squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) {
     return sum;
 }
 
+template<typename TemporaryT=int32_t>
+int64_t dotProductT(const int8_t * a, const int8_t * b, size_t sz) __attribute__((noinline));
+template<typename TemporaryT>
+int64_t dotProductT(const int8_t * a, const int8_t * b, size_t sz)
+{
+    TemporaryT sum = 0;
+    for (size_t i(0); i < sz; i++) {
+        sum += int16_t(a[i]) * int16_t(b[i]);
+    }
+    return sum;
+}
+
+inline int64_t
+dotProduct(const int8_t * a, const int8_t * b, size_t sz) {
+    // Blocks are small enough that the int32_t sums cannot overflow
+    constexpr size_t LOOP_COUNT = 0x10000;
+    int64_t sum(0);
+    size_t i=0;
+    for (; i + LOOP_COUNT <= sz; i += LOOP_COUNT) {
+        sum += dotProductT<int32_t>(a + i, b + i, LOOP_COUNT);
+    }
+    sum += dotProductT<int32_t>(a + i, b + i, sz - i);
+    return sum;
+}
+
+inline float
+dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) {
+    constexpr size_t UNROLL = 16;
+    float partial[UNROLL] = {};
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += a[i+j].to_float() * b[i+j].to_float();
+        }
+    }
+    for (; i < sz; i++) {
+        partial[i%UNROLL] += a[i].to_float() * b[i].to_float();
+    }
+    float sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+inline double
+squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) {
+    constexpr size_t UNROLL = 16;
+    float partial[UNROLL] = {};
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            float d = a[i+j].to_float() - b[i+j].to_float();
+            partial[j] += d * d;
+        }
+    }
+    for (; i < sz; i++) {
+        float d = a[i].to_float() - b[i].to_float();
+        partial[i%UNROLL] += d * d;
+    }
+    double sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+// Applies a pairwise kernel to vector a and each of the vectors in b,
+// prefetching the next vector while computing the current one.
+template<typename T, typename Kernel>
+void
+oneToMany(Kernel kernel, const T * a, const T * const * b, size_t count, size_t sz, double * result) {
+    for (size_t i(0); i < count; i++) {
+        if (i + 1 < count) {
+            __builtin_prefetch(b[i + 1]);
+        }
+        result[i] = kernel(a, b[i], sz);
+    }
+}
+
 }
 }
@@ -45,6 +45,14 @@ void decompress(const CompressionConfig::Type & compression, size_t uncompressed
 
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
+/**
+ * As above, but with an explicit compressor instead of the default one for the type.
+ * compress() appends the compressed data to dest and returns compression.type if
+ * the threshold is met, otherwise it returns NONE and leaves dest untouched.
+ */
+CompressionConfig::Type compress(ICompressor & compressor, const CompressionConfig & compression, const ConstBufferRef & org, DataBuffer & dest);
+void decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap);
+
 //-----------------------------------------------------------------------------
 
 /**
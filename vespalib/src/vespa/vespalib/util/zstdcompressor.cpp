@@ -3,6 +3,8 @@
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
 #include <zstd.h>
+#include <zdict.h>
+#include <cstring>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
@@ -60,4 +62,90 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     return ! ZSTD_isError(sz);
 }
 
+ZStdDictionary::ZStdDictionary(ConstBufferRef content, int compressionLevel)
+    : _content(Alloc::allocHeap(content.size())),
+      _id(ZSTD_getDictID_fromDict(content.data(), content.size())),
+      _compressionLevel(compressionLevel),
+      _cdictOnce(),
+      _cdict(nullptr),
+      _ddict(nullptr)
+{
+    memcpy(_content.get(), content.data(), content.size());
+    _ddict = ZSTD_createDDict(_content.get(), _content.size());
+    assert(_ddict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    if (_cdict != nullptr) {
+        ZSTD_freeCDict(_cdict);
+    }
+    ZSTD_freeDDict(_ddict);
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel)
+{
+    std::vector<size_t> sampleSizes;
+    size_t totalSize(0);
+    for (const auto & sample : samples) {
+        sampleSizes.push_back(sample.size());
+        totalSize += sample.size();
+    }
+    Alloc samplesBuffer = Alloc::allocHeap(totalSize);
+    char * dst = static_cast<char *>(samplesBuffer.get());
+    for (const auto & sample : samples) {
+        memcpy(dst, sample.data(), sample.size());
+        dst += sample.size();
+    }
+    Alloc dictBuffer = Alloc::allocHeap(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dictBuffer.get(), maxSize, samplesBuffer.get(), sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(dictBuffer.get(), sz), compressionLevel);
+}
+
+uint32_t
+ZStdDictionary::getDictionaryId(const void * frame, size_t frameLen)
+{
+    return ZSTD_getDictID_fromFrame(frame, frameLen);
+}
+
+size_t ZStdDictionary::adjustProcessLen(uint16_t, size_t len) const { return ZSTD_compressBound(len); }
+
+bool
+ZStdDictionary::process(const CompressionConfig&, const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
+{
+    // Files only read from never need the much larger compression dictionary.
+    std::call_once(_cdictOnce, [this]() {
+        _cdict = ZSTD_createCDict(_content.get(), _content.size(), _compressionLevel);
+        assert(_cdict != nullptr);
+    });
+    size_t maxOutputLen = ZSTD_compressBound(inputLen);
+    if ( ! _tlCompressState) {
+        _tlCompressState = std::make_unique<CompressContext>();
+    }
+    size_t sz = ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, _cdict);
+    assert( ! ZSTD_isError(sz) );
+    outputLenV = sz;
+    return ! ZSTD_isError(sz);
+}
+
+bool
+ZStdDictionary::unprocess(const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
+{
+    if ( ! _tlDecompressState) {
+        _tlDecompressState = std::make_unique<DecompressContext>();
+    }
+    size_t sz = ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen, _ddict);
+    if (ZSTD_isError(sz)) {
+        // Corrupt input, make sure it is not mistaken for uncompressed data.
+        outputLenV = 0;
+        return false;
+    }
+    outputLenV = sz;
+    return true;
+}
+
 }
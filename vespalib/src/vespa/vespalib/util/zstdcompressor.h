@@ -2,6 +2,12 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
@@ -13,5 +19,43 @@ public:
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
 };
 
+/**
+ * Zstd compression using a dictionary trained on samples of the data to compress.
+ * Small buffers have too little context to compress well on their own, the dictionary
+ * provides that context up front. The compression level is fixed when the dictionary
+ * is created. Instances can be used from multiple threads.
+ */
+class ZStdDictionary : public ICompressor
+{
+public:
+    using SP = std::shared_ptr<ZStdDictionary>;
+    ZStdDictionary(ConstBufferRef content, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator=(const ZStdDictionary &) = delete;
+    ~ZStdDictionary() override;
+    /**
+     * Trains a dictionary of at most maxSize bytes from the given samples.
+     * Returns an empty pointer if there is too little sample data to train on.
+     */
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel);
+    /**
+     * Returns the id of the dictionary needed to decompress the given zstd frame, 0 if none.
+     */
+    static uint32_t getDictionaryId(const void * frame, size_t frameLen);
+    uint32_t id() const { return _id; }
+    ConstBufferRef content() const { return ConstBufferRef(_content.get(), _content.size()); }
+
+    bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
+    bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
+    size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    alloc::Alloc   _content;
+    uint32_t       _id;
+    int            _compressionLevel;
+    std::once_flag _cdictOnce;
+    ZSTD_CDict_s * _cdict;
+    ZSTD_DDict_s * _ddict;
+};
+
 }
 